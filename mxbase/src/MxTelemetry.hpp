@@ -49,10 +49,12 @@ namespace MxTelemetry {
   namespace Type {
     MxEnumValues(Heap, HashTbl, Thread, Multiplexer, Socket, Queue,
 	Engine, Link,
-	DBEnv, DBHost, DB);
+	DBEnv, DBHost, DB,
+	MultiplexerRx);
     MxEnumNames("Heap", "HashTbl", "Thread", "Multiplexer", "Socket", "Queue",
 	"Engine", "Link",
-	"DBEnv", "DBHost", "DB");
+	"DBEnv", "DBHost", "DB",
+	"MultiplexerRx");
   }
 
   struct HdrData {
@@ -76,6 +78,8 @@ namespace MxTelemetry {
 
   using Multiplexer = ZiMxTelemetry;
 
+  using MultiplexerRx = ZiMxRxTelemetry;
+
   using Socket = ZiCxnTelemetry;
 
   namespace QueueType {
@@ -122,7 +126,8 @@ namespace MxTelemetry {
   typedef ZuLargest<
      Heap, HashTbl, Thread, Multiplexer, Socket, Queue,
      Engine, Link,
-     DBEnv, DBHost, DB>::T Largest;
+     DBEnv, DBHost, DB,
+     MultiplexerRx>::T Largest;
 
   struct Buf {
     char	data[sizeof(Hdr) + sizeof(Largest)];
@@ -212,6 +217,7 @@ namespace MxTelemetry {
   DeclFn(hashTbl, HashTbl)
   DeclFn(thread, Thread)
   DeclFn(multiplexer, Multiplexer)
+  DeclFn(multiplexerRx, MultiplexerRx)
   DeclFn(socket, Socket)
   DeclFn(engine, Engine)
   DeclFn(link, Link)
@@ -242,6 +248,7 @@ namespace MxTelemetry {
 	io.init(ZiIOFn{io.fn.mvObject<Msg>(), [](Msg *msg, ZiIOContext &io) {
 	  if (ZuUnlikely((io.offset += io.length) < io.size)) return;
 	}}, msg->ptr(), msg->length, 0, msg->addr);
+	io.last = true;
       }});
     }
 
@@ -138,6 +138,7 @@ public:
   inline bool raw() const { return m_raw; }
   inline ZiIP interface_() const { return m_interface; }
   inline unsigned reconnectFreq() const { return m_reconnectFreq; }
+  inline bool rxStamp() const { return m_rxStamp; }
 
   inline Mx *mx() { return m_mx; }
   inline Mx *mx2() { return m_mx2; }
@@ -150,6 +151,7 @@ private:
   bool		m_raw;		// true if TSE (raw) format
   ZiIP		m_interface;	// interface to capture from
   unsigned	m_reconnectFreq;// reconnect frequency
+  bool		m_rxStamp;	// kernel Rx timestamps
 
   ZmLock	m_fileLock;	// lock on capture file
     ZiFile	m_file;		// capture file
@@ -195,6 +197,7 @@ void Source::connect()
   options.udp(true);
   options.multicast(true);
   options.mreq(ZiMReq(group().ip, m_app->interface_()));
+  options.rxStamp(m_app->rxStamp());
   m_app->mx()->udp(
       ZiConnectFn::Member<&Source::connected>::fn(ZmMkRef(this)),
       ZiFailFn::Member<&Source::connectFailed>::fn(ZmMkRef(this)),
@@ -251,11 +254,12 @@ void Msg_<Heap>::recv(ZiIOContext &io)
 template <typename Heap>
 void Msg_<Heap>::rcvd(ZiIOContext &io)
 {
-  ZmTime now{ZmTime::Now};
+  // prefer the kernel (wire arrival) timestamp
+  ZmTime stamp = !io.stamp ? ZmTime{ZmTime::Now} : io.stamp;
   m_hdr.len = io.offset + io.length;
   m_hdr.group = m_cxn->group().id;
-  m_hdr.sec = now.sec();
-  m_hdr.nsec = now.nsec();
+  m_hdr.sec = stamp.sec();
+  m_hdr.nsec = stamp.nsec();
 
   m_cxn->app()->mx2()->add(ZmFn<>::Member<&Msg_::write>::fn(ZmMkRef(this)));
 
@@ -291,7 +295,8 @@ App::App(ZvCf *cf) :
   m_groups(cf->get("groups", true)),
   m_raw(cf->getInt("raw", 0, 1, false, 0)),
   m_interface(cf->get("interface", false, "0.0.0.0")),
-  m_reconnectFreq(cf->getInt("reconnect", 0, 3600, false, 0))
+  m_reconnectFreq(cf->getInt("reconnect", 0, 3600, false, 0)),
+  m_rxStamp(cf->getInt("rxStamp", 0, 1, false, 1))
 {
   m_mx = new Mx(cf->subset("mx", false));
   m_mx2 = new Mx(cf->subset("mx2", false));
@@ -339,6 +339,7 @@ void Msg_<Heap>::send_(ZiIOContext &io)
 {
   io.init(ZiIOFn::Member<&Msg_<Heap>::sent_>::fn(ZmMkRef(this)),
       m_buf, m_hdr.len, 0, m_cxn->dest());
+  io.last = true;
   m_cxn = nullptr;
 }
 template <typename Heap>
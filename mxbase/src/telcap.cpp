@@ -15,13 +15,15 @@ public:
 
   void open() {
     open_(m_heap, "heap");
-    write_(m_heap, "time,id,size,alignment,partition,sharded,cacheSize,cpuset,cacheAllocs,heapAllocs,frees,allocated\n");
+    write_(m_heap, "time,id,size,alignment,partition,sharded,cacheSize,cpuset,cacheAllocs,heapAllocs,frees,allocated,slabs,slabFill\n");
     open_(m_hashTbl, "hashTbl");
     write_(m_hashTbl, "time,id,addr,linear,bits,slots,cBits,locks,count,resized,loadFactor,effLoadFactor,nodeSize\n");
     open_(m_thread, "thread");
-    write_(m_thread,"time,name,id,tid,cpuUsage,cpuset,priority,sysPriority,stackSize,partition,main,detached\n");
+    write_(m_thread,"time,name,id,tid,cpuUsage,cpuset,priority,sysPriority,stackSize,partition,main,detached,stolen,dwellP50,dwellP99,dwellP999,dwellMax,execP50,execP99,execP999,execMax\n");
     open_(m_multiplexer, "multiplexer");
-    write_(m_multiplexer, "time,id,state,nThreads,rxThread,txThread,priority,stackSize,partition,rxBufSize,txBufSize,queueSize,ll,spin,timeout\n");
+    write_(m_multiplexer, "time,id,state,nThreads,rxThread,txThread,nRxThreads,priority,stackSize,partition,rxBufSize,txBufSize,queueSize,ll,spin,timeout\n");
+    open_(m_multiplexerRx, "multiplexerRx");
+    write_(m_multiplexerRx, "time,mxID,index,tid,nCxns,rxRequests,rxBytes\n");
     open_(m_socket, "socket");
     write_(m_socket, "time,mxID,type,remoteIP,remotePort,localIP,localPort,fd,flags,mreqAddr,mreqIf,mif,ttl,rxBufSize,rxBufLen,txBufSize,txBufLen\n");
     open_(m_queue, "queue");
@@ -72,7 +74,9 @@ private:
 	  << ',' << data.cacheAllocs
 	  << ',' << data.heapAllocs
 	  << ',' << data.frees
-	  << ',' << (data.cacheAllocs + data.heapAllocs - data.frees) << '\n');
+	  << ',' << (data.cacheAllocs + data.heapAllocs - data.frees)
+	  << ',' << data.slabs
+	  << ',' << data.slabFill << '\n');
       } break;
       case Type::HashTbl: {
 	const auto &data = msg->as<HashTbl>();
@@ -103,7 +107,12 @@ private:
 	  << ',' << data.stackSize
 	  << ',' << ZuBoxed(data.partition)
 	  << ',' << ZuBoxed(data.main)
-	  << ',' << ZuBoxed(data.detached) << '\n');
+	  << ',' << ZuBoxed(data.detached)
+	  << ',' << data.stolen
+	  << ',' << data.dwellP50 << ',' << data.dwellP99
+	  << ',' << data.dwellP999 << ',' << data.dwellMax
+	  << ',' << data.execP50 << ',' << data.execP99
+	  << ',' << data.execP999 << ',' << data.execMax << '\n');
       } break;
       case Type::Multiplexer: {
 	const auto &data = msg->as<Multiplexer>();
@@ -113,6 +122,7 @@ private:
 	  << ',' << ZuBoxed(data.nThreads)
 	  << ',' << ZuBoxed(data.rxThread)
 	  << ',' << ZuBoxed(data.txThread)
+	  << ',' << ZuBoxed(data.nRxThreads)
 	  << ',' << ZuBoxed(data.priority)
 	  << ',' << data.stackSize
 	  << ',' << ZuBoxed(data.partition)
@@ -123,6 +133,16 @@ private:
 	  << ',' << data.spin
 	  << ',' << data.timeout << '\n');
       } break;
+      case Type::MultiplexerRx: {
+	const auto &data = msg->as<MultiplexerRx>();
+	write_(m_multiplexerRx, ZuStringN<512>() << now.csv(nowFmt)
+	  << ',' << data.mxID
+	  << ',' << ZuBoxed(data.index)
+	  << ',' << ZuBoxed(data.tid)
+	  << ',' << data.nCxns
+	  << ',' << data.rxRequests
+	  << ',' << data.rxBytes << '\n');
+      } break;
       case Type::Socket: {
 	const auto &data = msg->as<Socket>();
 	write_(m_socket, ZuStringN<512>() << now.csv(nowFmt)
@@ -244,6 +264,7 @@ private:
   ZiFile	m_hashTbl;
   ZiFile	m_thread;
   ZiFile	m_multiplexer;
+  ZiFile	m_multiplexerRx;
   ZiFile	m_socket;
   ZiFile	m_queue;
   ZiFile	m_engine;
@@ -463,6 +463,7 @@ namespace MxMDStream {
 
   struct MsgData : public ZuPolymorph {
     ZiSockAddr	addr;
+    ZmTime	stamp;	// kernel Rx timestamp (if enabled)
   };
   template <typename Heap>
   struct Msg_ : public Heap, public ZuPOD_<Buf, MsgData> {
@@ -594,6 +595,7 @@ namespace MxMDStream {
 	    if (ZuUnlikely((io.offset += io.length) < io.size)) return;
 	  }}, msg->ptr<Msg>()->ptr(), msg->length, 0,
 	  msg->ptr<Msg>()->addr);
+	io.last = true;
       }});
     }
     template <typename Cxn, typename L>
@@ -607,6 +609,7 @@ namespace MxMDStream {
 	    IOLambda<Cxn, L>::invoke(io);
 	  }}, msg->ptr<Msg>()->ptr(), msg->length, 0,
 	  msg->ptr<Msg>()->addr);
+	io.last = true;
       }});
     }
     template <typename Cxn, typename L>
@@ -616,6 +619,7 @@ namespace MxMDStream {
       io.init(ZiIOFn{ZuMv(msg), [](MxQMsg *msg, ZiIOContext &io) {
 	msg->length = (io.offset += io.length);
 	msg->ptr<Msg>()->addr = io.addr;
+	msg->ptr<Msg>()->stamp = io.stamp;
 	IOLambda<Cxn, L>::invoke(io);
       }},
       msg_->ptr<Msg>()->ptr(), msg_->ptr<Msg>()->size(), 0);
@@ -630,6 +634,7 @@ namespace MxMDStream {
 	  [](MxQMsg *msg, ZiIOContext &io) {
 	    io.offset += io.length;
 	  }}, msg->ptr<Msg>()->ptr(), msg->length, 0);
+	io.last = true;
       }});
     }
     template <typename Cxn, typename L>
@@ -641,6 +646,7 @@ namespace MxMDStream {
 	    if (ZuUnlikely((io.offset += io.length) < io.size)) return;
 	    IOLambda<Cxn, L>::invoke(io);
 	  }}, msg->ptr<Msg>()->ptr(), msg->length, 0);
+	io.last = true;
       }});
     }
 
@@ -41,6 +41,7 @@ void MxMDSubscriber::init(MxMDCore *core, ZvCf *cf)
   m_reconnInterval = cf->getDbl("reconnInterval", 0, 3600, false, 10);
   m_reReqInterval = cf->getDbl("reReqInterval", 0, 3600, false, 1);
   m_reReqMaxGap = cf->getInt("reReqMaxGap", 0, 1000000, false, 10);
+  m_rxStamp = cf->getInt("rxStamp", 0, 1, false, 0);
 
   if (ZuString channels = cf->get("channels"))
     updateLinks(channels);
@@ -409,6 +410,7 @@ void MxMDSubLink::udpConnect()
   m_udpResendAddr = ZiSockAddr(resendIP, resendPort);
   ZiCxnOptions options;
   options.udp(true);
+  options.rxStamp(engine()->rxStamp());
   if (ip.multicast()) {
     options.multicast(true);
     options.mreq(ZiMReq(ip, engine()->interface_()));
@@ -64,6 +64,7 @@ public:
   ZuInline ZmTime reconnInterval() const { return ZmTime(m_reconnInterval); }
   ZuInline ZmTime reReqInterval() const { return ZmTime(m_reReqInterval); }
   ZuInline unsigned reReqMaxGap() const { return m_reReqMaxGap; }
+  ZuInline bool rxStamp() const { return m_rxStamp; }
 
   void updateLinks(ZuString channels); // update from CSV
 
@@ -104,6 +105,7 @@ private:
   double		m_reconnInterval = 0.0;
   double		m_reReqInterval = 0.0;
   unsigned		m_reReqMaxGap = 10;
+  bool			m_rxStamp = false;
 
   Channels		m_channels;
 };
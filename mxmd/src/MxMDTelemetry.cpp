@@ -67,6 +67,8 @@ void MxMDTelemetry::run(MxTelemetry::Server::Cxn *cxn)
       cxn, [](Cxn *cxn, MxMultiplex *mx) {
 	if (mx->telCount()) return;
 	cxn->transmit(multiplexer(mx));
+	for (unsigned i = 0, n = mx->nRxThreads(); i < n; i++)
+	  cxn->transmit(multiplexerRx(mx, i));
 	{
 	  uint64_t inCount, inBytes, outCount, outBytes;
 	  for (unsigned tid = 1, n = mx->params().nThreads(); tid <= n; tid++) {
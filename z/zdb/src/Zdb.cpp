@@ -1132,8 +1132,11 @@ void ZdbAnyPOD::sent(ZiIOContext &io)
     io.init(ZiIOFn::Member<&ZdbAnyPOD::sent2>::fn(
 	  io.fn.mvObject<ZdbAnyPOD>()),
 	(void *)((const char *)this->ptr() + range.off()), range.len(), 0);
-  else
+  else {
     sent3(io);
+    return;
+  }
+  io.last = true;
 }
 void ZdbAnyPOD::sent2(ZiIOContext &io)
 {
@@ -1223,6 +1226,7 @@ void Zdb_Cxn::hbSent(ZiIOContext &io)
   }
   io.init(ZiIOFn::Member<&Zdb_Cxn::hbSent2>::fn(this),
       self->dbState().data(), self->dbState().length() * sizeof(ZdbRN), 0);
+  io.last = true;
 }
 void Zdb_Cxn::hbSent2(ZiIOContext &io)
 {
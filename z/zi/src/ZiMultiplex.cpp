@@ -201,8 +201,11 @@ ZiMultiplex_WSExt::~ZiMultiplex_WSExt()
 #include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/syscall.h>
+#include <sys/uio.h>
 #include <linux/unistd.h>
 #include <linux/sockios.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
 
 #ifndef EPOLLRDHUP
 #define EPOLLRDHUP 0
@@ -220,8 +223,447 @@ ZiMultiplex_WSExt::~ZiMultiplex_WSExt()
 #endif /* !__NR_eventfd */
 #endif
 
+// SCM_TIMESTAMPING control message buffer size
+#define ZiMultiplex__RxStampSize CMSG_SPACE(sizeof(struct scm_timestamping))
+
+// enable kernel software Rx timestamps (CLOCK_REALTIME); hardware
+// timestamps are in the NIC's clock domain and are not requested
+static bool ZiMultiplex__rxStampInit(int s)
+{
+  int f = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+  return setsockopt(s, SOL_SOCKET, SO_TIMESTAMPING,
+      (const char *)&f, sizeof(int)) >= 0;
+}
+
+// kernel software Rx timestamp
+static ZmTime ZiMultiplex__rxStamp(struct msghdr *msg)
+{
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg);
+      cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPING)
+      continue;
+    struct scm_timestamping ts;
+    memcpy(&ts, CMSG_DATA(cmsg), sizeof(struct scm_timestamping));
+    return ZmTime{ts.ts[0]};
+  }
+  return ZmTime{};
+}
+
+#endif /* ZiMultiplex_EPoll */
+
+#ifdef ZiMultiplex_URing
+
+#include <poll.h>
+#include <sys/mman.h>
+
+#include <zlib/ZtArray.hpp>
+
+// minimal io_uring interface (raw system calls, no liburing dependency);
+// the SQ and CQ rings are shared with the kernel, so head/tail indices
+// are loaded and stored with acquire/release semantics
+class ZiMultiplex__URing {
+public:
+  enum { // user_data low bits (ZiConnection pointers are 8-byte aligned)
+    Recv = 0,		// multishot receive - ZiConnection *
+    PollOut,		// POLLOUT - ZiConnection *
+    EPoll,		// multishot poll of the epoll FD
+    Cancel,		// cancellation (completion ignored)
+    Mask = 7
+  };
+  enum { BufGroup = 0 };
+  enum { Null = ~0U };	// null buffer ID
+
+  ZiMultiplex__URing() { }
+  ~ZiMultiplex__URing() { final(); }
+
+  int init(unsigned size, unsigned nBufs, unsigned bufSize, ZeError &e);
+  void final();
+
+  // returns null if the SQ is full (after attempting to submit)
+  struct io_uring_sqe *sqe();
+  // submit pending SQEs, optionally waiting for at least one completion
+  int enter(bool wait);
+  // dequeue next completion
+  ZuInline bool cqe(struct io_uring_cqe &cqe) {
+    unsigned head = *m_cqHead;
+    if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) return false;
+    cqe = m_cqes[head & m_cqMask];
+    __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // provided buffers
+  ZuInline char *buf(unsigned bid) const {
+    return m_bufs + (size_t)bid * m_bufSize;
+  }
+  ZuInline void recycle(unsigned bid) {
+    struct io_uring_buf *buf = &m_bufRing[m_bufTail & m_bufMask];
+    buf->addr = (uintptr_t)this->buf(bid);
+    buf->len = m_bufSize;
+    buf->bid = bid;
+    __atomic_store_n(&m_bufRing->resv, ++m_bufTail, __ATOMIC_RELEASE);
+    m_recycled = true;
+  }
+
+  // per-buffer state for data queued on a connection
+  unsigned		*m_next = nullptr;	// next buffer ID
+  unsigned		*m_offset = nullptr;	// data offset
+  unsigned		*m_length = nullptr;	// data length
+
+  struct msghdr		m_msg;		// recvmsg() template for UDP
+
+  ZtArray<ZmRef<ZiConnection> >	m_starved;	// awaiting buffers
+  bool			m_recycled = false;
+  unsigned		m_truncated = 0;	// # truncated datagrams
+  unsigned		m_inflight = 0;	// # requests holding a reference
+
+  int			m_fd = -1;
+
+private:
+  // SQ
+  void			*m_sqMem = nullptr;
+  size_t		m_sqSize = 0;
+  unsigned		*m_sqHead = nullptr;
+  unsigned		*m_sqTail = nullptr;
+  unsigned		m_sqMask = 0;
+  unsigned		m_sqEntries = 0;
+  unsigned		m_sqLocalTail = 0;
+  unsigned		m_sqPending = 0;
+  struct io_uring_sqe	*m_sqes = nullptr;
+  size_t		m_sqesSize = 0;
+  // CQ
+  void			*m_cqMem = nullptr;
+  size_t		m_cqSize = 0;
+  unsigned		*m_cqHead = nullptr;
+  unsigned		*m_cqTail = nullptr;
+  unsigned		m_cqMask = 0;
+  struct io_uring_cqe	*m_cqes = nullptr;
+  // provided buffer ring
+  // io_uring_buf_ring is not used directly since the C++ expansion of
+  // its flexible array member misplaces bufs[]; the ring tail overlays
+  // the first entry's resv field
+  struct io_uring_buf	*m_bufRing = nullptr;
+  size_t		m_bufRingSize = 0;
+  unsigned		m_bufMask = 0;
+  uint16_t		m_bufTail = 0;
+  char			*m_bufs = nullptr;
+  size_t		m_bufsSize = 0;
+  unsigned		m_bufSize = 0;
+};
+
+int ZiMultiplex__URing::init(
+    unsigned size, unsigned nBufs, unsigned bufSize, ZeError &e)
+{
+  struct io_uring_params p;
+  memset(&p, 0, sizeof(struct io_uring_params));
+  p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+  p.cq_entries = size<<2; // multishot receives post many completions
+  if ((m_fd = syscall(__NR_io_uring_setup, size, &p)) < 0) {
+    e = errno;
+    return -1;
+  }
+  m_sqSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  m_cqSize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    if (m_cqSize > m_sqSize) m_sqSize = m_cqSize;
+    m_cqSize = 0;
+  }
+  m_sqMem = mmap(0, m_sqSize, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+  if (m_sqMem == MAP_FAILED) { m_sqMem = nullptr; goto error; }
+  if (!m_cqSize)
+    m_cqMem = m_sqMem;
+  else {
+    m_cqMem = mmap(0, m_cqSize, PROT_READ | PROT_WRITE,
+	MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+    if (m_cqMem == MAP_FAILED) { m_cqMem = nullptr; goto error; }
+  }
+  m_sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+  m_sqes = (struct io_uring_sqe *)mmap(0, m_sqesSize,
+      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+      IORING_OFF_SQES);
+  if (m_sqes == MAP_FAILED) { m_sqes = nullptr; goto error; }
+  {
+    char *sq = (char *)m_sqMem;
+    m_sqHead = (unsigned *)(sq + p.sq_off.head);
+    m_sqTail = (unsigned *)(sq + p.sq_off.tail);
+    m_sqMask = *(unsigned *)(sq + p.sq_off.ring_mask);
+    m_sqEntries = p.sq_entries;
+    m_sqLocalTail = *m_sqTail;
+    unsigned *array = (unsigned *)(sq + p.sq_off.array);
+    for (unsigned i = 0; i < p.sq_entries; i++) array[i] = i;
+    char *cq = (char *)m_cqMem;
+    m_cqHead = (unsigned *)(cq + p.cq_off.head);
+    m_cqTail = (unsigned *)(cq + p.cq_off.tail);
+    m_cqMask = *(unsigned *)(cq + p.cq_off.ring_mask);
+    m_cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+  }
+
+  // provided buffer ring - the number of entries must be a power of 2
+  {
+    unsigned n = 1;
+    while (n < nBufs && n < 32768) n <<= 1;
+    nBufs = n;
+  }
+  m_bufRingSize = nBufs * sizeof(struct io_uring_buf);
+  m_bufRing = (struct io_uring_buf *)mmap(0, m_bufRingSize,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (m_bufRing == MAP_FAILED) { m_bufRing = nullptr; goto error; }
+  m_bufMask = nBufs - 1;
+  m_bufSize = bufSize;
+  m_bufsSize = (size_t)nBufs * bufSize;
+  m_bufs = (char *)mmap(0, m_bufsSize,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (m_bufs == MAP_FAILED) { m_bufs = nullptr; goto error; }
+  {
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(struct io_uring_buf_reg));
+    reg.ring_addr = (uintptr_t)m_bufRing;
+    reg.ring_entries = nBufs;
+    reg.bgid = BufGroup;
+    if (syscall(__NR_io_uring_register,
+	  m_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) goto error;
+  }
+  m_next = new unsigned[nBufs];
+  m_offset = new unsigned[nBufs];
+  m_length = new unsigned[nBufs];
+  m_bufTail = 0;
+  for (unsigned i = 0; i < nBufs; i++) recycle(i);
+  m_recycled = false;
+
+  memset(&m_msg, 0, sizeof(struct msghdr));
+  m_msg.msg_namelen = sizeof(struct sockaddr_in);
+
+  return 0;
+
+error:
+  e = errno;
+  final();
+  return -1;
+}
+
+void ZiMultiplex__URing::final()
+{
+  if (m_fd >= 0) { ::close(m_fd); m_fd = -1; }
+  if (m_bufs) { munmap(m_bufs, m_bufsSize); m_bufs = nullptr; }
+  if (m_bufRing) { munmap(m_bufRing, m_bufRingSize); m_bufRing = nullptr; }
+  if (m_sqes) { munmap(m_sqes, m_sqesSize); m_sqes = nullptr; }
+  if (m_cqMem && m_cqMem != m_sqMem) munmap(m_cqMem, m_cqSize);
+  m_cqMem = nullptr;
+  if (m_sqMem) { munmap(m_sqMem, m_sqSize); m_sqMem = nullptr; }
+  delete [] m_next; m_next = nullptr;
+  delete [] m_offset; m_offset = nullptr;
+  delete [] m_length; m_length = nullptr;
+  m_starved.null();
+  m_inflight = 0;
+  m_sqPending = 0;
+}
+
+struct io_uring_sqe *ZiMultiplex__URing::sqe()
+{
+  if (ZuUnlikely(m_sqLocalTail -
+	__atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries)) {
+    enter(false);
+    if (m_sqLocalTail -
+	__atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries)
+      return nullptr;
+  }
+  struct io_uring_sqe *sqe = &m_sqes[m_sqLocalTail++ & m_sqMask];
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  ++m_sqPending;
+  return sqe;
+}
+
+int ZiMultiplex__URing::enter(bool wait)
+{
+  __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+  int r = syscall(__NR_io_uring_enter, m_fd, m_sqPending, wait ? 1 : 0,
+      wait ? IORING_ENTER_GETEVENTS : 0, (void *)0, 0);
+  if (ZuLikely(r >= 0)) m_sqPending -= r;
+  return r;
+}
+
+#endif /* ZiMultiplex_URing */
+
+// Rx thread state - each Rx thread has its own connections and epoll set
+// (and io_uring); the primary Rx thread (index 0) additionally owns
+// listeners and connects
+class ZiMultiplex__Rx {
+public:
+  ZuInline ZmFn<> rxFn() {
+    return ZmFn<>{this, [](ZiMultiplex__Rx *rx) { rx->m_mx->rx(rx); }};
+  }
+
+  ZiMultiplex			*m_mx = nullptr;
+  unsigned			m_index = 0;
+  unsigned			m_tid = 0;
+
+  // Rx exclusive
+  ZmRef<ZiMultiplex::CxnHash>	m_cxns;		// connections
+  uint64_t			m_rxRequests = 0;
+  uint64_t			m_rxBytes = 0;
+  bool				m_stopping = false;
+  bool				m_stopped = false;
+
+  ZmAtomic<unsigned>		m_nCxns;	// includes hand-offs in flight
+
+#ifdef ZiMultiplex_EPoll
+  int				m_epollFD = -1;
+  int				m_wakeFD = -1, m_wakeFD2 = -1;	// wake pipe
+#endif
+#ifdef ZiMultiplex_URing
+  ZiMultiplex__URing		*m_uring = nullptr;
+#endif
+};
+
+#ifdef ZiMultiplex_EPoll
+// UDP recvmmsg() / sendmmsg() batch - one message header and iovec per
+// datagram; allocated on first use by the owning Rx or Tx thread
+class ZiMultiplex__MMsg {
+public:
+  ZiMultiplex__MMsg(unsigned n) : m_n(n) {
+    m_hdrs = new struct mmsghdr[n];
+    m_iovs = new struct iovec[n];
+    memset(m_hdrs, 0, n * sizeof(struct mmsghdr));
+    for (unsigned i = 0; i < n; i++) {
+      m_hdrs[i].msg_hdr.msg_iov = &m_iovs[i];
+      m_hdrs[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+  ~ZiMultiplex__MMsg() {
+    delete [] m_hdrs;
+    delete [] m_iovs;
+  }
+
+  ZuInline void msg(unsigned i, void *ptr, unsigned len, ZiSockAddr &addr) {
+    m_iovs[i].iov_base = ptr;
+    m_iovs[i].iov_len = len;
+    m_hdrs[i].msg_hdr.msg_name = addr.sa();
+    m_hdrs[i].msg_hdr.msg_namelen = addr.len();
+  }
+
+  unsigned		m_n;
+  struct mmsghdr	*m_hdrs;
+  struct iovec		*m_iovs;
+};
+
+// the first datagram of each batch is received directly into the
+// application's buffer, the remainder are staged here and copied out
+// in turn as the application re-arms its receive context
+class ZiMultiplex__MMsgRx : public ZiMultiplex__MMsg {
+public:
+  ZiMultiplex__MMsgRx(unsigned n, bool rxStamp) : ZiMultiplex__MMsg(n) {
+    m_addrs = new ZiSockAddr[n];
+    if (rxStamp) {
+      m_ctrl = new char[n * ZiMultiplex__RxStampSize];
+      for (unsigned i = 0; i < n; i++)
+	m_hdrs[i].msg_hdr.msg_control = m_ctrl + i * ZiMultiplex__RxStampSize;
+    }
+  }
+  ~ZiMultiplex__MMsgRx() {
+    delete [] m_addrs;
+    delete [] m_ctrl;
+    ::free(m_buf);
+  }
+
+  ZuInline uint8_t *buf(unsigned i) { return m_buf + (size_t)i * m_bufSize; }
+
+  // ensure staging buffers can accommodate datagrams of size len
+  ZuInline bool ensure(unsigned len) {
+    if (ZuLikely(len <= m_bufSize)) return true;
+    uint8_t *buf = (uint8_t *)::malloc((size_t)m_n * len);
+    if (ZuUnlikely(!buf)) return false;
+    ::free(m_buf);
+    m_buf = buf;
+    m_bufSize = len;
+    return true;
+  }
+
+  ZiSockAddr		*m_addrs;
+  char			*m_ctrl = nullptr;	// SCM_TIMESTAMPING
+  uint8_t		*m_buf = nullptr;
+  unsigned		m_bufSize = 0;
+  unsigned		m_head = 0;	// staged datagrams pending delivery
+  unsigned		m_tail = 0;
+  unsigned		m_truncated = 0;	// # truncated datagrams
+};
+
+// queued sends - the first send enqueues a flush, so that all sends
+// already queued on the Tx thread are coalesced into one sendmmsg() (UDP)
+// or writev() (TCP); the queue grows as needed while the socket is blocked
+class ZiMultiplex__TxBatch : public ZiMultiplex__MMsg {
+public:
+  ZiMultiplex__TxBatch(unsigned n) : ZiMultiplex__MMsg(n) {
+    m_size = 1; while (m_size < n) m_size <<= 1;
+    m_ctxs = new ZiIOContext[m_size];
+    m_sent = new ZiIOContext[n];
+  }
+  ~ZiMultiplex__TxBatch() {
+    delete [] m_ctxs;
+    delete [] m_sent;
+  }
+
+  // i'th queued send
+  ZuInline ZiIOContext &ctx(unsigned i) {
+    return m_ctxs[(m_head + i) & (m_size - 1)];
+  }
+  // enqueue at tail
+  void push(ZiIOContext io) {
+    if (ZuUnlikely(m_count >= m_size)) grow();
+    ctx(m_count++) = ZuMv(io);
+  }
+  // re-enqueue at head (partially sent)
+  void unshift(ZiIOContext io) {
+    if (ZuUnlikely(m_count >= m_size)) grow();
+    m_head = (m_head - 1) & (m_size - 1);
+    ++m_count;
+    ctx(0) = ZuMv(io);
+  }
+  // dequeue n (<= m_n) from head into m_sent, pending completion - since
+  // completion callbacks may queue further sends
+  void shift(unsigned n) {
+    for (unsigned i = 0; i < n; i++) m_sent[i] = ZuMv(ctx(i));
+    m_head = (m_head + n) & (m_size - 1);
+    m_count -= n;
+  }
+  // discard all queued sends
+  void clear() {
+    for (unsigned i = 0; i < m_count; i++) ctx(i).complete();
+    m_head = m_count = 0;
+  }
+
+private:
+  void grow() {
+    unsigned size = m_size<<1;
+    ZiIOContext *ctxs = new ZiIOContext[size];
+    for (unsigned i = 0; i < m_count; i++) ctxs[i] = ZuMv(ctx(i));
+    delete [] m_ctxs;
+    m_ctxs = ctxs;
+    m_size = size;
+    m_head = 0;
+  }
+
+  ZiIOContext		*m_ctxs;	// queued (ring buffer)
+  unsigned		m_size;		// capacity of m_ctxs (power of 2)
+  unsigned		m_head = 0;	// index of first queued
+
+public:
+  ZiIOContext		*m_sent;	// sent, pending completion
+  unsigned		m_count = 0;	// # queued
+  bool			m_flush = false;	// flush enqueued
+  bool			m_sending = false;	// completing sent buffers
+};
 #endif /* ZiMultiplex_EPoll */
 
+#ifdef ZiMultiplex_URing
+// connections requesting Rx timestamps are served by epoll, since
+// receives into provided buffers do not return control messages
+inline bool ZiConnection::uring() const
+{
+  return m_rx->m_uring && !m_info.options.rxStamp();
+}
+#endif
+
 typedef ZuStringN<120> ErrorStr;
 
 #define Log(severity, op, result, error) \
@@ -231,12 +673,24 @@ typedef ZuStringN<120> ErrorStr;
 #define Warning(op, result, error) Log(Warning, op, result, error)
 
 ZiConnection::ZiConnection(ZiMultiplex *mx, const ZiCxnInfo &info) :
-  m_mx(mx), m_info(info), m_rxUp(1),
+  m_mx(mx), m_info(info), m_rx(mx->m_rx), m_rxThread(mx->m_rxThread),
+  m_rxUp(1),
   m_rxRequests(0), m_rxBytes(0),
 #ifdef ZiMultiplex_IOCP
   m_rxFlags(0),
+#endif
+#ifdef ZiMultiplex_URing
+  m_uringHead(ZiMultiplex__URing::Null), m_uringTail(ZiMultiplex__URing::Null),
+  m_uringQueued(0), m_uringRx(false), m_uringRxCancel(false),
+  m_uringTx(false), m_uringStarved(false), m_uringEOF(false),
+#endif
+#ifdef ZiMultiplex_EPoll
+  m_mmsgRx(nullptr),
 #endif
   m_txUp(1), m_txRequests(0), m_txBytes(0)
+#ifdef ZiMultiplex_EPoll
+  , m_txBatch(nullptr)
+#endif
 {
   m_rxContext.cxn = m_txContext.cxn = this;
 }
@@ -249,6 +703,11 @@ ZiConnection::~ZiConnection()
     ZeLOG(Warning, "~ZiConnection() called with socket still open");
     ZiPlatform::closeSocket(m_info.socket);
   }
+
+#ifdef ZiMultiplex_EPoll
+  delete m_mmsgRx;
+  delete m_txBatch;
+#endif
 }
 
 void ZiMultiplex::udp(ZiConnectFn fn, ZiFailFn failFn,
@@ -379,6 +838,14 @@ void ZiMultiplex::udp_(ZiConnectFn fn, ZiFailFn failFn,
   }
 
 #ifdef ZiMultiplex_EPoll
+  if (options.rxStamp() && !ZiMultiplex__rxStampInit(s)) {
+    ZeError e(errno);
+    ::close(s);
+    Error("setsockopt(SO_TIMESTAMPING)", Zi::IOError, e);
+    failFn(false);
+    return;
+  }
+
   if (fcntl(s, F_SETFL, O_NONBLOCK) < 0) {
     ZeError e(errno);
     ::close(s);
@@ -490,26 +957,8 @@ void ZiMultiplex::udp_(ZiConnectFn fn, ZiFailFn failFn,
 
 #endif /* !_WIN32 */
 
-  ZmRef<ZiConnection> cxn;
-
-  cxn = (ZiConnection *)fn(ZiCxnInfo {
+  executedConnect(ZuMv(fn), ZiCxnInfo {
       ZiCxnType::UDP, s, options, localIP, localPort, remoteIP, remotePort });
-
-  if (!cxn) {
-    ZiPlatform::closeSocket(s);
-    return;
-  }
-
-  if (!cxnAdd(cxn, s)) return;
-
-  cxn->connected();
-
-  ZiDEBUG(this, ZtSprintf("FD: % 3d UDP CONNECTED to %s:%u",
-	(int)s, inet_ntoa(remoteIP), (unsigned)remotePort));
-
-#ifdef ZiMultiplex_IOCP
-  cxn->recv();
-#endif
 }
 
 void ZiMultiplex::connect(
@@ -736,21 +1185,88 @@ retry:
 }
 #endif
 
+// primary Rx thread - hand off the new connection to its assigned Rx
+// thread, which then runs the connect callback and all subsequent
+// receive processing for the connection
 void ZiMultiplex::executedConnect(ZiConnectFn fn, const ZiCxnInfo &ci)
 {
-  ZmRef<ZiConnection> cxn = (ZiConnection *)fn(ci);
+  ZiMultiplex__Rx *rx = rxAssign(ci);
+
+  ++rx->m_nCxns;
+
+  if (ZuLikely(rx == m_rx)) {
+    executedConnect_(rx, ZuMv(fn), ci);
+    return;
+  }
+
+  run(rx->m_tid, [this, rx, fn = ZuMv(fn), ci]() mutable {
+    executedConnect_(rx, ZuMv(fn), ci);
+  });
+}
+
+void ZiMultiplex::executedConnect_(
+    ZiMultiplex__Rx *rx, ZiConnectFn fn, const ZiCxnInfo &ci)
+{
+  ZmRef<ZiConnection> cxn;
+
+  if (ZuLikely(!rx->m_stopping)) cxn = (ZiConnection *)fn(ci);
 
   if (!cxn) {
+    --rx->m_nCxns;
     ZiPlatform::closeSocket(ci.socket);
     return;
   }
 
+  cxn->m_rx = rx;
+  cxn->m_rxThread = rx->m_tid;
+
   if (!cxnAdd(cxn, ci.socket)) return;
 
   cxn->connected();
 
-  ZiDEBUG(this, ZtSprintf("FD: % 3d TCP CONNECTED to %s:%u",
-	(int)ci.socket, inet_ntoa(ci.remoteIP), (unsigned)ci.remotePort));
+  ZiDEBUG(this, ZtSprintf("FD: % 3d %s CONNECTED to %s:%u (Rx %u)",
+	(int)ci.socket, ZiCxnType::name(ci.type),
+	inet_ntoa(ci.remoteIP), (unsigned)ci.remotePort, rx->m_tid));
+}
+
+ZiMultiplex__Rx *ZiMultiplex::rxAssign(const ZiCxnInfo &ci)
+{
+  if (m_nRx <= 1) return m_rx;
+
+  if (!!m_rxAssign) return &m_rx[(unsigned)m_rxAssign(ci) % m_nRx];
+
+  switch (m_rxPolicy) {
+    case ZiMxRxPolicy::CPU: {
+#ifdef SO_INCOMING_CPU
+      int cpu = -1;
+      socklen_t l = sizeof(int);
+      if (!getsockopt(ci.socket, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &l) &&
+	  cpu >= 0)
+	for (unsigned i = 0; i < m_nRx; i++)
+	  if (params().thread(m_rx[i].m_tid).cpuset() && (unsigned)cpu)
+	    return &m_rx[i];
+#endif
+    } break;
+    case ZiMxRxPolicy::LeastLoaded: {
+      unsigned j = 0, n = m_rx[0].m_nCxns;
+      for (unsigned i = 1; i < m_nRx; i++)
+	if (m_rx[i].m_nCxns < n) n = m_rx[j = i].m_nCxns;
+      return &m_rx[j];
+    }
+  }
+
+  // hash (also the fallback for CPU) - the high bits of a multiplicative
+  // hash are well distributed, the low bits are not (ephemeral ports
+  // are typically even)
+  uint32_t hash = ZuHash<uint64_t>::hash(
+      (((uint64_t)ci.remoteIP.s_addr)<<32) |
+      (((uint64_t)ci.remotePort)<<16) | (uint64_t)ci.localPort);
+  return &m_rx[((uint64_t)hash * m_nRx)>>32];
+}
+
+unsigned ZiMultiplex::rxThread(unsigned i) const
+{
+  return m_rx[i].m_tid;
 }
 
 void ZiConnection::telemetry(ZiCxnTelemetry &data) const
@@ -797,12 +1313,15 @@ void ZiConnection::telemetry(ZiCxnTelemetry &data) const
 
 void ZiMultiplex::allCxns(ZmFn<ZiConnection *> fn)
 {
-  rxInvoke([this, fn = ZuMv(fn)]() mutable { this->allCxns_(ZuMv(fn)); });
+  for (unsigned i = 0; i < m_nRx; i++) {
+    ZiMultiplex__Rx *rx = &m_rx[i];
+    invoke(rx->m_tid, [this, rx, fn]() { this->allCxns_(rx, fn); });
+  }
 }
 
-void ZiMultiplex::allCxns_(ZmFn<ZiConnection *> fn)
+void ZiMultiplex::allCxns_(ZiMultiplex__Rx *rx, ZmFn<ZiConnection *> fn)
 {
-  auto i = m_cxns->readIterator();
+  auto i = rx->m_cxns->readIterator();
   while (ZmRef<ZiConnection> cxn = i.iterateKey())
     txRun([fn, cxn = ZuMv(cxn)]() { fn(cxn); });
 }
@@ -1129,6 +1648,9 @@ void ZiConnection::connected()
 #endif
 
 #ifdef ZiMultiplex_EPoll
+#ifdef ZiMultiplex_URing
+  if (uring()) { uringRecv(); return; }
+#endif
   if (ZuUnlikely(m_rxContext.completed()))
     m_mx->epollRecv(this, m_info.socket, 0);
 #endif
@@ -1136,7 +1658,7 @@ void ZiConnection::connected()
 
 void ZiConnection::recv(ZiIOFn fn)
 {
-  m_mx->rxInvoke([cxn = ZmMkRef(this), fn = ZuMv(fn)]() mutable {
+  m_mx->invoke(m_rxThread, [cxn = ZmMkRef(this), fn = ZuMv(fn)]() mutable {
       cxn->recv_(ZuMv(fn)); });
 }
 
@@ -1149,9 +1671,23 @@ void ZiConnection::recv_(ZiIOFn fn)
 #endif
 
 #ifdef ZiMultiplex_EPoll
-  if (ZuLikely(!m_rxContext.completed()))
-    if (!m_mx->epollRecv(this, m_info.socket, EPOLLIN | EPOLLRDHUP))
+#ifdef ZiMultiplex_URing
+  if (uring()) {
+    if (ZuLikely(!m_rxContext.completed()))
+      uringRecv();
+    else
+      uringFlow();
+    return;
+  }
+#endif
+  if (ZuLikely(!m_rxContext.completed())) {
+    if (!m_mx->epollRecv(this, m_info.socket, EPOLLIN | EPOLLRDHUP)) {
       m_rxContext.complete();
+      return;
+    }
+    // datagrams staged by a previous recvmmsg() will not re-trigger epoll
+    if (m_mmsgRx && m_mmsgRx->m_head < m_mmsgRx->m_tail) recv();
+  }
 #endif
 }
 
@@ -1162,7 +1698,7 @@ bool ZiMultiplex::epollRecv(ZiConnection *cxn, int s, uint32_t events)
   memset(&ev, 0, sizeof(struct epoll_event));
   ev.events = events | EPOLLOUT | EPOLLET;
   ev.data.u64 = (uintptr_t)cxn;
-  if (epoll_ctl(m_epollFD, EPOLL_CTL_MOD, s, &ev) < 0) {
+  if (epoll_ctl(cxn->m_rx->m_epollFD, EPOLL_CTL_MOD, s, &ev) < 0) {
     Error("epoll_ctl(EPOLL_CTL_MOD)", Zi::IOError, ZeLastError);
     return false;
   }
@@ -1261,6 +1797,8 @@ void ZiConnection::recv()
     return true;
   }
 
+  if (m_info.options.udp() && m_mx->udpBatch() > 1) return recvMMsg();
+
   unsigned len = m_rxContext.size - m_rxContext.offset;
   void *buf = (char *)m_rxContext.ptr + m_rxContext.offset;
 
@@ -1279,7 +1817,25 @@ void ZiConnection::recv()
 #endif
 
 retry:
-  if (m_info.options.udp()) {
+  if (m_info.options.rxStamp()) {
+    struct iovec iov{buf, len};
+    union {
+      struct cmsghdr	hdr;
+      char		data[ZiMultiplex__RxStampSize];
+    } ctrl;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(struct msghdr));
+    if (m_info.options.udp()) {
+      msg.msg_name = m_rxContext.addr.sa();
+      msg.msg_namelen = m_rxContext.addr.len();
+    }
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.data;
+    msg.msg_controllen = sizeof(ctrl.data);
+    n = ::recvmsg(m_info.socket, &msg, 0);
+    if (n > 0) m_rxContext.stamp = ZiMultiplex__rxStamp(&msg);
+  } else if (m_info.options.udp()) {
     socklen_t addrLen = m_rxContext.addr.len();
     n = ::recvfrom(m_info.socket, (char *)buf, len, 0,
 	m_rxContext.addr.sa(), &addrLen);
@@ -1339,6 +1895,231 @@ retry:
 #endif
 }
 
+#ifdef ZiMultiplex_EPoll
+// datagram larger than the receive buffer
+static void ZiMultiplex__mmsgTruncated(
+    ZiMultiplex__MMsgRx *mmsg, ZiPlatform::Socket s, unsigned n)
+{
+  unsigned truncated = ++mmsg->m_truncated;
+  if (!(truncated & (truncated - 1))) // log 1st, 2nd, 4th, ...
+    ZeLOG(Warning, ZtSprintf(
+	  "FD: %d recvmmsg() datagram truncated to %u bytes (%u truncated)",
+	  (int)s, n, truncated));
+}
+
+// UDP - receive up to udpBatch() datagrams per recvmmsg(), delivering
+// each in turn; returns false if disconnected
+bool ZiConnection::recvMMsg()
+{
+  ZiMultiplex__MMsgRx *mmsg = m_mmsgRx;
+  if (ZuUnlikely(!mmsg))
+    mmsg = m_mmsgRx = new ZiMultiplex__MMsgRx(
+	m_mx->udpBatch(), m_info.options.rxStamp());
+
+  bool drained = false;
+
+  for (;;) {
+    if (ZuUnlikely(m_rxContext.completed())) {
+      if (m_rxContext.disconnected()) {
+	disconnect();
+	return false;
+      }
+      m_mx->epollRecv(this, m_info.socket, 0);
+      return true;
+    }
+
+    if (ZuUnlikely(m_rxContext.offset >= m_rxContext.size)) {
+      m_rxContext.complete();
+      m_mx->epollRecv(this, m_info.socket, 0);
+      return true;
+    }
+
+    unsigned len = m_rxContext.size - m_rxContext.offset;
+    char *buf = (char *)m_rxContext.ptr + m_rxContext.offset;
+
+    // deliver datagrams staged by the previous recvmmsg()
+    if (mmsg->m_head < mmsg->m_tail) {
+      unsigned i = mmsg->m_head++;
+      unsigned n = mmsg->m_hdrs[i].msg_len;
+      if (ZuUnlikely(!n)) continue;
+      // staged with the space available when received, which may exceed
+      // what remains now
+      if (ZuUnlikely(n > len)) {
+	n = len;
+	ZiMultiplex__mmsgTruncated(mmsg, m_info.socket, n);
+      } else if (ZuUnlikely(mmsg->m_hdrs[i].msg_hdr.msg_flags & MSG_TRUNC))
+	ZiMultiplex__mmsgTruncated(mmsg, m_info.socket, n);
+      memcpy(buf, mmsg->buf(i), n);
+      m_rxContext.addr = mmsg->m_addrs[i];
+      if (mmsg->m_ctrl)
+	m_rxContext.stamp = ZiMultiplex__rxStamp(&mmsg->m_hdrs[i].msg_hdr);
+      executedRecv(n);
+      continue;
+    }
+
+    // a short batch implies the socket was drained (edge-triggered
+    // epoll notifies any subsequent arrival)
+    if (drained) return true;
+
+    unsigned batch = mmsg->m_n;
+    if (ZuUnlikely(!mmsg->ensure(len))) batch = 1;
+    mmsg->msg(0, buf, len, m_rxContext.addr);
+    for (unsigned i = 1; i < batch; i++)
+      mmsg->msg(i, mmsg->buf(i), len, mmsg->m_addrs[i]);
+    if (mmsg->m_ctrl)
+      for (unsigned i = 0; i < batch; i++)
+	mmsg->m_hdrs[i].msg_hdr.msg_controllen = ZiMultiplex__RxStampSize;
+
+    int r;
+    ZeError e;
+
+retry:
+    r = ::recvmmsg(m_info.socket, mmsg->m_hdrs, batch, 0, nullptr);
+    if (ZuUnlikely(r < 0)) e = errno;
+
+    ZiDEBUG(m_mx, ZtSprintf(
+	  "FD: % 3d recvmmsg(%u, %u): %d errno: %d (EAGAIN=%d EINTR=%d)",
+	  (int)m_info.socket, len, batch, r,
+	  (int)e.errNo(), (int)EAGAIN, (int)EINTR));
+
+    if (ZuUnlikely(r < 0)) {
+      if (e.errNo() == EAGAIN) {
+#ifdef ZiMultiplex_DEBUG
+	if (m_mx->yield()) ZmPlatform::yield();
+#endif
+	return true;
+      }
+      if (e.errNo() == EINTR) goto retry;
+      errorRecv(Zi::IOError, e);
+      m_rxContext.completed();
+      return false;
+    }
+
+    drained = (unsigned)r < batch;
+    mmsg->m_head = 1;
+    mmsg->m_tail = r;
+
+    if (unsigned n = mmsg->m_hdrs[0].msg_len) {
+      if (ZuUnlikely(mmsg->m_hdrs[0].msg_hdr.msg_flags & MSG_TRUNC))
+	ZiMultiplex__mmsgTruncated(mmsg, m_info.socket, n);
+      if (mmsg->m_ctrl)
+	m_rxContext.stamp = ZiMultiplex__rxStamp(&mmsg->m_hdrs[0].msg_hdr);
+      executedRecv(n);
+    }
+  }
+}
+#endif
+
+#ifdef ZiMultiplex_URing
+// deliver data queued in provided buffers, then (re-)arm the multishot
+// receive if needed; returns false if disconnected
+bool ZiConnection::uringRecv()
+{
+#ifdef ZiMultiplex_DEBUG
+  if (m_mx->trace()) m_mx->traceCapture();
+#endif
+
+  if (ZuUnlikely(!m_rxUp)) {
+    uringDrop();
+    m_rxContext.complete();
+    return false;
+  }
+
+  ZiMultiplex__URing *uring = m_rx->m_uring;
+  bool udp = m_info.options.udp();
+
+  while (m_uringHead != ZiMultiplex__URing::Null) {
+    if (ZuUnlikely(m_rxContext.completed())) break;
+
+    unsigned bid = m_uringHead;
+    const char *buf = uring->buf(bid);
+    const char *data = buf + uring->m_offset[bid];
+    unsigned n = uring->m_length[bid];
+    unsigned len = m_rxContext.size - m_rxContext.offset;
+
+#ifdef ZiMultiplex_DEBUG
+    if (m_mx->frag()) {
+      unsigned l = ((m_rxContext.offset + 8)>>1) + 1;
+      if (len > l) len = l;
+    }
+#endif
+
+    // datagrams are truncated, stream data is left queued
+    bool consumed = udp || n <= len;
+    if (n > len) n = len;
+    memcpy((char *)m_rxContext.ptr + m_rxContext.offset, data, n);
+    if (udp) {
+      const struct io_uring_recvmsg_out *out =
+	(const struct io_uring_recvmsg_out *)buf;
+      unsigned addrLen = out->namelen;
+      if (addrLen > (unsigned)m_rxContext.addr.len())
+	addrLen = m_rxContext.addr.len();
+      memcpy(m_rxContext.addr.sa(), buf + sizeof(*out), addrLen);
+    }
+    if (consumed) {
+      if ((m_uringHead = uring->m_next[bid]) == ZiMultiplex__URing::Null)
+	m_uringTail = ZiMultiplex__URing::Null;
+      --m_uringQueued;
+      uring->recycle(bid);
+    } else {
+      uring->m_offset[bid] += n;
+      uring->m_length[bid] -= n;
+    }
+
+    ZiDEBUG(m_mx, ZtHexDump(ZtSprintf(
+	    "FD: % 3d io_uring recv(%u): %u",
+	    (int)m_info.socket, len, n), data, n));
+
+    executedRecv(n);
+
+    if (ZuUnlikely(m_rxContext.completed())) {
+      if (m_rxContext.disconnected()) {
+	disconnect();
+	return false;
+      }
+      break;
+    }
+
+    if (ZuUnlikely(m_rxContext.offset >= m_rxContext.size)) {
+      m_rxContext.complete();
+      break;
+    }
+  }
+
+  if (ZuUnlikely(m_uringEOF && m_uringHead == ZiMultiplex__URing::Null)) {
+    m_rxContext.complete();
+    disconnect();
+    return false;
+  }
+
+  uringFlow();
+  return true;
+}
+
+// pause the multishot receive while the app is not receiving or the
+// backlog is at its limit, resuming it once the backlog has drained
+void ZiConnection::uringFlow()
+{
+  if (m_rxContext.completed() || m_uringQueued >= m_mx->uringCxnBufs()) {
+    if (m_uringRx) m_mx->uringRecvCancel(this);
+  } else if (!m_uringRx && !m_uringStarved)
+    m_mx->uringRecv(this);
+}
+
+// release queued buffers back to the kernel
+void ZiConnection::uringDrop()
+{
+  ZiMultiplex__URing *uring = m_rx->m_uring;
+  unsigned bid;
+  while ((bid = m_uringHead) != ZiMultiplex__URing::Null) {
+    m_uringHead = uring->m_next[bid];
+    uring->recycle(bid);
+  }
+  m_uringTail = ZiMultiplex__URing::Null;
+  m_uringQueued = 0;
+}
+#endif
+
 #ifdef ZiMultiplex_IOCP
 void ZiConnection::overlappedRecv(int status, unsigned n, ZeError e)
 {
@@ -1394,6 +2175,7 @@ void ZiConnection::executedRecv(unsigned n)
 #endif
 
   m_rxRequests++, m_rxBytes += n;
+  m_rx->m_rxRequests++, m_rx->m_rxBytes += n;
   m_rxContext.length = n;
   while (m_rxContext());
 }
@@ -1406,6 +2188,13 @@ void ZiConnection::send(ZiIOFn fn)
 
 void ZiConnection::send_(ZiIOFn fn)
 {
+#ifdef ZiMultiplex_EPoll
+  if (m_info.options.udp() ? m_mx->udpBatch() > 1 :
+      (!m_info.options.netlink() && m_mx->tcpBatch() > 1)) {
+    sendBatch_(ZuMv(fn));
+    return;
+  }
+#endif
   m_txContext.init_(ZuMv(fn));
   send();
 }
@@ -1418,6 +2207,10 @@ void ZiConnection::send()
 
   if (ZuUnlikely(!m_txUp)) { m_txContext.complete(); return; }
 
+#ifdef ZiMultiplex_EPoll
+  if (m_txBatch) { sendBatch(); return; }
+#endif
+
   if (ZuLikely(m_txContext.completed())) return;
 
 #ifdef ZiMultiplex_IOCP
@@ -1486,9 +2279,7 @@ retry:
 
   if (ZuUnlikely(n < 0)) {
     if (e.errNo() == EAGAIN) {
-#ifdef ZiMultiplex_DEBUG
-      if (m_mx->yield()) ZmPlatform::yield();
-#endif
+      sendBlocked();
       return;
     }
     if (e.errNo() == EINTR) goto retry;
@@ -1554,6 +2345,212 @@ void ZiConnection::executedSend(unsigned n)
   while (m_txContext());
 }
 
+#ifdef ZiMultiplex_EPoll
+// send would block - resume via send() when writable
+void ZiConnection::sendBlocked()
+{
+#ifdef ZiMultiplex_URing
+  // the Rx thread owns the ring
+  if (uring())
+    m_mx->run(m_rxThread, ZmFn<>::mvFn(ZmMkRef(this),
+	  [](ZmRef<ZiConnection> cxn) {
+	    cxn->m_mx->uringPollOut(cxn); }));
+#endif
+#ifdef ZiMultiplex_DEBUG
+  if (m_mx->yield()) ZmPlatform::yield();
+#endif
+}
+
+// send, queuing behind any backlog to be coalesced with other sends
+void ZiConnection::sendBatch_(ZiIOFn fn)
+{
+  if (ZuUnlikely(!m_txUp)) return;
+
+  ZiIOContext io;
+  io.cxn = this;
+  io.init_(ZuMv(fn));
+  if (ZuUnlikely(io.completed())) {
+    if (io.disconnected()) disconnect();
+    return;
+  }
+  if (ZuUnlikely(!io.initialized())) { io.complete(); return; }
+
+  ZiMultiplex__TxBatch *batch = m_txBatch;
+  if (ZuUnlikely(!batch))
+    batch = m_txBatch = new ZiMultiplex__TxBatch(
+	m_info.options.udp() ? m_mx->udpBatch() : m_mx->tcpBatch());
+
+  batch->push(ZuMv(io));
+
+  // send immediately if there is no backlog to coalesce with, or if the
+  // batch is full; otherwise flush once queued sends have been gathered
+  if (batch->m_count == 1 || batch->m_count >= batch->m_n) {
+    if (!batch->m_sending) sendBatch();
+    return;
+  }
+  if (!batch->m_flush) {
+    batch->m_flush = true;
+    m_mx->txRun(ZmFn<>::mvFn(ZmMkRef(this), [](ZmRef<ZiConnection> cxn) {
+      cxn->m_txBatch->m_flush = false;
+      cxn->sendBatch();
+    }));
+  }
+}
+
+void ZiConnection::sendBatch()
+{
+#ifdef ZiMultiplex_DEBUG
+  if (m_mx->trace()) m_mx->traceCapture();
+#endif
+
+  if (m_info.options.udp())
+    sendMMsg();
+  else
+    sendV();
+}
+
+// UDP - send queued datagrams with sendmmsg(), then complete each in turn;
+// as for sendV(), a datagram is only followed by those of subsequent sends
+// if it is the last of its send, since otherwise its completion may
+// continue the send with a further datagram, which is requeued to be
+// sent next
+void ZiConnection::sendMMsg()
+{
+  ZiMultiplex__TxBatch *batch = m_txBatch;
+
+  while (unsigned count = batch->m_count) {
+    if (ZuUnlikely(!m_txUp)) { batch->clear(); return; }
+
+    if (count > batch->m_n) count = batch->m_n;
+    unsigned n = 0;
+    do {
+      ZiIOContext &io = batch->ctx(n);
+      batch->msg(n, (char *)io.ptr + io.offset, io.size - io.offset, io.addr);
+    } while (batch->ctx(n++).last && n < count);
+    count = n;
+
+    int r;
+    ZeError e;
+
+retry:
+    r = ::sendmmsg(m_info.socket, batch->m_hdrs, count, 0);
+    if (ZuUnlikely(r < 0)) e = errno;
+
+    ZiDEBUG(m_mx, ZtSprintf(
+	  "FD: % 3d sendmmsg(%u): %d errno: %d (EAGAIN=%d EINTR=%d)",
+	  (int)m_info.socket, count, r,
+	  (int)e.errNo(), (int)EAGAIN, (int)EINTR));
+
+    if (ZuUnlikely(r < 0)) {
+      if (e.errNo() == EAGAIN) {
+	sendBlocked();
+	return;
+      }
+      if (e.errNo() == EINTR) goto retry;
+      batch->clear();
+      errorSend(Zi::IOError, e);
+      return;
+    }
+
+    unsigned sent = r;
+    batch->shift(sent);
+    batch->m_sending = true;
+    for (unsigned i = 0; i < sent; i++) {
+      ZiIOContext &io = batch->m_sent[i];
+      io.length = batch->m_hdrs[i].msg_len;
+      m_txRequests++, m_txBytes += io.length;
+      while (io());
+      if (ZuUnlikely(io.completed())) {
+	if (io.disconnected()) disconnect();
+	continue;
+      }
+      // continued with a further datagram - requeued below
+      if (ZuLikely(io.offset >= io.size)) io.complete();
+    }
+    // requeue continued sends ahead of those not yet sent, in order
+    for (unsigned i = sent; i-- > 0; ) {
+      ZiIOContext &io = batch->m_sent[i];
+      if (ZuUnlikely(!io.completed())) batch->unshift(ZuMv(io));
+    }
+    batch->m_sending = false;
+  }
+}
+
+// TCP - send queued buffers with writev(), then complete each in turn;
+// a buffer is only followed by those of subsequent sends if it is the
+// last of its send (see ZiIOContext::last), since otherwise its
+// completion may continue the send with a further buffer
+void ZiConnection::sendV()
+{
+  ZiMultiplex__TxBatch *batch = m_txBatch;
+
+  while (unsigned count = batch->m_count) {
+    if (ZuUnlikely(!m_txUp)) { batch->clear(); return; }
+
+    if (count > batch->m_n) count = batch->m_n;
+    unsigned n = 0;
+    do {
+      ZiIOContext &io = batch->ctx(n);
+      batch->m_iovs[n].iov_base = (char *)io.ptr + io.offset;
+      batch->m_iovs[n].iov_len = io.size - io.offset;
+    } while (batch->ctx(n++).last && n < count);
+
+    ssize_t r;
+    ZeError e;
+
+retry:
+    r = ::writev(m_info.socket, batch->m_iovs, n);
+    if (ZuUnlikely(r < 0)) e = errno;
+
+    ZiDEBUG(m_mx, ZtSprintf(
+	  "FD: % 3d writev(%u): %d errno: %d (EAGAIN=%d EINTR=%d)",
+	  (int)m_info.socket, n, (int)r,
+	  (int)e.errNo(), (int)EAGAIN, (int)EINTR));
+
+    if (ZuUnlikely(r < 0)) {
+      if (e.errNo() == EAGAIN) {
+	sendBlocked();
+	return;
+      }
+      if (e.errNo() == EINTR) goto retry;
+      batch->clear();
+      errorSend(Zi::IOError, e);
+      return;
+    }
+
+    // apportion the bytes written to the buffers in order
+    unsigned sent = 0;
+    for (size_t left = r; sent < n && left; sent++) {
+      size_t len = batch->m_iovs[sent].iov_len;
+      if (len > left) batch->m_iovs[sent].iov_len = len = left;
+      left -= len;
+    }
+    if (ZuUnlikely(!sent)) return;
+
+    batch->shift(sent);
+    batch->m_sending = true;
+    for (unsigned i = 0; i < sent; i++) {
+      ZiIOContext &io = batch->m_sent[i];
+      io.length = batch->m_iovs[i].iov_len;
+      m_txRequests++, m_txBytes += io.length;
+      while (io());
+      if (ZuUnlikely(io.completed())) {
+	if (io.disconnected()) disconnect();
+	continue;
+      }
+      if (ZuUnlikely(io.offset < io.size)) {
+	// partially sent, or continued with a further buffer
+	ZmAssert(i == sent - 1);
+	batch->unshift(ZuMv(io));
+	continue;
+      }
+      io.complete();
+    }
+    batch->m_sending = false;
+  }
+}
+#endif
+
 bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
 {
 #ifndef _WIN32
@@ -1591,6 +2588,12 @@ bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
       Error("setsockopt(TCP_NODELAY)", Zi::IOError, ZeLastSockError);
       return false;
     }
+#ifdef ZiMultiplex_EPoll
+    if (options.rxStamp() && !ZiMultiplex__rxStampInit(s)) {
+      Error("setsockopt(SO_TIMESTAMPING)", Zi::IOError, ZeLastSockError);
+      return false;
+    }
+#endif
   }
 
 #ifdef ZiMultiplex_EPoll
@@ -1651,7 +2654,13 @@ bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
 
 bool ZiMultiplex::cxnAdd(ZiConnection *cxn, Socket s)
 {
-  m_cxns->add(cxn);
+  ZiMultiplex__Rx *rx = cxn->m_rx;
+
+  rx->m_cxns->add(cxn);
+
+#ifdef ZiMultiplex_URing
+  if (cxn->uring()) return true; // see ZiConnection::connected()
+#endif
 
 #ifdef ZiMultiplex_EPoll
   {
@@ -1659,9 +2668,10 @@ bool ZiMultiplex::cxnAdd(ZiConnection *cxn, Socket s)
     memset(&ev, 0, sizeof(struct epoll_event));
     ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
     ev.data.u64 = (uintptr_t)cxn;
-    if (epoll_ctl(m_epollFD, EPOLL_CTL_ADD, s, &ev) < 0) {
+    if (epoll_ctl(rx->m_epollFD, EPOLL_CTL_ADD, s, &ev) < 0) {
       ZeError e(errno);
-      delete m_cxns->del(s);
+      delete rx->m_cxns->del(s);
+      --rx->m_nCxns;
       ZiPlatform::closeSocket(s);
       Error("epoll_ctl(EPOLL_CTL_ADD)", Zi::IOError, e);
       return false;
@@ -1672,13 +2682,21 @@ bool ZiMultiplex::cxnAdd(ZiConnection *cxn, Socket s)
   return true;
 }
 
-void ZiMultiplex::cxnDel(Socket s)
+void ZiMultiplex::cxnDel(ZiConnection *cxn, Socket s)
 {
+  ZiMultiplex__Rx *rx = cxn->m_rx;
+
 #ifdef ZiMultiplex_EPoll
-  epoll_ctl(m_epollFD, EPOLL_CTL_DEL, s, 0);
+#ifdef ZiMultiplex_URing
+  if (!cxn->uring())
+#endif
+  epoll_ctl(rx->m_epollFD, EPOLL_CTL_DEL, s, 0);
 #endif
 
-  delete m_cxns->del(s);
+  if (auto node = rx->m_cxns->del(s)) {
+    delete node;
+    --rx->m_nCxns;
+  }
 }
 
 bool ZiMultiplex::listenerAdd(Listener *listener, Socket s)
@@ -1691,7 +2709,7 @@ bool ZiMultiplex::listenerAdd(Listener *listener, Socket s)
     memset(&ev, 0, sizeof(struct epoll_event));
     ev.events = EPOLLIN | EPOLLET;
     ev.data.u64 = ((uintptr_t)listener) | 1;
-    if (epoll_ctl(m_epollFD, EPOLL_CTL_ADD, s, &ev) < 0) {
+    if (epoll_ctl(m_rx->m_epollFD, EPOLL_CTL_ADD, s, &ev) < 0) {
       ZeError e(errno);
       m_listeners->del(s);
       Error("epoll_ctl(EPOLL_CTL_ADD)", Zi::IOError, e);
@@ -1706,7 +2724,7 @@ bool ZiMultiplex::listenerAdd(Listener *listener, Socket s)
 void ZiMultiplex::listenerDel(Socket s)
 {
 #ifdef ZiMultiplex_EPoll
-  epoll_ctl(m_epollFD, EPOLL_CTL_DEL, s, 0);
+  epoll_ctl(m_rx->m_epollFD, EPOLL_CTL_DEL, s, 0);
 #endif
 
   if (ZmRef<Listener> listener = m_listeners->del(s))
@@ -1723,7 +2741,7 @@ bool ZiMultiplex::connectAdd(Connect *request, Socket s)
     memset(&ev, 0, sizeof(struct epoll_event));
     ev.events = EPOLLOUT;
     ev.data.u64 = ((uintptr_t)request) | 2;
-    if (epoll_ctl(m_epollFD, EPOLL_CTL_ADD, s, &ev) < 0) {
+    if (epoll_ctl(m_rx->m_epollFD, EPOLL_CTL_ADD, s, &ev) < 0) {
       ZeError e(errno);
       m_connects->del(s);
       Error("epoll_ctl(EPOLL_CTL_ADD)", Zi::IOError, e);
@@ -1738,7 +2756,7 @@ bool ZiMultiplex::connectAdd(Connect *request, Socket s)
 void ZiMultiplex::connectDel(Socket s)
 {
 #ifdef ZiMultiplex_EPoll
-  epoll_ctl(m_epollFD, EPOLL_CTL_DEL, s, 0);
+  epoll_ctl(m_rx->m_epollFD, EPOLL_CTL_DEL, s, 0);
 #endif
 
 #if ZiMultiplex__ConnectHash
@@ -1755,10 +2773,19 @@ void ZiConnection::disconnect()
 void ZiConnection::disconnect_1()
 {
   if (!m_txUp) return;
-  
+
+#ifdef ZiMultiplex_EPoll
+  // flush sends queued prior to disconnecting, discarding any that
+  // remain queued (e.g. since the socket would block)
+  if (m_txBatch) {
+    if (m_txBatch->m_count && !m_txBatch->m_sending) sendBatch();
+    m_txBatch->clear();
+  }
+#endif
+
   m_txUp = false;
 
-  m_mx->rxRun(ZmFn<>::mvFn(ZmMkRef(this),
+  m_mx->run(m_rxThread, ZmFn<>::mvFn(ZmMkRef(this),
 	[](ZmRef<ZiConnection> cxn) { cxn->disconnect_2(); }));
 }
 
@@ -1849,9 +2876,14 @@ void ZiMultiplex::disconnected(ZiConnection *cxn)
 
   ZiDEBUG(this, ZtSprintf("FD: % 3d disconnected()", (int)s));
 
-  cxnDel(s);
+#ifdef ZiMultiplex_URing
+  if (cxn->uring()) uringCancel(cxn);
+#endif
+
+  cxnDel(cxn, s);
   
-  if (ZuUnlikely(m_stopping && !m_cxns->count_())) stop_2();
+  ZiMultiplex__Rx *rx = cxn->m_rx;
+  if (ZuUnlikely(rx->m_stopping && !rx->m_cxns->count_())) rxStopped(rx);
 }
 
 void ZiConnection::close()
@@ -1864,9 +2896,13 @@ void ZiConnection::close_1()
 {
   if (!m_txUp) return;
   
+#ifdef ZiMultiplex_EPoll
+  if (m_txBatch) m_txBatch->clear();
+#endif
+
   m_txUp = false;
 
-  m_mx->rxRun(ZmFn<>::mvFn(ZmMkRef(this),
+  m_mx->run(m_rxThread, ZmFn<>::mvFn(ZmMkRef(this),
 	[](ZmRef<ZiConnection> cxn) { cxn->close_2(); })); 
 }
 
@@ -1886,14 +2922,24 @@ ZiMultiplex::ZiMultiplex(ZiMxParams mxParams) :
   m_stopping(0), m_drain(false),
   m_rxThread(mxParams.rxThread()),
   m_nAccepts(0),
+  m_rx(nullptr), m_nRx(1),
+  m_rxPolicy(mxParams.rxPolicy()),
+  m_rxAssign(mxParams.rxAssign()),
   m_txThread(mxParams.txThread()),
   m_rxBufSize(mxParams.rxBufSize()),
   m_txBufSize(mxParams.txBufSize())
 #ifdef ZiMultiplex_EPoll
-  , m_epollFD(-1),
-  m_epollMaxFDs(mxParams.epollMaxFDs()),
+  , m_epollMaxFDs(mxParams.epollMaxFDs()),
   m_epollQuantum(mxParams.epollQuantum()),
-  m_wakeFD(-1), m_wakeFD2(-1)
+  m_udpBatch(mxParams.udpBatch()),
+  m_tcpBatch(mxParams.tcpBatch())
+#endif
+#ifdef ZiMultiplex_URing
+  , m_uringOn(mxParams.uring()),
+  m_uringSize(mxParams.uringSize()),
+  m_uringBufs(mxParams.uringBufs()),
+  m_uringBufSize(mxParams.uringBufSize()),
+  m_uringCxnBufs(mxParams.uringCxnBufs() ? mxParams.uringCxnBufs() : 1)
 #endif
 #ifdef ZiMultiplex_DEBUG
   , m_trace(mxParams.trace()),
@@ -1911,16 +2957,93 @@ ZiMultiplex::ZiMultiplex(ZiMxParams mxParams) :
     new ConnectHash(ZmHashParams().bits(5).loadFactor(1).cBits(4).
 	init(mxParams.requestHash()));
 #endif
-  m_cxns = new CxnHash(ZmHashParams().bits(8).loadFactor(1).cBits(4).
-      init(mxParams.cxnHash()));
-  if (!params().thread(m_rxThread).name())
-    params_().thread(m_rxThread).name("ioRx");
+#ifndef ZiMultiplex_IOCP
+  // IOCP has a single completion port, hence a single Rx thread
+  m_nRx += mxParams.rxThreads().length();
+#endif
+  m_rx = new ZiMultiplex__Rx[m_nRx];
+  for (unsigned i = 0; i < m_nRx; i++) {
+    ZiMultiplex__Rx *rx = &m_rx[i];
+    rx->m_mx = this;
+    rx->m_index = i;
+    rx->m_tid = !i ? m_rxThread : mxParams.rxThreads()[i - 1];
+    rx->m_cxns = new CxnHash(ZmHashParams().bits(8).loadFactor(1).cBits(4).
+	init(mxParams.cxnHash()));
+    if (!params().thread(rx->m_tid).name()) {
+      if (!i)
+	params_().thread(rx->m_tid).name("ioRx");
+      else
+	params_().thread(rx->m_tid).name(ZmThreadName() << "ioRx" << i);
+    }
+  }
   if (!params().thread(m_txThread).name())
     params_().thread(m_txThread).name("ioTx");
 }
 
 ZiMultiplex::~ZiMultiplex()
 {
+#ifdef ZiMultiplex_URing
+  for (unsigned i = 0; i < m_nRx; i++) uringFinal(&m_rx[i]);
+#endif
+  delete [] m_rx;
+}
+
+// create the Rx thread's epoll set, wake pipe and io_uring
+bool ZiMultiplex::rxInit(ZiMultiplex__Rx *rx)
+{
+#ifdef ZiMultiplex_EPoll
+  if ((rx->m_epollFD = epoll_create(m_epollMaxFDs)) < 0) {
+    Error("epoll_create", Zi::IOError, ZeLastError);
+    return false;
+  }
+  if (pipe(&rx->m_wakeFD) < 0) {
+    ZeError e(errno);
+    rxFinal(rx);
+    Error("pipe", Zi::IOError, e);
+    return false;
+  }
+  if (fcntl(rx->m_wakeFD, F_SETFL, O_NONBLOCK) < 0) {
+    ZeError e(errno);
+    rxFinal(rx);
+    Error("fcntl(F_SETFL, O_NONBLOCK)", Zi::IOError, e);
+    return false;
+  }
+  {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(struct epoll_event));
+    ev.events = EPOLLIN;
+    ev.data.u64 = 3;
+    if (epoll_ctl(rx->m_epollFD, EPOLL_CTL_ADD, rx->m_wakeFD, &ev) < 0) {
+      ZeError e(errno);
+      rxFinal(rx);
+      Error("epoll_ctl(EPOLL_CTL_ADD)", Zi::IOError, e);
+      return false;
+    }
+  }
+#endif
+
+#ifdef ZiMultiplex_URing
+  if (m_uringOn && !uringInit(rx)) {
+    rxFinal(rx);
+    return false;
+  }
+#endif
+
+  rx->m_stopping = rx->m_stopped = false;
+  return true;
+}
+
+void ZiMultiplex::rxFinal(ZiMultiplex__Rx *rx)
+{
+#ifdef ZiMultiplex_URing
+  uringFinal(rx);
+#endif
+
+#ifdef ZiMultiplex_EPoll
+  if (rx->m_wakeFD >= 0) { ::close(rx->m_wakeFD); rx->m_wakeFD = -1; }
+  if (rx->m_wakeFD2 >= 0) { ::close(rx->m_wakeFD2); rx->m_wakeFD2 = -1; }
+  if (rx->m_epollFD >= 0) { ::close(rx->m_epollFD); rx->m_epollFD = -1; }
+#endif
 }
 
 int ZiMultiplex::start()
@@ -1969,45 +3092,22 @@ int ZiMultiplex::start()
     sigaddset(&s, SIGURG);
     pthread_sigmask(SIG_BLOCK, &s, 0);
   }
-  if ((m_epollFD = epoll_create(m_epollMaxFDs)) < 0) {
-    Error("epoll_create", Zi::IOError, ZeLastError);
-    return Zi::IOError;
-  }
-  if (pipe(&m_wakeFD) < 0) {
-    ZeError e(errno);
-    ::close(m_epollFD); m_epollFD = -1;
-    Error("pipe", Zi::IOError, e);
-    return Zi::IOError;
-  }
-  if (fcntl(m_wakeFD, F_SETFL, O_NONBLOCK) < 0) {
-    ZeError e(errno);
-    ::close(m_epollFD); m_epollFD = -1;
-    ::close(m_wakeFD); m_wakeFD = -1;
-    ::close(m_wakeFD2); m_wakeFD2 = -1;
-    Error("fcntl(F_SETFL, O_NONBLOCK)", Zi::IOError, e);
-    return Zi::IOError;
-  }
-  {
-    struct epoll_event ev;
-    memset(&ev, 0, sizeof(struct epoll_event));
-    ev.events = EPOLLIN;
-    ev.data.u64 = 3;
-    if (epoll_ctl(m_epollFD, EPOLL_CTL_ADD, m_wakeFD, &ev) < 0) {
-      ZeError e(errno);
-      ::close(m_epollFD); m_epollFD = -1;
-      ::close(m_wakeFD); m_wakeFD = -1;
-      ::close(m_wakeFD2); m_wakeFD2 = -1;
-      Error("epoll_ctl(EPOLL_CTL_ADD)", Zi::IOError, e);
+#endif
+
+  for (unsigned i = 0; i < m_nRx; i++)
+    if (!rxInit(&m_rx[i])) {
+      while (i) rxFinal(&m_rx[--i]);
       return Zi::IOError;
     }
-  }
-#endif
 
-  wakeFn(rxThread(), ZmFn<>{this, [](ZiMultiplex *mx) {
-	mx->run_(mx->rxThread(), ZmFn<>::Member<&ZiMultiplex::rx>::fn(mx));
-	mx->wake();
-      }});
-  run_(rxThread(), ZmFn<>::Member<&ZiMultiplex::rx>::fn(this));
+  for (unsigned i = 0; i < m_nRx; i++) {
+    ZiMultiplex__Rx *rx = &m_rx[i];
+    wakeFn(rx->m_tid, ZmFn<>{rx, [](ZiMultiplex__Rx *rx) {
+	  rx->m_mx->run_(rx->m_tid, rx->rxFn());
+	  rx->m_mx->wake(rx);
+	}});
+    run_(rx->m_tid, rx->rxFn());
+  }
   ZmScheduler::start();
   return Zi::OK;
 }
@@ -2049,13 +3149,43 @@ void ZiMultiplex::stop(bool drain)
 
 void ZiMultiplex::stop_1()
 {
-  if (!m_cxns->count_()) { stop_2(); return; }
+  m_rxStopping = m_nRx;
+
+  for (unsigned i = 1; i < m_nRx; i++) {
+    ZiMultiplex__Rx *rx = &m_rx[i];
+    run(rx->m_tid, ZmFn<>{rx, [](ZiMultiplex__Rx *rx) {
+	  rx->m_mx->rxStop(rx);
+	}});
+  }
 
-  CxnHash::ReadIterator i(*m_cxns);
+  rxStop(m_rx);
+}
+
+void ZiMultiplex::rxStop(ZiMultiplex__Rx *rx)
+{
+  rx->m_stopping = true;	// no new connections
+
+  if (!rx->m_cxns->count_()) { rxStopped(rx); return; }
+
+  CxnHash::ReadIterator i(*rx->m_cxns);
   while (ZmRef<ZiConnection> cxn = i.iterateKey())
     cxn->disconnect();
 }
 
+void ZiMultiplex::rxStopped(ZiMultiplex__Rx *rx)
+{
+  if (rx->m_stopped) return;
+
+  rx->m_stopped = true;
+
+  // drain any I/O completions
+#ifdef ZiMultiplex_URing
+  if (rx->m_uring) uringDrain(rx);
+#endif
+
+  if (!--m_rxStopping) rxInvoke(this, [](ZiMultiplex *mx) { mx->stop_2(); });
+}
+
 void ZiMultiplex::stop_2()
 {
 #ifdef ZiMultiplex_EPoll
@@ -2105,7 +3235,7 @@ void ZiMultiplex::stop_3()
 
   // close down underlying I/O platform
 
-  wakeFn(rxThread(), ZmFn<>());
+  for (unsigned i = 0; i < m_nRx; i++) wakeFn(m_rx[i].m_tid, ZmFn<>());
 
 #ifdef ZiMultiplex_IOCP
   CloseHandle(m_completionPort);
@@ -2114,14 +3244,10 @@ void ZiMultiplex::stop_3()
   WSACleanup();	// this is reference counted
 #endif
 
-#ifdef ZiMultiplex_EPoll
-  if (m_wakeFD >= 0) { ::close(m_wakeFD); m_wakeFD = -1; }
-  if (m_wakeFD2 >= 0) { ::close(m_wakeFD2); m_wakeFD2 = -1; }
-  if (m_epollFD >= 0) { ::close(m_epollFD); m_epollFD = -1; }
-#endif
+  for (unsigned i = 0; i < m_nRx; i++) rxFinal(&m_rx[i]);
 }
 
-void ZiMultiplex::rx()
+void ZiMultiplex::rx(ZiMultiplex__Rx *rx)
 {
 #ifdef ZiMultiplex_IOCP
   DWORD len;
@@ -2132,7 +3258,7 @@ void ZiMultiplex::rx()
   for (;;) {
     ZiDEBUG(this, ZtSprintf(
 	  "wait() nThreads: % 2d nConnections: % 4d nListeners: % 3d",
-	  nThreads(), m_cxns->count(), m_listeners->count()));
+	  nThreads(), rx->m_cxns->count_(), m_listeners->count()));
     if (!GetQueuedCompletionStatus(
 	  m_completionPort, &len, &key, (OVERLAPPED **)&overlapped, INFINITE)) {
       e = GetLastError();
@@ -2155,6 +3281,28 @@ void ZiMultiplex::rx()
 #endif
 
 #ifdef ZiMultiplex_EPoll
+#ifdef ZiMultiplex_URing
+  if (rx->m_uring) { uringRx(rx); return; }
+#endif
+
+  for (;;) {
+    ZiDEBUG(this, ZtSprintf(
+	  "wait() nThreads: % 2d Rx: %u nConnections: % 4d epollFD: % 3d "
+	  "wakeFD: % 3d wakeFD2: % 3d nListeners: % 3d",
+	  params().nThreads(), rx->m_index, rx->m_cxns->count_(),
+	  rx->m_epollFD, rx->m_wakeFD, rx->m_wakeFD2,
+	  m_listeners->count_()));
+
+    if (epollWait(rx, -1)) return;
+  }
+#endif
+}
+
+#ifdef ZiMultiplex_EPoll
+// wait for and process epoll events; a zero timeout polls until no more
+// events are ready; returns non-zero if woken (or on error)
+int ZiMultiplex::epollWait(ZiMultiplex__Rx *rx, int timeout)
+{
   bool wake = false;
 
   int r;
@@ -2162,21 +3310,14 @@ void ZiMultiplex::rx()
   struct epoll_event *ev =
     (struct epoll_event *)alloca(m_epollQuantum * sizeof(struct epoll_event));
 
-  for (;;) {
-    ZiDEBUG(this, ZtSprintf(
-	  "wait() nThreads: % 2d nConnections: % 4d epollFD: % 3d "
-	  "wakeFD: % 3d wakeFD2: % 3d nListeners: % 3d",
-	  params().nThreads(), m_cxns->count_(),
-	  m_epollFD, m_wakeFD, m_wakeFD2,
-	  m_listeners->count_()));
-
+  do {
 #if 0
 #ifdef ZiMultiplex_DEBUG
     ZmTime now(ZmTime::Now);
 #endif
 #endif
 
-    r = epoll_wait(m_epollFD, ev, m_epollQuantum, -1);
+    r = epoll_wait(rx->m_epollFD, ev, m_epollQuantum, timeout);
 
 #if 0
 #ifdef ZiMultiplex_DEBUG
@@ -2191,7 +3332,7 @@ void ZiMultiplex::rx()
       e = errno;
       if (e.errNo() == EINTR || e.errNo() == EAGAIN) continue;
       Error("epoll_wait", Zi::IOError, e);
-      return;
+      return -1;
     }
 
     if (ZuLikely(r)) {
@@ -2209,7 +3350,7 @@ void ZiMultiplex::rx()
 	  continue;
 	}
 
-	if (ZuLikely(v == 3)) { wake = readWake(); continue; }
+	if (ZuLikely(v == 3)) { wake = readWake(rx); continue; }
 
 	if (ZuLikely((v & 3) == 1)) {
 	  Listener *listener = (Listener *)(v & ~(uintptr_t)3);
@@ -2253,13 +3394,279 @@ void ZiMultiplex::rx()
 	}
       }
     }
-    
+  } while (!timeout && (unsigned)r == m_epollQuantum);
+
+  return wake;
+}
+#endif
+
+#ifdef ZiMultiplex_URing
+bool ZiMultiplex::uringInit(ZiMultiplex__Rx *rx)
+{
+  rx->m_uring = new ZiMultiplex__URing();
+  ZeError e;
+  if (rx->m_uring->init(m_uringSize, m_uringBufs, m_uringBufSize, e) < 0) {
+    delete rx->m_uring;
+    rx->m_uring = nullptr;
+    Error("io_uring_setup", Zi::IOError, e);
+    return false;
+  }
+  uringEPoll(rx);
+  return true;
+}
+
+void ZiMultiplex::uringFinal(ZiMultiplex__Rx *rx)
+{
+  if (!rx->m_uring) return;
+  delete rx->m_uring;
+  rx->m_uring = nullptr;
+}
+
+// epoll remains responsible for listeners, connects and wake-ups - the
+// epoll FD itself is polled via the ring
+void ZiMultiplex::uringEPoll(ZiMultiplex__Rx *rx)
+{
+  struct io_uring_sqe *sqe = rx->m_uring->sqe();
+  if (ZuUnlikely(!sqe)) {
+    Error("io_uring_get_sqe", Zi::IOError, ZeError(EBUSY));
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = rx->m_epollFD;
+  sqe->poll32_events = POLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = ZiMultiplex__URing::EPoll;
+}
+
+// arm multishot receive into provided buffers
+void ZiMultiplex::uringRecv(ZiConnection *cxn)
+{
+  ZiMultiplex__URing *uring = cxn->m_rx->m_uring;
+  struct io_uring_sqe *sqe = uring->sqe();
+  if (ZuUnlikely(!sqe)) {
+    Error("io_uring_get_sqe", Zi::IOError, ZeError(EBUSY));
+    return;
+  }
+  if (cxn->info().options.udp()) {
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->addr = (uintptr_t)&uring->m_msg;
+    sqe->len = 1;
+  } else
+    sqe->opcode = IORING_OP_RECV;
+  sqe->fd = cxn->info().socket;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = ZiMultiplex__URing::BufGroup;
+  sqe->user_data = (uintptr_t)cxn | ZiMultiplex__URing::Recv;
+  cxn->ref(); // released by final completion
+  cxn->m_uringRx = true;
+  ++uring->m_inflight;
+}
+
+// cancel multishot receive (flow control); buffers already received
+// remain queued, and the final completion re-arms if appropriate
+void ZiMultiplex::uringRecvCancel(ZiConnection *cxn)
+{
+  if (cxn->m_uringRxCancel) return;
+  struct io_uring_sqe *sqe = cxn->m_rx->m_uring->sqe();
+  if (ZuUnlikely(!sqe)) {
+    Error("io_uring_get_sqe", Zi::IOError, ZeError(EBUSY));
+    return;
+  }
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->addr = (uintptr_t)cxn | ZiMultiplex__URing::Recv;
+  sqe->user_data = ZiMultiplex__URing::Cancel;
+  cxn->m_uringRxCancel = true;
+}
+
+// arm POLLOUT, resuming ZiConnection::send() on the Tx thread
+void ZiMultiplex::uringPollOut(ZiConnection *cxn)
+{
+  if (cxn->m_uringTx || !cxn->m_txUp) return;
+  ZiMultiplex__URing *uring = cxn->m_rx->m_uring;
+  struct io_uring_sqe *sqe = uring->sqe();
+  if (ZuUnlikely(!sqe)) {
+    Error("io_uring_get_sqe", Zi::IOError, ZeError(EBUSY));
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = cxn->info().socket;
+  sqe->poll32_events = POLLOUT;
+  sqe->user_data = (uintptr_t)cxn | ZiMultiplex__URing::PollOut;
+  cxn->ref(); // released by completion
+  cxn->m_uringTx = true;
+  ++uring->m_inflight;
+}
+
+void ZiMultiplex::uringCancel(ZiConnection *cxn)
+{
+  cxn->uringDrop();
+  for (unsigned i = 0; i < 2; i++) {
+    if (!(i ? cxn->m_uringTx : cxn->m_uringRx)) continue;
+    struct io_uring_sqe *sqe = cxn->m_rx->m_uring->sqe();
+    if (ZuUnlikely(!sqe)) {
+      Error("io_uring_get_sqe", Zi::IOError, ZeError(EBUSY));
+      return;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = (uintptr_t)cxn |
+      (i ? ZiMultiplex__URing::PollOut : ZiMultiplex__URing::Recv);
+    sqe->user_data = ZiMultiplex__URing::Cancel;
+  }
+}
+
+void ZiMultiplex::uringRx(ZiMultiplex__Rx *rx)
+{
+  ZiMultiplex__URing *uring = rx->m_uring;
+
+  // catch up with any epoll events not yet notified via the ring
+  if (epollWait(rx, 0)) return;
+
+  bool wake = false;
+  struct io_uring_cqe cqe;
+
+  for (;;) {
+    ZiDEBUG(this, ZtSprintf(
+	  "wait() nThreads: % 2d nConnections: % 4d uringFD: % 3d "
+	  "inflight: % 4d nListeners: % 3d",
+	  params().nThreads(), rx->m_cxns->count_(),
+	  uring->m_fd, uring->m_inflight,
+	  m_listeners->count_()));
+
+    if (ZuUnlikely(uring->enter(true) < 0)) {
+      ZeError e(errno);
+      if (e.errNo() != EINTR && e.errNo() != EAGAIN && e.errNo() != EBUSY) {
+	Error("io_uring_enter", Zi::IOError, e);
+	return;
+      }
+    }
+
+    while (uring->cqe(cqe))
+      if (uringCompleted(rx, cqe, wake)) wake = true;
+
+    // re-arm receives that ran out of buffers once buffers are returned
+    if (ZuUnlikely(uring->m_recycled)) {
+      uring->m_recycled = false;
+      if (unsigned n = uring->m_starved.length()) {
+	ZtArray<ZmRef<ZiConnection> > starved = ZuMv(uring->m_starved);
+	uring->m_starved.null(); // moved-from array shadows starved
+	for (unsigned i = 0; i < n; i++) {
+	  ZiConnection *cxn = starved[i];
+	  cxn->m_uringStarved = false;
+	  if (cxn->m_rxUp) cxn->uringRecv();
+	}
+      }
+    }
+
     if (wake) return;
   }
-#endif
 }
 
+// returns true if woken; once woken, epoll is not consulted again until
+// the next call to rx(), so that each wake-up is consumed exactly once
+bool ZiMultiplex::uringCompleted(
+    ZiMultiplex__Rx *rx, const struct io_uring_cqe &cqe, bool woken)
+{
+  ZiMultiplex__URing *uring = rx->m_uring;
+  uintptr_t v = cqe.user_data;
+  bool more = cqe.flags & IORING_CQE_F_MORE;
+
+  switch ((int)(v & ZiMultiplex__URing::Mask)) {
+    case ZiMultiplex__URing::Recv: {
+      ZiConnection *cxn =
+	(ZiConnection *)(v & ~(uintptr_t)ZiMultiplex__URing::Mask);
+      int n = cqe.res;
+      ZeError e;
+      if (ZuLikely(cqe.flags & IORING_CQE_F_BUFFER)) {
+	unsigned bid = cqe.flags>>IORING_CQE_BUFFER_SHIFT;
+	unsigned offset = 0;
+	if (cxn->info().options.udp()) {
+	  const struct io_uring_recvmsg_out *out =
+	    (const struct io_uring_recvmsg_out *)uring->buf(bid);
+	  offset = sizeof(*out) + uring->m_msg.msg_namelen;
+	  if ((unsigned)n < offset) n = offset;
+	  if ((unsigned)n - offset > out->payloadlen)
+	    n = offset + out->payloadlen;
+	  // datagram larger than a provided buffer (see uringBufSize())
+	  if (ZuUnlikely(out->flags & MSG_TRUNC)) {
+	    unsigned truncated = ++uring->m_truncated;
+	    if (!(truncated & (truncated - 1))) // log 1st, 2nd, 4th, ...
+	      ZeLOG(Warning, ZtSprintf(
+		    "FD: %d io_uring recvmsg() datagram truncated "
+		    "to %u bytes (%u truncated)",
+		    (int)cxn->info().socket, n - offset, truncated));
+	  }
+	}
+	uring->m_next[bid] = ZiMultiplex__URing::Null;
+	uring->m_offset[bid] = offset;
+	uring->m_length[bid] = n - offset;
+	if (cxn->m_uringTail == ZiMultiplex__URing::Null)
+	  cxn->m_uringHead = bid;
+	else
+	  uring->m_next[cxn->m_uringTail] = bid;
+	cxn->m_uringTail = bid;
+	++cxn->m_uringQueued;
+      } else if (!n) {
+	if (!cxn->info().options.udp()) cxn->m_uringEOF = true;
+      } else if (n == -ENOBUFS) {
+	if (cxn->m_rxUp) {
+	  cxn->m_uringStarved = true;
+	  uring->m_starved.push(cxn);
+	}
+      } else if (n < 0 && n != -ECANCELED)
+	e = -n;
+      if (!more) cxn->m_uringRx = cxn->m_uringRxCancel = false;
+      ZmRef<ZiConnection> cxn_ = cxn;
+      if (!more) { cxn->deref(); --uring->m_inflight; }
+      if (ZuUnlikely(e != ZeOK)) {
+	cxn->uringDrop();
+	if (cxn->m_rxUp) cxn->errorRecv(Zi::IOError, e);
+      } else if (n >= 0 || n == -ECANCELED || !cxn->m_rxUp)
+	cxn->uringRecv();
+    } break;
+    case ZiMultiplex__URing::PollOut: {
+      ZmRef<ZiConnection> cxn =
+	(ZiConnection *)(v & ~(uintptr_t)ZiMultiplex__URing::Mask);
+      cxn->deref();
+      --uring->m_inflight;
+      cxn->m_uringTx = false;
+      if (cqe.res >= 0 && cxn->m_txUp)
+	txRun(ZmFn<>::mvFn(ZuMv(cxn),
+	      [](ZmRef<ZiConnection> cxn) { cxn->send(); }));
+    } break;
+    case ZiMultiplex__URing::EPoll:
+      if (!more) uringEPoll(rx);
+      return woken || epollWait(rx, 0) != 0;
+  }
+  return false;
+}
+
+// reap completions of cancelled requests prior to stopping
+void ZiMultiplex::uringDrain(ZiMultiplex__Rx *rx)
+{
+  ZiMultiplex__URing *uring = rx->m_uring;
+  struct io_uring_cqe cqe;
+  while (uring->m_inflight) {
+    if (uring->enter(true) < 0) {
+      ZeError e(errno);
+      if (e.errNo() != EINTR && e.errNo() != EAGAIN && e.errNo() != EBUSY) {
+	Error("io_uring_enter", Zi::IOError, e);
+	return;
+      }
+    }
+    while (uring->cqe(cqe))
+      if ((cqe.user_data & ZiMultiplex__URing::Mask) != ZiMultiplex__URing::EPoll)
+	uringCompleted(rx, cqe, true);
+  }
+}
+#endif
+
 void ZiMultiplex::wake()
+{
+  for (unsigned i = 0; i < m_nRx; i++) wake(&m_rx[i]);
+}
+
+void ZiMultiplex::wake(ZiMultiplex__Rx *rx)
 {
   ZiDEBUG(this, "wake");
 
@@ -2268,25 +3675,25 @@ void ZiMultiplex::wake()
 #endif
 
 #ifdef ZiMultiplex_EPoll
-  writeWake();
+  writeWake(rx);
 #endif
 }
 
 #ifdef ZiMultiplex_EPoll
-bool ZiMultiplex::readWake()
+bool ZiMultiplex::readWake(ZiMultiplex__Rx *rx)
 {
-  ZiDEBUG(this, ZtSprintf("FD: % 3d readWake", m_wakeFD));
+  ZiDEBUG(this, ZtSprintf("FD: % 3d readWake", rx->m_wakeFD));
 
   char c;
-  return ::read(m_wakeFD, &c, 1) >= 1;
+  return ::read(rx->m_wakeFD, &c, 1) >= 1;
 }
 
-void ZiMultiplex::writeWake()
+void ZiMultiplex::writeWake(ZiMultiplex__Rx *rx)
 {
-  ZiDEBUG(this, ZtSprintf("FD: % 3d writeWake", m_wakeFD2));
+  ZiDEBUG(this, ZtSprintf("FD: % 3d writeWake", rx->m_wakeFD2));
 
   char c = 0;
-  while (::write(m_wakeFD2, &c, 1) < 0) {
+  while (::write(rx->m_wakeFD2, &c, 1) < 0) {
     ZeError e(errno);
     if (e.errNo() != EINTR && e.errNo() != EAGAIN) {
       Error("write", Zi::IOError, e);
@@ -2312,4 +3719,16 @@ void ZiMultiplex::telemetry(ZiMxTelemetry &data) const
   data.ll = params().ll();
   data.priority = params().priority();
   data.nThreads = params().nThreads();
+  data.nRxThreads = m_nRx;
+}
+
+void ZiMultiplex::telemetry(ZiMxRxTelemetry &data, unsigned i) const
+{
+  const ZiMultiplex__Rx *rx = &m_rx[i];
+  data.mxID = params().id();
+  data.rxRequests = rx->m_rxRequests;
+  data.rxBytes = rx->m_rxBytes;
+  data.nCxns = rx->m_nCxns;
+  data.tid = rx->m_tid;
+  data.index = i;
 }
@@ -48,7 +48,9 @@
 #include <zlib/ZmFn.hpp>
 #include <zlib/ZmLock.hpp>
 #include <zlib/ZmPolymorph.hpp>
+#include <zlib/ZmTime.hpp>
 
+#include <zlib/ZtArray.hpp>
 #include <zlib/ZtEnum.hpp>
 
 #include <zlib/ZePlatform.hpp>
@@ -68,6 +70,12 @@
 
 #ifdef linux
 #define ZiMultiplex_EPoll	// Linux epoll
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef IORING_RECV_MULTISHOT	// Linux 6.0+ headers
+#define ZiMultiplex_URing	// Linux io_uring (run-time option, see ZiMxParams)
+#endif
+#endif
 #endif
 
 #ifdef NETLINK
@@ -92,6 +100,14 @@
 
 class ZiConnection;
 class ZiMultiplex;
+#ifdef ZiMultiplex_URing
+class ZiMultiplex__URing;
+#endif
+class ZiMultiplex__Rx;
+#ifdef ZiMultiplex_EPoll
+class ZiMultiplex__MMsgRx;
+class ZiMultiplex__TxBatch;
+#endif
 
 class ZiCxnOptions;
 struct ZiCxnInfo;
@@ -106,14 +122,16 @@ struct ZiCxnInfo;
 #endif
 
 struct ZiIOContext {
-  ZuInline ZiIOContext() : ptr(0), size(0), offset(0), length(0) { }
+  ZuInline ZiIOContext() :
+    ptr(0), size(0), offset(0), length(0), last(false) { }
 
 friend class ZiConnection;
 private:
   // initialize (called from within send/recv)
   template <typename Fn>
   ZuInline void init_(Fn &&fn_) {
-    fn = ZuFwd<Fn>(fn_); ptr = 0; size = offset = length = 0; (*this)();
+    fn = ZuFwd<Fn>(fn_); ptr = 0; size = offset = length = 0; last = false;
+    (*this)();
   }
 public:
   // send/receive
@@ -122,6 +140,7 @@ public:
       void *ptr_, unsigned size_, unsigned offset_) {
     ZmAssert(size_);
     fn = ZuFwd<Fn>(fn_); ptr = ptr_; size = size_; offset = offset_; length = 0;
+    last = false;
   }
   // UDP send
   template <typename Fn, typename Addr>
@@ -129,6 +148,7 @@ public:
       void *ptr_, unsigned size_, unsigned offset_, Addr &&addr_) {
     ZmAssert(size_);
     fn = ZuFwd<Fn>(fn_); ptr = ptr_; size = size_; offset = offset_; length = 0;
+    last = false;
     addr = ZuFwd<Addr>(addr_);
   }
   // initially, ptr will be null and app must set it via init()
@@ -155,7 +175,10 @@ public:
   unsigned	size;	// size of buffer - set by app
   unsigned	offset;	// offset within buffer - set by app
   unsigned	length;	// length - set by ZiMultiplex
+  bool		last;	// last buffer of send - set by app
+			// (permits coalescing with subsequent sends)
   ZiSockAddr	addr;	// address - set by app (send) / ZiMultiplex (recv)
+  ZmTime	stamp;	// kernel Rx timestamp - set by ZiMultiplex (recv)
   ZiConnection	*cxn;	// connection - set by ZiMultiplex
 };
 typedef ZmFn<ZiIOContext &> ZiIOFn;
@@ -238,13 +261,15 @@ namespace ZiCxnFlags {
     LoopBack,		// L - combine with M and U for multicast loopback
     KeepAlive,		// K - set SO_KEEPALIVE socket option
     NetLink,		// N - NetLink socket
-    Nagle		// D - enable Nagle algorithm (no TCP_NODELAY)
+    Nagle,		// D - enable Nagle algorithm (no TCP_NODELAY)
+    RxStamp		// T - kernel receive timestamps (SO_TIMESTAMPING)
   );
   ZtEnumNames(
-    "UDP", "Multicast", "LoopBack", "KeepAlive", "NetLink", "Nagle");
+    "UDP", "Multicast", "LoopBack", "KeepAlive", "NetLink", "Nagle",
+    "RxStamp");
   ZtEnumFlags(Flags,
       "U", UDP, "M", Multicast, "L", LoopBack, "L", KeepAlive, "N", NetLink,
-      "D", Nagle);
+      "D", Nagle, "T", RxStamp);
 }
 class ZiCxnOptions {
   typedef ZuArrayN<ZiMReq, ZiCxnOptions_NMReq> MReqs;
@@ -381,6 +406,17 @@ public:
     b ? (m_flags |= (1<<Nagle)) : (m_flags &= ~(1<<Nagle));
     return *this;
   }
+  // ZiIOContext::stamp is set for each receive (Linux only; kernel
+  // software timestamps, i.e. CLOCK_REALTIME, comparable with ZmTimeNow())
+  ZuInline bool rxStamp() const {
+    using namespace ZiCxnFlags;
+    return m_flags & (1<<RxStamp);
+  }
+  ZuInline ZiCxnOptions &rxStamp(bool b) {
+    using namespace ZiCxnFlags;
+    b ? (m_flags |= (1<<RxStamp)) : (m_flags &= ~(1<<RxStamp));
+    return *this;
+  }
 
   ZuInline bool equals(const ZiCxnOptions &o) const {
     using namespace ZiCxnFlags;
@@ -599,6 +635,9 @@ public:
   ZuInline ZiMultiplex *mx() const { return m_mx; }
   ZuInline const ZiCxnInfo &info() const { return m_info; }
 
+  // Rx thread to which this connection is pinned (valid from connected())
+  ZuInline unsigned rxThread() const { return m_rxThread; }
+
   void telemetry(ZiCxnTelemetry &data) const;
 
 private:
@@ -606,9 +645,16 @@ private:
 
 #ifdef ZiMultiplex_EPoll
   bool recv();
+  bool recvMMsg();
 #else
   void recv();
 #endif
+#ifdef ZiMultiplex_URing
+  bool uring() const;
+  bool uringRecv();
+  void uringFlow();
+  void uringDrop();
+#endif
 #ifdef ZiMultiplex_IOCP
   void overlappedRecv(int status, unsigned n, ZeError e);
 #endif
@@ -616,6 +662,13 @@ private:
   void executedRecv(unsigned n);
 
   void send();
+#ifdef ZiMultiplex_EPoll
+  void sendBatch_(ZiIOFn fn);
+  void sendBatch();
+  void sendMMsg();
+  void sendV();
+  void sendBlocked();
+#endif
   void errorSend(int status, ZeError e);
   void executedSend(unsigned n);
 
@@ -631,6 +684,8 @@ private:
 
   ZiMultiplex			*m_mx;
   ZiCxnInfo			m_info;
+  ZiMultiplex__Rx		*m_rx;
+  unsigned			m_rxThread;
 
 #ifdef ZiMultiplex_IOCP
   Zi_Overlapped		 	 m_discOverlapped;
@@ -645,14 +700,43 @@ private:
   Zi_Overlapped			m_rxOverlapped;
   DWORD				m_rxFlags;		// flags for WSARecv()
 #endif
+#ifdef ZiMultiplex_URing
+  unsigned			m_uringHead;	// received buffers (FIFO)
+  unsigned			m_uringTail;
+  unsigned			m_uringQueued;	// # received buffers
+  bool				m_uringRx;	// multishot receive armed
+  bool				m_uringRxCancel;// multishot receive cancelled
+  bool				m_uringTx;	// POLLOUT armed
+  bool				m_uringStarved;	// out of buffers
+  bool				m_uringEOF;
+#endif
+#ifdef ZiMultiplex_EPoll
+  ZiMultiplex__MMsgRx		*m_mmsgRx;	// UDP recvmmsg() batch
+#endif
 
   // Tx thread exclusive
   unsigned			m_txUp;
   uint64_t			m_txRequests;
   uint64_t			m_txBytes;
   ZiIOContext			m_txContext;
+#ifdef ZiMultiplex_EPoll
+  ZiMultiplex__TxBatch		*m_txBatch;	// sendmmsg() / writev() batch
+#endif
 };
 
+// assignment of connections to Rx threads
+namespace ZiMxRxPolicy {
+  ZtEnumValues(
+    Hash,		// hash of IP addresses and ports (default)
+    CPU,		// Rx thread bound to the receiving CPU (SO_INCOMING_CPU)
+    LeastLoaded		// Rx thread with fewest connections
+  );
+  ZtEnumNames("Hash", "CPU", "LeastLoaded");
+}
+
+// overrides ZiMxRxPolicy - returns index of Rx thread (0 is primary)
+typedef ZmFn<const ZiCxnInfo &> ZiRxAssignFn;
+
 // named parameter list for configuring ZiMultiplex
 class ZiMxParams {
   ZiMxParams(const ZiMxParams &) = delete;
@@ -681,11 +765,55 @@ public:
     m_txThread = tid;
     return ZuMv(*this);
   }
+  // additional Rx threads, each with its own epoll set (and io_uring);
+  // the primary Rx thread alone listens and connects, assigning each
+  // new connection to an Rx thread for its lifetime
+  inline ZiMxParams &&addRxThread(unsigned tid) {
+    m_rxThreads.push(tid);
+    return ZuMv(*this);
+  }
+  inline ZiMxParams &&rxPolicy(int policy) {
+    m_rxPolicy = policy;
+    return ZuMv(*this);
+  }
+  inline ZiMxParams &&rxAssign(ZiRxAssignFn fn) {
+    m_rxAssign = ZuMv(fn);
+    return ZuMv(*this);
+  }
 #ifdef ZiMultiplex_EPoll
   inline ZiMxParams &&epollMaxFDs(unsigned n)
     { m_epollMaxFDs = n; return ZuMv(*this); }
   inline ZiMxParams &&epollQuantum(unsigned n)
     { m_epollQuantum = n; return ZuMv(*this); }
+  // UDP - maximum datagrams per recvmmsg() / sendmmsg(); 1 disables
+  inline ZiMxParams &&udpBatch(unsigned n)
+    { m_udpBatch = n; return ZuMv(*this); }
+  // TCP - maximum buffers gathered per writev(); 1 disables
+  inline ZiMxParams &&tcpBatch(unsigned n)
+    { m_tcpBatch = n; return ZuMv(*this); }
+#endif
+#ifdef ZiMultiplex_URing
+  // io_uring - connections receive via multishot requests into a shared
+  // pool of provided buffers; sends remain direct, with POLLOUT awaited
+  // via the ring; listening, connecting and wake-ups remain with epoll
+  inline ZiMxParams &&uring(bool b)
+    { m_uring = b; return ZuMv(*this); }
+  inline ZiMxParams &&uringSize(unsigned n)
+    { m_uringSize = n; return ZuMv(*this); }
+  inline ZiMxParams &&uringBufs(unsigned n)
+    { m_uringBufs = n; return ZuMv(*this); }
+  // - UDP datagrams larger than uringBufSize less the recvmsg() header
+  //   and source address (4064 bytes by default for IPv4) are truncated,
+  //   and logged as such; use epoll, or a larger uringBufSize, to
+  //   receive jumbo datagrams
+  inline ZiMxParams &&uringBufSize(unsigned n)
+    { m_uringBufSize = n; return ZuMv(*this); }
+  // io_uring - maximum buffers queued on a connection pending delivery;
+  // once reached, the connection's receive is paused until the app
+  // consumes the backlog (preserving TCP flow control, and preventing
+  // a slow connection from exhausting the shared pool)
+  inline ZiMxParams &&uringCxnBufs(unsigned n)
+    { m_uringCxnBufs = n; return ZuMv(*this); }
 #endif
   inline ZiMxParams &&rxBufSize(unsigned v)
     { m_rxBufSize = v; return ZuMv(*this); }
@@ -709,9 +837,21 @@ public:
 
   inline unsigned rxThread() const { return m_rxThread; }
   inline unsigned txThread() const { return m_txThread; }
+  inline const ZtArray<unsigned> &rxThreads() const { return m_rxThreads; }
+  inline int rxPolicy() const { return m_rxPolicy; }
+  inline const ZiRxAssignFn &rxAssign() const { return m_rxAssign; }
 #ifdef ZiMultiplex_EPoll
   inline unsigned epollMaxFDs() const { return m_epollMaxFDs; }
   inline unsigned epollQuantum() const { return m_epollQuantum; }
+  inline unsigned udpBatch() const { return m_udpBatch; }
+  inline unsigned tcpBatch() const { return m_tcpBatch; }
+#endif
+#ifdef ZiMultiplex_URing
+  inline bool uring() const { return m_uring; }
+  inline unsigned uringSize() const { return m_uringSize; }
+  inline unsigned uringBufs() const { return m_uringBufs; }
+  inline unsigned uringBufSize() const { return m_uringBufSize; }
+  inline unsigned uringCxnBufs() const { return m_uringCxnBufs; }
 #endif
   inline unsigned rxBufSize() const { return m_rxBufSize; }
   inline unsigned txBufSize() const { return m_txBufSize; }
@@ -730,9 +870,21 @@ private:
   ZmSchedParams		m_scheduler;
   unsigned		m_rxThread = RxThread;
   unsigned		m_txThread = TxThread;
+  ZtArray<unsigned>	m_rxThreads;
+  int			m_rxPolicy = ZiMxRxPolicy::Hash;
+  ZiRxAssignFn		m_rxAssign;
 #ifdef ZiMultiplex_EPoll
   unsigned		m_epollMaxFDs = 256;
   unsigned		m_epollQuantum = 8;
+  unsigned		m_udpBatch = 16;
+  unsigned		m_tcpBatch = 16;
+#endif
+#ifdef ZiMultiplex_URing
+  bool			m_uring = false;
+  unsigned		m_uringSize = 256;	// SQ entries
+  unsigned		m_uringBufs = 1024;	// provided buffers
+  unsigned		m_uringBufSize = 4096;
+  unsigned		m_uringCxnBufs = 64;	// per-connection limit
 #endif
   unsigned		m_rxBufSize = 0;
   unsigned		m_txBufSize = 0;
@@ -749,7 +901,7 @@ private:
 };
 
 // display sequence:
-//   id, state, nThreads, rxThread, txThread,
+//   id, state, nThreads, rxThread, txThread, nRxThreads,
 //   priority, stackSize, partition, rxBufSize, txBufSize,
 //   queueSize, ll, spin, timeout
 struct ZiMxTelemetry { // not graphable
@@ -767,6 +919,18 @@ struct ZiMxTelemetry { // not graphable
   uint8_t	ll;
   uint8_t	priority;
   uint8_t	nThreads;
+  uint8_t	nRxThreads;
+};
+
+// display sequence:
+//   mxID, index, tid, nCxns, rxRequests, rxBytes
+struct ZiMxRxTelemetry { // one per Rx thread
+  ZuID		mxID;		// primary key
+  uint64_t	rxRequests;	// graphable (*)
+  uint64_t	rxBytes;	// graphable
+  uint32_t	nCxns;		// graphable
+  uint16_t	tid;
+  uint8_t	index;		// primary key - 0 is the primary Rx thread
 };
 
 class ZiAPI ZiMultiplex : public ZmScheduler {
@@ -774,6 +938,7 @@ class ZiAPI ZiMultiplex : public ZmScheduler {
   ZiMultiplex &operator =(const ZiMultiplex &);	// prevent mis-use
 
 friend class ZiConnection;
+friend class ZiMultiplex__Rx;
 
   class Listener_;
 #if !ZiMultiplex__AcceptHeap
@@ -969,13 +1134,18 @@ public:
   int start();
   void stop(bool drain);
 private:
-  void stop_1();	// Rx thread - disconnect all connections
+  void stop_1();	// Rx thread - stop all Rx threads
+  void rxStop(ZiMultiplex__Rx *);	// each Rx thread - disconnect all
+  void rxStopped(ZiMultiplex__Rx *);	// each Rx thread - drain
   void stop_2();	// Rx thread - stop connecting / listening / accepting
   void stop_3();	// App thread - clean up
 
 public:
   void allCxns(ZmFn<ZiConnection *> fn);
-  void allCxns_(ZmFn<ZiConnection *> fn);			// Rx thread
+private:
+  void allCxns_(ZiMultiplex__Rx *, ZmFn<ZiConnection *> fn);	// Rx thread
+
+public:
 
   void listen(
       ZiListenFn listenFn, ZiFailFn failFn, ZiConnectFn acceptFn,
@@ -1013,6 +1183,11 @@ public:
   ZuInline unsigned rxThread() const { return m_rxThread; }
   ZuInline unsigned txThread() const { return m_txThread; }
 
+  // Rx threads, including the primary Rx thread (index 0)
+  ZuInline unsigned nRxThreads() const { return m_nRx; }
+  unsigned rxThread(unsigned i) const;
+  ZuInline int rxPolicy() const { return m_rxPolicy; }
+
   template <typename ...Args> ZuInline void rxRun(Args &&... args) {
     run(m_rxThread, ZuFwd<Args>(args)...);
   }
@@ -1054,6 +1229,15 @@ public:
 #ifdef ZiMultiplex_EPoll
   ZuInline unsigned epollMaxFDs() const { return m_epollMaxFDs; }
   ZuInline unsigned epollQuantum() const { return m_epollQuantum; }
+  ZuInline unsigned udpBatch() const { return m_udpBatch; }
+  ZuInline unsigned tcpBatch() const { return m_tcpBatch; }
+#endif
+#ifdef ZiMultiplex_URing
+  ZuInline bool uring() const { return m_uringOn; }
+  ZuInline unsigned uringSize() const { return m_uringSize; }
+  ZuInline unsigned uringBufs() const { return m_uringBufs; }
+  ZuInline unsigned uringBufSize() const { return m_uringBufSize; }
+  ZuInline unsigned uringCxnBufs() const { return m_uringCxnBufs; }
 #endif
   ZuInline unsigned rxBufSize() const { return m_rxBufSize; }
   ZuInline unsigned txBufSize() const { return m_txBufSize; }
@@ -1067,6 +1251,7 @@ public:
     return v;
   }
   void telemetry(ZiMxTelemetry &data) const;
+  void telemetry(ZiMxRxTelemetry &data, unsigned i) const;
 
 private:
   void drain();			// prevents mis-use of ZmScheduler::drain
@@ -1074,9 +1259,14 @@ private:
   ZuInline void busy() { ZmScheduler::busy(); }
   ZuInline void idle() { ZmScheduler::idle(); }
 
-  void rx();			// handle I/O completions (IOCP) or
+  void rx(ZiMultiplex__Rx *);	// handle I/O completions (IOCP) or
   				// readiness notifications (epoll, ports, etc.)
   void wake();			// wake up rx(), cause it to return
+  void wake(ZiMultiplex__Rx *);
+
+  bool rxInit(ZiMultiplex__Rx *);
+  void rxFinal(ZiMultiplex__Rx *);
+  ZiMultiplex__Rx *rxAssign(const ZiCxnInfo &);
 
 #ifdef ZiMultiplex_EPoll
   void connect(Connect *);
@@ -1085,6 +1275,7 @@ private:
   void overlappedConnect(Connect *, int status, unsigned, ZeError e);
 #endif
   void executedConnect(ZiConnectFn, const ZiCxnInfo &);
+  void executedConnect_(ZiMultiplex__Rx *, ZiConnectFn, const ZiCxnInfo &);
 
   void accept(Listener *);
 #ifdef ZiMultiplex_IOCP
@@ -1094,13 +1285,27 @@ private:
   void disconnected(ZiConnection *cxn);
 
 #ifdef ZiMultiplex_EPoll
+  int epollWait(ZiMultiplex__Rx *, int timeout);
   bool epollRecv(ZiConnection *, int s, uint32_t events);
 #endif
+#ifdef ZiMultiplex_URing
+  bool uringInit(ZiMultiplex__Rx *);
+  void uringFinal(ZiMultiplex__Rx *);
+  void uringRx(ZiMultiplex__Rx *);
+  bool uringCompleted(
+      ZiMultiplex__Rx *, const struct io_uring_cqe &, bool woken);
+  void uringDrain(ZiMultiplex__Rx *);
+  void uringEPoll(ZiMultiplex__Rx *);
+  void uringRecv(ZiConnection *);
+  void uringRecvCancel(ZiConnection *);
+  void uringPollOut(ZiConnection *);
+  void uringCancel(ZiConnection *);
+#endif
 
   bool initSocket(Socket, const ZiCxnOptions &);
 
   bool cxnAdd(ZiConnection *, Socket);
-  void cxnDel(Socket);
+  void cxnDel(ZiConnection *, Socket);
 
   bool listenerAdd(Listener *, Socket);
   void listenerDel(Socket);
@@ -1109,22 +1314,27 @@ private:
   void connectDel(Socket);
 
 #ifdef ZiMultiplex_EPoll
-  bool readWake();
-  void writeWake();
+  bool readWake(ZiMultiplex__Rx *);
+  void writeWake(ZiMultiplex__Rx *);
 #endif
 
   StateLock		m_stateLock;	// guards ZmScheduler state
     ZmSemaphore		  *m_stopping;
     bool		  m_drain;
 
-  unsigned		m_rxThread;
+  unsigned		m_rxThread;	// primary Rx thread
     // Rx exclusive
     ZmRef<ListenerHash>	  m_listeners;
     unsigned		  m_nAccepts;	// total #accepts for all listeners
 #if ZiMultiplex__ConnectHash
     ZmRef<ConnectHash>	  m_connects;
 #endif
-    ZmRef<CxnHash>	  m_cxns;		// connections
+
+  ZiMultiplex__Rx	*m_rx;		// Rx threads, m_rx[0] is primary
+  unsigned		m_nRx;
+  int			m_rxPolicy;
+  ZiRxAssignFn		m_rxAssign;
+  ZmAtomic<unsigned>	m_rxStopping;	// # Rx threads yet to stop
 
   unsigned		m_txThread;
 
@@ -1136,10 +1346,18 @@ private:
 #endif
 
 #ifdef ZiMultiplex_EPoll
-  int			m_epollFD;
   unsigned		m_epollMaxFDs;
   unsigned		m_epollQuantum;
-  int			m_wakeFD, m_wakeFD2;	// wake pipe
+  unsigned		m_udpBatch;
+  unsigned		m_tcpBatch;
+#endif
+
+#ifdef ZiMultiplex_URing
+  bool			m_uringOn;
+  unsigned		m_uringSize;
+  unsigned		m_uringBufs;
+  unsigned		m_uringBufSize;
+  unsigned		m_uringCxnBufs;
 #endif
 
 #ifdef ZiMultiplex_DEBUG
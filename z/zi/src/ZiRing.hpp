@@ -234,6 +234,8 @@ class ZiRing : public NTP::Base, public ZiRing_ {
 public:
   enum { CacheLineSize = ZmPlatform::CacheLineSize };
 
+  enum { Prefetch = 4 }; // cache lines prefetched ahead by shiftN()
+
   enum { // open() flags
     Create	= 0x00000001,
     Read	= 0x00000002,
@@ -744,11 +746,7 @@ public:
 	if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
 	if (*(ZmAtomic<uint64_t> *)ptr &= ~(1ULL<<m_id)) continue;
 	/**/ZiRing_bp(detach3);
-	if (ZuUnlikely(!m_params.ll())) {
-	  if (ZuUnlikely(this->tail().xch(tail) & Waiting))
-	    ZiRing_wake(Tail, this->tail(), 1);
-	} else
-	  this->tail() = tail; // release
+	release(tail);
       }
       head_ = head;
       /**/ZiRing_bp(detach4);
@@ -804,16 +802,100 @@ public:
     if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
     m_tail = tail;
     if (*(ZmAtomic<uint64_t> *)ptr &= ~(1ULL<<m_id)) return;
-    if (ZuUnlikely(!m_params.ll())) {
-      if (ZuUnlikely(this->tail().xch(tail) & Waiting))
-	ZiRing_wake(Tail, this->tail(), 1);
-    } else
-      this->tail() = tail; // release
+    release(tail);
 
     this->outCount().store_(this->outCount().load_() + 1);
     this->outBytes().store_(this->outBytes().load_() + size_);
   }
 
+  // batched shift - returns a span of n ready messages (1 <= n <= max),
+  // contiguous in (double-mapped) memory; each message is followed by
+  // the next, which can be obtained using next(); shift2N(n) then
+  // releases the span, publishing the shared tail at most once
+  inline T *shiftN(unsigned max, unsigned &n) {
+    ZmAssert(m_ctrl.addr());
+    ZmAssert(m_flags & Read);
+    ZmAssert(m_id >= 0);
+    ZmAssert(max);
+
+    uint32_t tail = m_tail;
+    uint32_t head;
+  retry:
+    head = this->head(); // acquire
+    /**/ZiRing_bp(shift1);
+    if (tail == (head & ~Mask)) {
+      if (ZuUnlikely(head & EndOfFile)) return 0;
+      if (ZuUnlikely(!m_params.ll()))
+	if (ZiRing_wait(Head, this->head(), head) != Zi::OK) return 0;
+      goto retry;
+    }
+
+    head &= ~Mask;
+    uint8_t *data = (uint8_t *)this->data();
+    uint8_t *ptr = &data[tail & ~Wrapped];
+    uint8_t *next = ptr;
+    uint32_t pos = tail;
+    unsigned i = 0;
+    do {
+      ZuPrefetchW(next + (unsigned)Prefetch * CacheLineSize);
+      pos += align(Traits::size(*(const T *)&next[8]));
+      if ((pos & ~Wrapped) >= size()) pos = (pos ^ Wrapped) - size();
+      next = &data[pos & ~Wrapped];
+    } while (++i < max && pos != head);
+    n = i;
+    return (T *)&ptr[8];
+  }
+  ZuInline T *next(const T *msg) {
+    const uint8_t *ptr = (const uint8_t *)msg + align(Traits::size(*msg));
+    return (T *)ptr;
+  }
+  inline void shift2N(unsigned n) {
+    ZmAssert(m_ctrl.addr());
+    ZmAssert(m_flags & Read);
+    ZmAssert(m_id >= 0);
+
+    uint32_t tail = m_tail, last = 0;
+    unsigned count = 0, bytes = 0;
+    for (unsigned i = 0; i < n; i++) {
+      uint8_t *ptr = &((uint8_t *)data())[tail & ~Wrapped];
+      uint32_t size_ = align(Traits::size(*(const T *)&ptr[8]));
+      tail += size_;
+      if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
+      if (!(*(ZmAtomic<uint64_t> *)ptr &= ~(1ULL<<m_id)))
+	last = tail, ++count, bytes += size_;
+    }
+    m_tail = tail;
+    if (!count) return;
+    release(last);
+
+    this->outCount().store_(this->outCount().load_() + count);
+    this->outBytes().store_(this->outBytes().load_() + bytes);
+  }
+
+private:
+  // the last reader to consume a message advances the shared tail; since
+  // multiple readers can concurrently be last to consume successive
+  // messages, the tail is only ever moved forwards
+  inline void release(uint32_t tail) {
+    uint32_t prev = this->tail().load_();
+    for (;;) {
+      {
+	uint32_t size = this->size();
+	uint32_t old = prev & ~Mask;
+	uint32_t d = ((tail & ~Wrapped) + ((tail & Wrapped) ? size : 0)) -
+	  ((old & ~Wrapped) + ((old & Wrapped) ? size : 0));
+	if ((int32_t)d < 0) d += size<<1;
+	if (!d || d > size) return; // already advanced past tail
+      }
+      uint32_t prev_ = this->tail().cmpXch(tail, prev);
+      if (prev_ == prev) break;
+      prev = prev_;
+    }
+    if (ZuUnlikely(!m_params.ll()) && ZuUnlikely(prev & Waiting))
+      ZiRing_wake(Tail, this->tail(), 1);
+  }
+
+public:
   // can be called by readers after push returns 0; returns
   // EndOfFile (< 0), or amount of data remaining in ring buffer (>= 0)
   int readStatus() {
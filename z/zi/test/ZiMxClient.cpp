@@ -219,6 +219,8 @@ void usage()
     "  -v\t- enable ZiMultiplex debug\n"
     "  -m N\t- epoll - N is max number of file descriptors (default: 8)\n"
     "  -q N\t- epoll - N is epoll_wait() quantum (default: 8)\n"
+    "  -u\t- epoll - use io_uring for receive\n"
+    "  -x N\t- use N additional Rx threads (default: 0)\n"
     "  -R N\t- receive buffer size (default: OS setting)\n"
     "  -S N\t- send buffer size (default: OS setting)\n"
     << std::flush;
@@ -303,6 +305,19 @@ int main(int argc, char **argv)
 #endif
 	}
 	break;
+      case 'u':
+#ifdef ZiMultiplex_URing
+	params.uring(true);
+#endif
+	break;
+      case 'x':
+	{
+	  int j;
+	  if ((j = atoi(argv[++i])) <= 0) usage();
+	  params.scheduler([j](auto &s) { s.nThreads(3 + j); });
+	  for (int k = 0; k < j; k++) params.addRxThread(4 + k);
+	}
+	break;
       case 'R':
 	{
 	  int j;
@@ -93,6 +93,7 @@ public:
     if ((io.offset += io.length) < io.size) return;
     io.init(ZiIOFn::Member<&Connection::sendComplete>::fn(this),
 	m_content.data(), m_content.length(), 0);
+    io.last = true;
   }
   void sendComplete(ZiIOContext &io) {
     //{ printf("Content Length: %d\n", m_content.size()); fflush(stdout); }
@@ -200,6 +201,9 @@ void usage()
     "  -v\t- enable ZiMultiplex debug\n"
     "  -m N\t- epoll - N is max number of file descriptors (default: 8)\n"
     "  -q N\t- epoll - N is epoll_wait() quantum (default: 8)\n"
+    "  -B N\t- epoll - N is TCP writev() batch (default: 16)\n"
+    "  -u\t- epoll - use io_uring for receive\n"
+    "  -x N\t- use N additional Rx threads (default: 0)\n"
     "  -R N\t- receive buffer size (default: OS setting)\n"
     "  -S N\t- send buffer size (default: OS setting)\n"
     << std::flush;
@@ -284,6 +288,28 @@ int main(int argc, char **argv)
 #endif
 	}
 	break;
+      case 'B':
+	{
+	  int j;
+	  if ((j = atoi(argv[++i])) <= 0) usage();
+#ifdef ZiMultiplex_EPoll
+	  params.tcpBatch(j);
+#endif
+	}
+	break;
+      case 'u':
+#ifdef ZiMultiplex_URing
+	params.uring(true);
+#endif
+	break;
+      case 'x':
+	{
+	  int j;
+	  if ((j = atoi(argv[++i])) <= 0) usage();
+	  params.scheduler([j](auto &s) { s.nThreads(3 + j); });
+	  for (int k = 0; k < j; k++) params.addRxThread(4 + k);
+	}
+	break;
       case 'R':
 	{
 	  int j;
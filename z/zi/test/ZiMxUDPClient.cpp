@@ -59,6 +59,7 @@ public:
     io.init(
 	ZiIOFn::Member<&Connection::sendComplete>::fn(this),
 	(void *)Messages[i], len, 0, m_dest);
+    io.last = true;
   }
   void sendComplete(ZiIOContext &io) { io.complete(); }
 
@@ -131,6 +132,8 @@ void usage()
     "  -v\t\t- enable ZiMultiplex debug\n"
     "  -m N\t\t- epoll - N is max number of file descriptors (default: 8)\n"
     "  -q N\t\t- epoll - N is epoll_wait() quantum (default: 8)\n"
+    "  -B N\t\t- epoll - N is UDP recvmmsg()/sendmmsg() batch (default: 16)\n"
+    "  -u\t\t- epoll - use io_uring for receive\n"
     "  -b [HOST:]PORT- bind to HOST:PORT (HOST defaults to INADDR_ANY)\n"
     "  -d HOST:PORT\t- send to HOST:PORT\n"
     "  -c\t\t- connect() - filter packets received from other sources\n"
@@ -199,6 +202,20 @@ int main(int argc, const char *argv[])
 #endif
 	}
 	break;
+      case 'B':
+	{
+	  int j;
+	  if ((j = atoi(argv[++i])) <= 0) usage();
+#ifdef ZiMultiplex_EPoll
+	  params.udpBatch(j);
+#endif
+	}
+	break;
+      case 'u':
+#ifdef ZiMultiplex_URing
+	params.uring(true);
+#endif
+	break;
       case 'b':
 	{
 	  ZtRegex::Captures c;
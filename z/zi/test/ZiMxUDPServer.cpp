@@ -114,6 +114,9 @@ void Connection::recvComplete(ZiIOContext &io)
   std::cout << ZtHexDump(
       ZtString() << io.addr.ip() << ':' << ZuBoxed(io.addr.port()) << ' ' <<
       ZuString(m_msg.data(), io.length), m_msg.data(), io.length);
+  if (!!io.stamp)
+    std::cout << "kernel Rx latency: " <<
+      ZuBoxed((ZmTimeNow() - io.stamp).nanosecs()) << "ns\n";
   fflush(stdout);
 
   m_echo = !m_dest ? io.addr : m_dest;
@@ -141,9 +144,12 @@ void usage()
     "  -v\t\t- enable ZiMultiplex debug\n"
     "  -m N\t\t- epoll - N is max number of file descriptors (default: 8)\n"
     "  -q N\t\t- epoll - N is epoll_wait() quantum (default: 8)\n"
+    "  -B N\t\t- epoll - N is UDP recvmmsg()/sendmmsg() batch (default: 16)\n"
+    "  -u\t\t- epoll - use io_uring for receive\n"
     "  -b [HOST:]PORT- bind to HOST:PORT (HOST defaults to INADDR_ANY)\n"
     "  -d HOST:PORT\t- send to HOST:PORT\n"
     "  -c\t\t- connect() - filter packets received from other sources\n"
+    "  -S\t\t- enable kernel Rx timestamps\n"
     "  -M\t\t- use multicast\n"
     "  -L\t\t- use multicast loopback\n"
     "  -D IP\t\t- multicast to interface IP\n"
@@ -212,6 +218,20 @@ int main(int argc, const char *argv[])
 #endif
 	}
 	break;
+      case 'B':
+	{
+	  int j;
+	  if ((j = atoi(argv[++i])) <= 0) usage();
+#ifdef ZiMultiplex_EPoll
+	  params.udpBatch(j);
+#endif
+	}
+	break;
+      case 'u':
+#ifdef ZiMultiplex_URing
+	params.uring(true);
+#endif
+	break;
       case 'b':
 	{
 	  ZtRegex::Captures c;
@@ -239,6 +259,9 @@ int main(int argc, const char *argv[])
       case 'c':
 	connect = true;
 	break;
+      case 'S':
+	options.rxStamp(true);
+	break;
       case 'M':
 	options.multicast(true);
 	break;
@@ -18,6 +18,8 @@ void usage()
     "  -r\t\t- read from buffer\n"
     "  -w\t\t- write to buffer (default)\n"
     "  -x\t\t- read and write in same process\n"
+    "  -R N\t\t- fan out to N reader threads (default: 1)\n"
+    "  -B N\t\t- read in batches of up to N messages (default: 0 - single)\n"
     "  -l N\t\t- loop N times\n"
     "  -g\t\t- test GC / attach / detach contention\n"
     "  -b BUFSIZE\t- set buffer size to BUFSIZE (default: 8192)\n"
@@ -37,21 +39,25 @@ typedef ZiRing<ZiRingMsg> Ring;
 struct App {
   inline App() :
     flags(Ring::Write | Ring::Create), gc(false), ring(0),
-    count(1), msgsize(1024), interval((time_t)0), slow(false) { }
+    count(1), msgsize(1024), interval((time_t)0), slow(false),
+    readers(1), batch(0) { }
 
   int main(int, char **);
-  void reader();
+  void reader(Ring *ring);
   void writer();
 
   unsigned	flags;
   bool		gc;
   Ring		*ring;
+  Ring		**rings;
   ZmTime	start, end;
   unsigned	count;
   unsigned	msgsize;
   ZmTime	interval;
   bool		slow;
   ZmBitmap	cpuset;
+  unsigned	readers;
+  unsigned	batch;
 };
 
 int main(int argc, char **argv)
@@ -84,6 +90,14 @@ int App::main(int argc, char **argv)
       case 'x':
 	flags = Ring::Read | Ring::Write | Ring::Create;
 	break;
+      case 'R':
+	if (++i >= argc) usage();
+	if (!(readers = atoi(argv[i])) || readers > 64) usage();
+	break;
+      case 'B':
+	if (++i >= argc) usage();
+	batch = atoi(argv[i]);
+	break;
       case 'l':
 	if (++i >= argc) usage();
 	loop = atoi(argv[i]);
@@ -129,8 +143,12 @@ int App::main(int argc, char **argv)
 
   if (!name) usage();
 
-  ring = new Ring(ZiRingParams(name).
-      size(bufsize).ll(ll).spin(spin).coredump(true).cpuset(cpuset));
+  ZiRingParams params = ZiRingParams(name).
+    size(bufsize).ll(ll).spin(spin).coredump(true).cpuset(cpuset);
+  ring = new Ring(params);
+  rings = new Ring *[readers];
+  rings[0] = ring;
+  for (unsigned i = 1; i < readers; i++) rings[i] = new Ring(params);
 
   for (unsigned i = 0; i < loop; i++) {
     {
@@ -140,6 +158,12 @@ int App::main(int argc, char **argv)
 	std::cerr << e << '\n' << std::flush;
 	ZmPlatform::exit(1);
       }
+      if (flags & Ring::Read)
+	for (unsigned i = 1; i < readers; i++)
+	  if (rings[i]->shadow(*ring, &e) != Zi::OK) {
+	    std::cerr << e << '\n' << std::flush;
+	    ZmPlatform::exit(1);
+	  }
     }
 
     std::cerr << 
@@ -148,13 +172,19 @@ int App::main(int argc, char **argv)
       "  size: " << ZuBoxed(ring->size()) << '\n';
 
     {
-      ZmThread r, w;
+      ZmThread r[readers], w;
 
+      if (!(flags & Ring::Write)) start.now();
       if (flags & Ring::Read)
-	r = ZmThread(0, ZmFn<>::Member<&App::reader>::fn(this));
+	for (unsigned i = 0; i < readers; i++)
+	  r[i] = ZmThread(0, ZmFn<>([this, i]() { reader(rings[i]); }));
       if (flags & Ring::Write)
 	w = ZmThread(0, ZmFn<>::Member<&App::writer>::fn(this));
-      if (!!r) r.join();
+      if (flags & Ring::Read) {
+	for (unsigned i = 0; i < readers; i++)
+	  if (!!r[i]) r[i].join();
+	end.now();
+      }
       if (!!w) w.join();
     }
 
@@ -168,31 +198,53 @@ int App::main(int argc, char **argv)
       ZuBoxed((double)((start.dtime() / (double)count) * (double)1000000)) <<
       " usec\n";
 
+    if ((flags & Ring::Read) && !gc)
+      std::cerr <<
+	"readers: " << ZuBoxed(readers) <<
+	"  batch: " << ZuBoxed(batch) <<
+	"  fan-out msgs/s: " <<
+	ZuBoxed((double)count * readers / start.dtime()).fmt(ZuFmt::FP<0>()) <<
+	'\n';
+
+    for (unsigned i = 1; i < readers; i++) rings[i]->close();
     ring->close();
   }
 
+  for (unsigned i = 1; i < readers; i++) delete rings[i];
+  delete [] rings;
+  delete ring;
+
   return 0;
 }
 
-void App::reader()
+void App::reader(Ring *ring)
 {
   std::cerr << "reader started\n";
   if (!gc) {
     ring->attach();
     std::cerr << "reader attached\n";
   }
-  if (!(flags & Ring::Write)) start.now();
   for (unsigned j = 0; j < count; j++) {
     if (gc) {
       ring->attach();
       ring->detach();
       continue;
     }
-    if (const ZiRingMsg *msg = ring->shift()) {
+    const ZiRingMsg *msg;
+    unsigned n = 1;
+    if (batch)
+      msg = ring->shiftN(batch, n);
+    else
+      msg = ring->shift();
+    if (msg) {
       // std::cerr << "shift: " << ZuBoxPtr(msg).hex() << " len: " << ZuBoxed(sizeof(ZiRingMsg) + msg->length()) << '\n';
       // for (unsigned i = 0, n = msg->length(); i < n; i++) assert(((const char *)(msg->ptr()))[i] == (char)(i & 0xff));
       // std::cerr << "msg read\n";
-      ring->shift2();
+      if (batch)
+	ring->shift2N(n);
+      else
+	ring->shift2();
+      j += n - 1;
     } else {
       int i = ring->readStatus();
       if (i == Zi::EndOfFile)
@@ -207,7 +259,6 @@ void App::reader()
     }
     if (slow && !!interval) ZmPlatform::sleep(interval);
   }
-  end.now();
   if (!gc) ring->detach();
 }
 
@@ -0,0 +1,54 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+// adaptive spin-then-block mutex
+
+#include <zlib/ZmALock.hpp>
+
+#ifdef linux
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+void ZmALock::lock_()
+{
+  int max = m_spins * 2 + 10;
+  if (max > (int)MaxSpin) max = MaxSpin;
+  int n = 0;
+  while (n < max) {
+    ++n;
+    ZmPlatform::pause();
+    if (!m_state.load_() && m_state.cmpXch(Locked, Unlocked) == Unlocked) {
+      m_spins += (n - m_spins) / 8;
+      return;
+    }
+  }
+  m_spins += (n - m_spins) / 8;
+  while (m_state.xch(Contended) != Unlocked)
+    syscall(SYS_futex, (volatile int *)&m_state,
+	FUTEX_WAIT | FUTEX_PRIVATE_FLAG, (int)Contended, 0, 0, 0);
+}
+
+void ZmALock::wake()
+{
+  syscall(SYS_futex, (volatile int *)&m_state,
+      FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, 0, 0, 0);
+}
+
+#endif /* linux */
@@ -0,0 +1,90 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// adaptive spin-then-block mutex
+
+// uncontended lock+unlock is a single CAS + exchange, as with ZmPLock;
+// contended lockers spin briefly (bounded by a running average of the
+// spin counts that previously succeeded, as with glibc's
+// PTHREAD_MUTEX_ADAPTIVE_NP) and then park in the kernel, so that
+// performance degrades gracefully when threads outnumber CPUs
+//
+// Linux - futex-based, state is 0 (unlocked), 1 (locked) or 2 (locked,
+// possibly with waiters), cf. Drepper, "Futexes Are Tricky" (2011)
+// Windows - ZmPLock is already a spin-then-block CRITICAL_SECTION
+// elsewhere - falls back to ZmPLock
+
+#ifndef ZmALock_HPP
+#define ZmALock_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmPLock.hpp>
+#include <zlib/ZmLockTraits.hpp>
+
+#ifndef linux
+typedef ZmPLock ZmALock;
+#else
+
+class ZmAPI ZmALock {
+  ZmALock(const ZmALock &);
+  ZmALock &operator =(const ZmALock &);	// prevent mis-use
+
+  enum { Unlocked = 0, Locked, Contended };
+
+public:
+  enum { MaxSpin = 200 };	// upper bound on spin iterations
+
+  ZuInline ZmALock() { }
+
+  ZuInline void lock() {
+    if (ZuLikely(m_state.cmpXch(Locked, Unlocked) == Unlocked)) return;
+    lock_();
+  }
+  ZuInline int trylock() {
+    return m_state.cmpXch(Locked, Unlocked) == Unlocked ? 0 : -1;
+  }
+  ZuInline void unlock() {
+    if (ZuUnlikely(m_state.xch(Unlocked) == Contended)) wake();
+  }
+
+private:
+  void lock_();
+  void wake();
+
+  ZmAtomic<uint32_t>	m_state;
+  int			m_spins = 0;	// running average (racy by design)
+};
+
+template <>
+struct ZmLockTraits<ZmALock> : public ZmGenericLockTraits<ZmALock> {
+  enum { CanTry = 1, Recursive = 0, RWLock = 0 };
+};
+
+#endif /* linux */
+
+#endif /* ZmALock_HPP */
@@ -0,0 +1,174 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// reader-biased R/W lock with distributed reader counters
+
+// drop-in alternative to ZmRWLock for read-mostly data; each reader
+// increments a counter in a cache-line-sized slot selected by its thread ID
+// (one slot per CPU, up to 64), so that concurrent readers on different
+// cores do not contend for a shared cache line; writers are serialized by a
+// ZmPLock, then revoke the readers' bias by setting the writer flag, and
+// wait for every slot to drain; readers that observe the writer flag back
+// off and yield until the writer unlocks
+//
+// writes are expensive (proportional to the number of slots), so this
+// is only suitable for data that is rarely modified; write locks are
+// recursive, read locks are recursive only in the absence of writers
+// (as with ZmRWLock)
+
+#ifndef ZmBRWLock_HPP
+#define ZmBRWLock_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZuBox.hpp>
+#include <zlib/ZuPrint.hpp>
+
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmPLock.hpp>
+#include <zlib/ZmLockTraits.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+class ZmBRWLock {
+  ZmBRWLock(const ZmBRWLock &);
+  ZmBRWLock &operator =(const ZmBRWLock &);	// prevent mis-use
+
+  enum { MaxBits = 6 };		// maximum 64 slots
+
+  struct alignas(64) Slot {
+    ZmAtomic<uint32_t>	readers;
+  };
+
+public:
+  inline ZmBRWLock() {
+    unsigned n = ZmPlatform::getncpu();
+    unsigned bits = 0;
+    while (bits < MaxBits && (1U<<bits) < n) ++bits;
+    m_bits = bits;
+    m_slots = new Slot[1U<<bits];
+    ZmPLock_init(m_lock);
+  }
+  inline ~ZmBRWLock() {
+    ZmPLock_final(m_lock);
+    delete [] m_slots;
+  }
+
+  inline void lock() {
+    ZmPlatform::ThreadID tid = ZmPlatform::getTID();
+    if (m_tid == tid) { ++m_count; return; }
+    ZmPLock_lock(m_lock);
+    lock_(tid);
+  }
+  inline int trylock() {
+    ZmPlatform::ThreadID tid = ZmPlatform::getTID();
+    if (m_tid == tid) { ++m_count; return 0; }
+    if (!ZmPLock_trylock(m_lock)) return -1;
+    lock_(tid);
+    return 0;
+  }
+  inline void unlock() {
+    if (--m_count) return;
+    m_tid = 0;
+    m_writer = 0; // release
+    ZmPLock_unlock(m_lock);
+  }
+
+  ZuInline void readlock() {
+    Slot *slot = this->slot();
+    for (;;) {
+      ++slot->readers; // full barrier
+      if (ZuLikely(!m_writer)) return; // acquire
+      --slot->readers;
+      while (m_writer.load_()) ZmPlatform::yield(); // wait for writer
+    }
+  }
+  ZuInline int readtrylock() {
+    Slot *slot = this->slot();
+    ++slot->readers; // full barrier
+    if (ZuLikely(!m_writer)) return 0; // acquire
+    --slot->readers;
+    return -1;
+  }
+  ZuInline void readunlock() {
+    --slot()->readers;
+  }
+
+  template <typename S> inline void print(S &s) const {
+    uint32_t readers = 0;
+    for (unsigned i = 0, n = 1U<<m_bits; i < n; i++)
+      readers += m_slots[i].readers.load_();
+    s << "writer=" << ZuBoxed(m_writer.load_()) <<
+      " tid=" << ZuBoxed(m_tid.load_()) <<
+      " count=" << ZuBoxed(m_count) <<
+      " readers=" << ZuBoxed(readers) <<
+      " slots=" << ZuBoxed(1U<<m_bits);
+  }
+
+private:
+  // Fibonacci hash of the thread ID - adjacent thread IDs map to
+  // different slots
+  ZuInline Slot *slot() const {
+    if (ZuUnlikely(!m_bits)) return m_slots;
+    return &m_slots[
+      ((uint32_t)ZmPlatform::getTID() * 0x9e3779b9U)>>(32 - m_bits)];
+  }
+
+  inline void lock_(ZmPlatform::ThreadID tid) {
+    m_writer.xch(1); // full barrier - revoke reader bias
+    for (unsigned i = 0, n = 1U<<m_bits; i < n; i++)
+      while (m_slots[i].readers.load_()) ZmPlatform::yield();
+    ZmAtomic_acquire();
+    m_tid = tid;
+    m_count = 1;
+  }
+
+  ZmAtomic<uint32_t>		m_writer;
+  unsigned			m_bits = 0;
+  Slot				*m_slots = nullptr;
+  ZmPLock_			m_lock;
+  ZmAtomic<ZmPlatform::ThreadID>	m_tid;
+  uint32_t			m_count = 0;
+};
+
+template <>
+struct ZmLockTraits<ZmBRWLock> : public ZmGenericLockTraits<ZmBRWLock> {
+  enum { RWLock = 1 };
+  ZuInline static void readlock(ZmBRWLock &l) { l.readlock(); }
+  ZuInline static int readtrylock(ZmBRWLock &l) { return l.readtrylock(); }
+  ZuInline static void readunlock(ZmBRWLock &l) { l.readunlock(); }
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+template <> struct ZuPrint<ZmBRWLock> : public ZuPrintFn { };
+
+#endif /* ZmBRWLock_HPP */
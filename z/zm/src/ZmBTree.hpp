@@ -0,0 +1,1069 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// B+tree with wide (multiple cache line) blocks
+
+// drop-in alternative to ZmRBTree - same NTP parameters, Node / NodeRef
+// types, API and iterator directions, e.g.
+//
+// typedef ZmBTree<MxMDPxLevel_,
+//	     ZmRBTreeNodeIsKey<true,
+//	       ZmRBTreeIndex<MxMDPxLevel_PxAccessor,
+//		 ZmRBTreeObject<ZmObject,
+//		   ZmRBTreeLock<ZmNoLock,
+//		     ZmRBTreeHeapID<MxMDPxLevels_HeapID> > > > > > MxMDPxLevels;
+//
+// nodes are allocated individually as with ZmRBTree, but the tree itself
+// is a B+tree of ZmBTree_BlockSize blocks containing copies of the index
+// (or the key, if ZmRBTreeIndex is not used) together with node pointers;
+// searches scan contiguous arrays of indices instead of chasing a pointer
+// per comparison, and leaves are doubly linked so that iteration in either
+// direction is sequential; the index should therefore be small and
+// cheaply copyable (integers, prices, short strings, ZmRef<>s)
+//
+// branch separators are copies of indices and are not updated when the
+// corresponding element is deleted; if the index is a ZmRef<>, a separator
+// can retain a reference to a deleted key until the blocks are rebalanced
+
+#ifndef ZmBTree_HPP
+#define ZmBTree_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZmRBTree.hpp>
+
+// block size in bytes (4 cache lines)
+#ifndef ZmBTree_BlockSize
+#define ZmBTree_BlockSize 256
+#endif
+
+// the index is the key itself
+template <typename Key, class NTP,
+  bool Indexed = !ZuConversion<typename NTP::Accessor, ZuNull>::Same>
+struct ZmBTree_Index {
+  typedef Key I;
+  typedef typename NTP::template CmpT<Key>::Cmp Cmp;
+  typedef typename NTP::template ICmpT<Key>::ICmp ICmp;
+
+  ZuInline static const Key &value(const Key &key) { return key; }
+  template <typename Index>
+  ZuInline static int cmp(const I &i1, const Index &i2) {
+    return ICmp::cmp(i1, i2);
+  }
+  ZuInline static int cmp_(const I &i1, const I &i2) {
+    return Cmp::cmp(i1, i2);
+  }
+};
+// the index is obtained from the key via the ZmRBTreeIndex accessor
+template <typename Key, class NTP>
+struct ZmBTree_Index<Key, NTP, true> {
+  typedef typename NTP::Accessor Accessor;
+  typedef typename ZuIndex<Accessor>::I I;
+
+  template <typename Key_>
+  ZuInline static decltype(auto) value(const Key_ &key) {
+    return Accessor::value(key);
+  }
+  template <typename Index>
+  ZuInline static int cmp(const I &i1, const Index &i2) {
+    return Accessor::Cmp::cmp(i1, i2);
+  }
+  ZuInline static int cmp_(const I &i1, const I &i2) {
+    return Accessor::Cmp::cmp(i1, i2);
+  }
+};
+
+template <typename Tree_, int Direction_>
+class ZmBTreeIterator_ { // B+tree iterator
+friend Tree_;
+
+public:
+  typedef Tree_ Tree;
+  enum { Direction = Direction_ };
+  typedef typename Tree::Key Key;
+  typedef typename Tree::Val Val;
+  typedef typename Tree::Cmp Cmp;
+  typedef typename Tree::ValCmp ValCmp;
+  typedef typename Tree::Node Node;
+  typedef typename Tree::NodeRef NodeRef;
+  typedef typename Tree::Leaf Leaf;
+
+protected:
+  inline ZmBTreeIterator_(Tree &tree) : m_tree(tree) {
+    tree.startIterate(*this);
+  }
+  template <typename Index>
+  inline ZmBTreeIterator_(
+      Tree &tree, const Index &index,
+      int compare = Tree::GreaterEqual) :
+    m_tree(tree) {
+    tree.startIterate(*this, index, compare);
+  }
+
+public:
+  inline void reset() {
+    m_tree.startIterate(*this);
+  }
+  template <typename Index>
+  inline void reset(
+      const Index &index,
+      int compare = Tree::GreaterEqual) {
+    m_tree.startIterate(*this, index, compare);
+  }
+
+  inline Node *iterate() { return m_tree.iterate(*this); }
+
+  inline const Key &iterateKey() {
+    Node *node = m_tree.iterate(*this);
+    if (ZuLikely(node)) return node->Node::key();
+    return Cmp::null();
+  }
+  inline const Val &iterateVal() {
+    Node *node = m_tree.iterate(*this);
+    if (ZuLikely(node)) return node->Node::val();
+    return ValCmp::null();
+  }
+
+  ZuInline unsigned count() const { return m_tree.count_(); }
+
+protected:
+  Tree		&m_tree;
+  Leaf		*m_leaf;	// next position
+  unsigned	m_pos;
+  Leaf		*m_lastLeaf;	// position of last node returned
+  unsigned	m_lastPos;
+};
+
+template <typename Tree_, int Direction_ = ZmRBTreeGreaterEqual>
+class ZmBTreeIterator :
+  public Tree_::Guard,
+  public ZmBTreeIterator_<Tree_, Direction_> {
+  typedef Tree_ Tree;
+  enum { Direction = Direction_ };
+  typedef typename Tree::Guard Guard;
+
+public:
+  inline ZmBTreeIterator(Tree &tree) :
+    Guard(tree.lock()),
+    ZmBTreeIterator_<Tree, Direction>(tree) { }
+  template <typename Index_>
+  inline ZmBTreeIterator(Tree &tree, const Index_ &index,
+      int compare = Direction) :
+    Guard(tree.lock()),
+    ZmBTreeIterator_<Tree, Direction>(tree, index, compare) { }
+
+  void del() { this->m_tree.delIterate(*this); }
+};
+
+template <typename Tree_, int Direction_ = ZmRBTreeGreaterEqual>
+class ZmBTreeReadIterator :
+  public Tree_::ReadGuard,
+  public ZmBTreeIterator_<Tree_, Direction_> {
+  typedef Tree_ Tree;
+  enum { Direction = Direction_ };
+  typedef typename Tree::ReadGuard ReadGuard;
+
+public:
+  inline ZmBTreeReadIterator(const Tree &tree) :
+    ReadGuard(tree.lock()),
+    ZmBTreeIterator_<Tree, Direction>(
+	const_cast<Tree &>(tree)) { }
+  template <typename Index_>
+  inline ZmBTreeReadIterator(const Tree &tree, const Index_ &index,
+      int compare = Direction) :
+    ReadGuard(tree.lock()),
+    ZmBTreeIterator_<Tree, Direction>(
+	const_cast<Tree &>(tree), index, compare) { }
+};
+
+template <typename Key_, class NTP = ZmRBTree_Defaults>
+class ZmBTree : public NTP::Base {
+  ZmBTree(const ZmBTree &);
+  ZmBTree &operator =(const ZmBTree &);	// prevent mis-use
+
+  template <typename, int> friend class ZmBTreeIterator_;
+  template <typename, int> friend class ZmBTreeIterator;
+
+public:
+  typedef Key_ Key;
+  typedef typename NTP::Val Val;
+  typedef typename NTP::template CmpT<Key>::Cmp Cmp;
+  typedef typename NTP::template ICmpT<Key>::ICmp ICmp;
+  typedef typename NTP::template IndexT<Key>::Index Index;
+  typedef typename NTP::template ValCmpT<Val>::ValCmp ValCmp;
+  enum { NodeIsKey = NTP::NodeIsKey };
+  enum { NodeIsVal = NTP::NodeIsVal };
+  typedef typename NTP::Lock Lock;
+  typedef typename NTP::Object Object;
+  typedef typename NTP::HeapID HeapID;
+
+  typedef ZmGuard<Lock> Guard;
+  typedef ZmReadGuard<Lock> ReadGuard;
+
+  enum {
+    Equal = ZmRBTreeEqual,
+    GreaterEqual = ZmRBTreeGreaterEqual,
+    LessEqual = ZmRBTreeLessEqual,
+    Greater = ZmRBTreeGreater,
+    Less = ZmRBTreeLess
+  };
+
+  template <int Direction = ZmRBTreeGreaterEqual>
+  using Iterator = ZmBTreeIterator<ZmBTree, Direction>;
+  template <int Direction = ZmRBTreeGreaterEqual>
+  using ReadIterator = ZmBTreeReadIterator<ZmBTree, Direction>;
+
+  // node in a B+tree - unlike ZmRBTree, nodes do not contain any links
+
+  struct NullObject { }; // deconflict with ZuNull
+  template <typename Node, typename Heap,
+    bool NodeIsKey, bool NodeIsVal> class NodeFn :
+      public ZuIf<NullObject, Object,
+	ZuConversion<Object, ZuNull>::Is ||
+	(NodeIsKey && ZuConversion<Object, Key>::Is) ||
+	(NodeIsVal && ZuConversion<Object, Val>::Is)>::T,
+      public Heap {
+    NodeFn(const NodeFn &);
+    NodeFn &operator =(const NodeFn &);	// prevent mis-use
+
+  protected:
+    ZuInline NodeFn() { }
+  };
+
+  template <typename Heap>
+  using Node_ = ZmKVNode<Heap, NodeIsKey, NodeIsVal, NodeFn, Key, Val>;
+  struct NullHeap { }; // deconflict with ZuNull
+  typedef ZmHeap<HeapID, sizeof(Node_<NullHeap>)> NodeHeap;
+  typedef Node_<NodeHeap> Node;
+  typedef typename Node::Fn Fn;
+
+  typedef typename ZuIf<ZmRef<Node>, Node *, ZuIsObject_<Object>::OK>::T
+    NodeRef;
+
+private:
+  typedef ZmBTree_Index<Key, NTP> S;
+  typedef typename S::I I;	// index stored in blocks
+
+  enum {
+    LeafSize_ = (ZmBTree_BlockSize - 4 * sizeof(void *)) /
+      (sizeof(I) + sizeof(void *)),
+    LeafSize = LeafSize_ < 4 ? 4 : LeafSize_,	// elements per leaf
+    BranchSize_ = (ZmBTree_BlockSize - sizeof(void *)) /
+      (sizeof(I) + sizeof(void *)),
+    BranchSize = BranchSize_ < 4 ? 4 : BranchSize_, // children per branch
+    MinLeaf = LeafSize>>1,
+    MinBranch = (BranchSize + 1)>>1
+  };
+
+  struct Branch;
+  struct Block {
+    Branch	*parent = nullptr;
+    unsigned	n = 0;		// elements in a leaf, children in a branch
+  };
+  struct Leaf_ : public Block {
+    Leaf_	*prev = nullptr;
+    Leaf_	*next = nullptr;
+    I		index[LeafSize];
+    Node	*node[LeafSize];
+  };
+  struct Branch_ : public Block {
+    I		index[BranchSize - 1];
+    Block	*child[BranchSize];
+  };
+  struct Branch :
+    public Branch_, public ZmHeap<HeapID, sizeof(Branch_)> { };
+
+public:
+  struct Leaf :
+    public Leaf_, public ZmHeap<HeapID, sizeof(Leaf_)> { };
+
+private:
+  ZuInline static Leaf *next(const Leaf *leaf) {
+    return static_cast<Leaf *>(leaf->next);
+  }
+  ZuInline static Leaf *prev(const Leaf *leaf) {
+    return static_cast<Leaf *>(leaf->prev);
+  }
+
+  // in order to support both intrusively reference-counted and plain node
+  // objects, some overloading is required for ref/deref/delete
+  template <typename O>
+  ZuInline void nodeRef(const ZmRef<O> &o) { ZmREF(o); }
+  template <typename O>
+  ZuInline typename ZuIsObject<O>::T nodeRef(const O *o) { ZmREF(o); }
+  template <typename O>
+  ZuInline void nodeDeref(const ZmRef<O> &o) { ZmDEREF(o); }
+  template <typename O>
+  ZuInline typename ZuIsObject<O>::T nodeDeref(const O *o) { ZmDEREF(o); }
+  template <typename O>
+  ZuInline void nodeDelete(const ZmRef<O> &o) { }
+  template <typename O>
+  ZuInline typename ZuIsObject<O>::T nodeDelete(const O *) { }
+
+  template <typename O>
+  ZuInline typename ZuNotObject<O>::T nodeRef(const O *) { }
+  template <typename O>
+  ZuInline typename ZuNotObject<O>::T nodeDeref(const O *) { }
+  template <typename O>
+  ZuInline typename ZuNotObject<O>::T nodeDelete(const O *o) { delete o; }
+
+public:
+  template <typename ...Args>
+  ZmBTree(Args &&... args) : NTP::Base{ZuFwd<Args>(args)...} { }
+
+  ~ZmBTree() { clean(); }
+
+  inline Lock &lock() const { return m_lock; }
+
+  inline unsigned count() const { ReadGuard guard(m_lock); return m_count; }
+  inline unsigned count_() const { return m_count; }
+
+  inline void add(Node *node) {
+    Guard guard(m_lock);
+    nodeRef(node);
+    add_(node);
+  }
+  template <typename Key__>
+  inline typename ZuNotConvertible<
+	typename ZuDeref<Key__>::T, NodeRef, NodeRef>::T
+      add(Key__ &&key) {
+    NodeRef node = new Node(ZuFwd<Key__>(key));
+    add(node);
+    return node;
+  }
+  template <typename Key__, typename Val_>
+  inline NodeRef add(Key__ &&key, Val_ &&val) {
+    NodeRef node = new Node(ZuFwd<Key__>(key), ZuFwd<Val_>(val));
+    this->add(node);
+    return node;
+  }
+
+  template <typename Index_>
+  inline NodeRef find(const Index_ &index) const {
+    ReadGuard guard(m_lock);
+    return find_(index);
+  }
+  template <typename Index_>
+  inline Node *findPtr(const Index_ &index) const {
+    ReadGuard guard(m_lock);
+    return find_(index);
+  }
+  template <typename Index_>
+  inline const Key &findKey(const Index_ &index) const {
+    ReadGuard guard(m_lock);
+    Node *node = find_(index);
+    if (ZuUnlikely(!node)) return Cmp::null();
+    return node->Node::key();
+  }
+  template <typename Index_>
+  inline const Val &findVal(const Index_ &index) const {
+    ReadGuard guard(m_lock);
+    Node *node = find_(index);
+    if (ZuUnlikely(!node)) return ValCmp::null();
+    return node->Node::val();
+  }
+
+  inline NodeRef minimum() const {
+    ReadGuard guard(m_lock);
+    return minimum_();
+  }
+  inline Node *minimumPtr() const {
+    ReadGuard guard(m_lock);
+    return minimum_();
+  }
+  inline const Key &minimumKey() const {
+    NodeRef node = minimum();
+    if (ZuUnlikely(!node)) return Cmp::null();
+    return node->Node::key();
+  }
+  inline const Val &minimumVal() const {
+    NodeRef node = minimum();
+    if (ZuUnlikely(!node)) return ValCmp::null();
+    return node->Node::val();
+  }
+
+  inline NodeRef maximum() const {
+    ReadGuard guard(m_lock);
+    return maximum_();
+  }
+  inline Node *maximumPtr() const {
+    ReadGuard guard(m_lock);
+    return maximum_();
+  }
+  inline const Key &maximumKey() const {
+    NodeRef node = maximum();
+    if (ZuUnlikely(!node)) return Cmp::null();
+    return node->Node::key();
+  }
+  inline const Val &maximumVal() const {
+    NodeRef node = maximum();
+    if (ZuUnlikely(!node)) return ValCmp::null();
+    return node->Node::val();
+  }
+
+  template <typename Index_>
+  inline typename ZuIfT<
+    !ZuConversion<Index_, Node *>::Exists, NodeRef>::T
+      del(const Index_ &index) {
+    Guard guard(m_lock);
+    Leaf *leaf;
+    unsigned pos;
+    if (!lowerBound(index, leaf, pos) ||
+	S::cmp(leaf->index[pos], index)) return nullptr;
+    Node *node = leaf->node[pos];
+    delPos(leaf, pos);
+    NodeRef *ZuMayAlias(ptr) = (NodeRef *)&node;
+    return ZuMv(*ptr);
+  }
+  inline NodeRef del(Node *node) {
+    if (ZuUnlikely(!node)) return nullptr;
+    Guard guard(m_lock);
+    delNode_(node);
+    NodeRef *ZuMayAlias(ptr) = (NodeRef *)&node;
+    return ZuMv(*ptr);
+  }
+  inline void delNode_(Node *node) {
+    Leaf *leaf;
+    unsigned pos;
+    if (ZuLikely(findNode(node, leaf, pos))) delPos(leaf, pos);
+  }
+  template <typename Index_>
+  inline Key delKey(const Index_ &index) {
+    NodeRef node = del(index);
+    if (ZuUnlikely(!node)) return Cmp::null();
+    Key key = ZuMv(node->Node::key());
+    nodeDelete(node);
+    return key;
+  }
+  template <typename Index_>
+  inline Val delVal(const Index_ &index) {
+    NodeRef node = del(index);
+    if (ZuUnlikely(!node)) return ValCmp::null();
+    Val val = ZuMv(node->Node::val());
+    nodeDelete(node);
+    return val;
+  }
+
+  template <typename Index_, typename Val_>
+  inline typename ZuIfT<
+    !ZuConversion<Index_, Node *>::Exists &&
+    ZuConversion<Val_, Val>::Exists, NodeRef>::T
+      del(const Index_ &index, const Val_ &val) {
+    Guard guard(m_lock);
+    Leaf *leaf;
+    unsigned pos;
+    if (!lowerBound(index, leaf, pos)) return nullptr;
+    while (!S::cmp(leaf->index[pos], index)) {
+      Node *node = leaf->node[pos];
+      if (ValCmp::equals(node->Node::val(), val)) {
+	delPos(leaf, pos);
+	NodeRef *ZuMayAlias(ptr) = (NodeRef *)&node;
+	return ZuMv(*ptr);
+      }
+      if (!step(leaf, pos)) break;
+    }
+    return nullptr;
+  }
+  template <typename Index_, typename Key__>
+  inline typename ZuIfT<
+    !ZuConversion<Index_, Node *>::Exists &&
+    ZuConversion<Key__, Key>::Exists &&
+    !ZuConversion<Key__, Val>::Exists, NodeRef>::T
+      del(const Index_ &index, const Key__ &key) {
+    Guard guard(m_lock);
+    Leaf *leaf;
+    unsigned pos;
+    if (!lowerBound(index, leaf, pos)) return nullptr;
+    while (!S::cmp(leaf->index[pos], index)) {
+      Node *node = leaf->node[pos];
+      if (node->Node::key() == key) { // not Cmp::equals()
+	delPos(leaf, pos);
+	NodeRef *ZuMayAlias(ptr) = (NodeRef *)&node;
+	return ZuMv(*ptr);
+      }
+      if (!step(leaf, pos)) break;
+    }
+    return nullptr;
+  }
+
+  template <int Direction = ZmRBTreeGreaterEqual>
+  inline auto iterator() {
+    return Iterator<Direction>(*this);
+  }
+  template <int Direction, typename Index_>
+  inline auto iterator(Index_ &&index) {
+    return Iterator<Direction>(*this, ZuFwd<Index_>(index));
+  }
+  template <int Direction = ZmRBTreeGreaterEqual>
+  inline auto readIterator() const {
+    return ReadIterator<Direction>(*this);
+  }
+  template <int Direction, typename Index_>
+  inline auto readIterator(Index_ &&index) const {
+    return ReadIterator<Direction>(*this, ZuFwd<Index_>(index));
+  }
+
+// clean tree
+
+  void clean() {
+    Guard guard(m_lock);
+    for (Leaf *leaf = m_head; leaf; leaf = next(leaf))
+      for (unsigned i = 0, n = leaf->n; i < n; i++) {
+	Node *node = leaf->node[i];
+	nodeDeref(node);
+	nodeDelete(node);
+      }
+    if (m_root) freeBlock(m_root, m_height);
+    m_root = nullptr;
+    m_head = m_tail = nullptr;
+    m_height = 0;
+    m_count = 0;
+  }
+
+protected:
+  ZuInline Node *minimum_() const {
+    return ZuLikely(m_head) ? m_head->node[0] : nullptr;
+  }
+  ZuInline Node *maximum_() const {
+    return ZuLikely(m_tail) ? m_tail->node[m_tail->n - 1] : nullptr;
+  }
+
+  // binary search within a block - first element >= index
+  template <typename Index_>
+  ZuInline static unsigned lowerBound_(
+      const I *index, unsigned n, const Index_ &i) {
+    unsigned lo = 0;
+    while (n) {
+      unsigned half = n>>1;
+      if (S::cmp(index[lo + half], i) < 0)
+	lo += half + 1, n -= half + 1;
+      else
+	n = half;
+    }
+    return lo;
+  }
+  // binary search within a block - first element > index
+  template <typename Index_>
+  ZuInline static unsigned upperBound_(
+      const I *index, unsigned n, const Index_ &i) {
+    unsigned lo = 0;
+    while (n) {
+      unsigned half = n>>1;
+      if (S::cmp(index[lo + half], i) <= 0)
+	lo += half + 1, n -= half + 1;
+      else
+	n = half;
+    }
+    return lo;
+  }
+
+  // branch separators: all indices in child[j] <= index[j] <= all indices
+  // in child[j + 1]; duplicates can therefore straddle a separator
+
+  template <typename Index_>
+  inline Leaf *lowerLeaf(const Index_ &i) const {
+    Block *block = m_root;
+    for (unsigned h = m_height; h; --h) {
+      Branch *branch = static_cast<Branch *>(block);
+      block = branch->child[lowerBound_(branch->index, branch->n - 1, i)];
+    }
+    return static_cast<Leaf *>(block);
+  }
+  template <typename Index_>
+  inline Leaf *upperLeaf(const Index_ &i) const {
+    Block *block = m_root;
+    for (unsigned h = m_height; h; --h) {
+      Branch *branch = static_cast<Branch *>(block);
+      block = branch->child[upperBound_(branch->index, branch->n - 1, i)];
+    }
+    return static_cast<Leaf *>(block);
+  }
+
+  // position of first element >= index, false if none
+  template <typename Index_>
+  inline bool lowerBound(const Index_ &i, Leaf *&leaf, unsigned &pos) const {
+    if (ZuUnlikely(!m_root)) return false;
+    leaf = lowerLeaf(i);
+    pos = lowerBound_(leaf->index, leaf->n, i);
+    return normalize(leaf, pos);
+  }
+  // position of first element > index, false if none
+  template <typename Index_>
+  inline bool upperBound(const Index_ &i, Leaf *&leaf, unsigned &pos) const {
+    if (ZuUnlikely(!m_root)) return false;
+    leaf = upperLeaf(i);
+    pos = upperBound_(leaf->index, leaf->n, i);
+    return normalize(leaf, pos);
+  }
+
+  ZuInline static bool normalize(Leaf *&leaf, unsigned &pos) {
+    if (ZuLikely(pos < leaf->n)) return true;
+    if (!(leaf = next(leaf))) return false;
+    pos = 0;
+    return true;
+  }
+  ZuInline static bool step(Leaf *&leaf, unsigned &pos) {
+    ++pos;
+    return normalize(leaf, pos);
+  }
+  ZuInline static bool stepBack(Leaf *&leaf, unsigned &pos) {
+    if (ZuLikely(pos)) { --pos; return true; }
+    if (!(leaf = prev(leaf))) return false;
+    pos = leaf->n - 1;
+    return true;
+  }
+
+  template <typename Index_>
+  inline Node *find_(const Index_ &index) const {
+    Leaf *leaf;
+    unsigned pos;
+    if (!lowerBound(index, leaf, pos) ||
+	S::cmp(leaf->index[pos], index)) return nullptr;
+    return leaf->node[pos];
+  }
+  template <typename Index_>
+  inline bool find_(
+      const Index_ &index, int compare, Leaf *&leaf, unsigned &pos) const {
+    switch (compare) {
+      case ZmRBTreeEqual:
+	return lowerBound(index, leaf, pos) &&
+	  !S::cmp(leaf->index[pos], index);
+      case ZmRBTreeGreaterEqual:
+	return lowerBound(index, leaf, pos);
+      case ZmRBTreeGreater:
+	return upperBound(index, leaf, pos);
+      case ZmRBTreeLessEqual:
+	if (!upperBound(index, leaf, pos)) return last(leaf, pos);
+	return stepBack(leaf, pos);
+      case ZmRBTreeLess:
+	if (!lowerBound(index, leaf, pos)) return last(leaf, pos);
+	return stepBack(leaf, pos);
+    }
+    return false;
+  }
+  ZuInline bool first(Leaf *&leaf, unsigned &pos) const {
+    pos = 0;
+    return (leaf = m_head) != nullptr;
+  }
+  ZuInline bool last(Leaf *&leaf, unsigned &pos) const {
+    if (!(leaf = m_tail)) return false;
+    pos = leaf->n - 1;
+    return true;
+  }
+
+  // locate a specific node amongst any duplicates
+  inline bool findNode(Node *node, Leaf *&leaf, unsigned &pos) const {
+    const I &index = S::value(node->Node::key());
+    if (!lowerBound(index, leaf, pos)) return false;
+    while (!S::cmp_(leaf->index[pos], index)) {
+      if (leaf->node[pos] == node) return true;
+      if (!step(leaf, pos)) break;
+    }
+    return false;
+  }
+
+  ZuInline static unsigned childPos(const Branch *branch, const Block *child) {
+    unsigned j = 0;
+    while (branch->child[j] != child) ++j;
+    return j;
+  }
+
+  void add_(Node *node) {
+    I index = S::value(node->Node::key());
+    ++m_count;
+    if (ZuUnlikely(!m_root)) {
+      Leaf *leaf = new Leaf();
+      leaf->index[0] = ZuMv(index);
+      leaf->node[0] = node;
+      leaf->n = 1;
+      m_root = m_head = m_tail = leaf;
+      return;
+    }
+    // duplicates are added after any existing equal elements
+    Leaf *leaf = upperLeaf(index);
+    unsigned pos = upperBound_(leaf->index, leaf->n, index);
+    if (ZuLikely(leaf->n < LeafSize)) {
+      insert(leaf, pos, ZuMv(index), node);
+      return;
+    }
+    // split leaf, moving the upper half to a new right sibling
+    Leaf *right = new Leaf();
+    unsigned h = LeafSize>>1;
+    for (unsigned i = h; i < LeafSize; i++) {
+      right->index[i - h] = ZuMv(leaf->index[i]);
+      right->node[i - h] = leaf->node[i];
+    }
+    right->n = LeafSize - h;
+    leaf->n = h;
+    if (Leaf *next_ = next(leaf))
+      next_->prev = right;
+    else
+      m_tail = right;
+    right->next = leaf->next;
+    right->prev = leaf;
+    leaf->next = right;
+    if (pos <= h)
+      insert(leaf, pos, ZuMv(index), node);
+    else
+      insert(right, pos - h, ZuMv(index), node);
+    addChild(leaf, right->index[0], right);
+  }
+  ZuInline static void insert(Leaf *leaf, unsigned pos, I index, Node *node) {
+    for (unsigned i = leaf->n; i > pos; --i) {
+      leaf->index[i] = ZuMv(leaf->index[i - 1]);
+      leaf->node[i] = leaf->node[i - 1];
+    }
+    leaf->index[pos] = ZuMv(index);
+    leaf->node[pos] = node;
+    ++leaf->n;
+  }
+
+  // add right as the sibling following left, separated by index
+  void addChild(Block *left, const I &index, Block *right) {
+    Branch *branch = left->parent;
+    if (!branch) {
+      branch = new Branch();
+      branch->index[0] = index;
+      branch->child[0] = left;
+      branch->child[1] = right;
+      branch->n = 2;
+      left->parent = right->parent = branch;
+      m_root = branch;
+      ++m_height;
+      return;
+    }
+    unsigned j = childPos(branch, left) + 1;
+    if (ZuLikely(branch->n < BranchSize)) {
+      for (unsigned i = branch->n; i > j; --i) {
+	branch->index[i - 1] = ZuMv(branch->index[i - 2]);
+	branch->child[i] = branch->child[i - 1];
+      }
+      branch->index[j - 1] = index;
+      branch->child[j] = right;
+      right->parent = branch;
+      ++branch->n;
+      return;
+    }
+    // split branch - merge the new separator and child into temporaries,
+    // then promote the middle separator to the parent
+    I index_[BranchSize];
+    Block *child_[BranchSize + 1];
+    for (unsigned i = 0, k = 0; i <= BranchSize; i++) {
+      if (i == j) {
+	child_[i] = right;
+	index_[i - 1] = index;
+	continue;
+      }
+      child_[i] = branch->child[k];
+      if (i) index_[i - 1] = ZuMv(branch->index[k - 1]);
+      ++k;
+    }
+    Branch *sibling = new Branch();
+    unsigned h = (BranchSize + 1)>>1;
+    for (unsigned i = 0; i < h; i++) {
+      branch->child[i] = child_[i];
+      if (i) branch->index[i - 1] = ZuMv(index_[i - 1]);
+    }
+    for (unsigned i = h - 1; i < BranchSize - 1; i++) branch->index[i] = I();
+    branch->n = h;
+    for (unsigned i = h; i <= BranchSize; i++) {
+      Block *child = sibling->child[i - h] = child_[i];
+      child->parent = sibling;
+      if (i > h) sibling->index[i - h - 1] = ZuMv(index_[i - 1]);
+    }
+    sibling->n = BranchSize + 1 - h;
+    right->parent = (j < h) ? branch : sibling;
+    addChild(branch, index_[h - 1], sibling);
+  }
+
+  // delete element at position, returning the position of its successor
+  // (i.e. the element that followed it)
+  bool delPos(Leaf *&leaf, unsigned &pos) {
+    {
+      unsigned n = leaf->n - 1;
+      for (unsigned i = pos; i < n; i++) {
+	leaf->index[i] = ZuMv(leaf->index[i + 1]);
+	leaf->node[i] = leaf->node[i + 1];
+      }
+      leaf->index[n] = I();	// release any reference held by the index
+      leaf->n = n;
+    }
+    --m_count;
+    Branch *branch = leaf->parent;
+    if (!branch) {
+      if (!leaf->n) {
+	delete leaf;
+	m_root = nullptr;
+	m_head = m_tail = nullptr;
+	return false;
+      }
+      return normalize(leaf, pos);
+    }
+    if (ZuLikely(leaf->n >= MinLeaf)) return normalize(leaf, pos);
+    unsigned j = childPos(branch, leaf);
+    Leaf *right = j + 1 < branch->n ?
+      static_cast<Leaf *>(branch->child[j + 1]) : nullptr;
+    Leaf *left = j ? static_cast<Leaf *>(branch->child[j - 1]) : nullptr;
+    // borrow from right sibling
+    if (right && right->n > MinLeaf) {
+      leaf->index[leaf->n] = ZuMv(right->index[0]);
+      leaf->node[leaf->n] = right->node[0];
+      ++leaf->n;
+      unsigned n = right->n - 1;
+      for (unsigned i = 0; i < n; i++) {
+	right->index[i] = ZuMv(right->index[i + 1]);
+	right->node[i] = right->node[i + 1];
+      }
+      right->index[n] = I();
+      right->n = n;
+      branch->index[j] = right->index[0];
+      return normalize(leaf, pos);
+    }
+    // borrow from left sibling
+    if (left && left->n > MinLeaf) {
+      for (unsigned i = leaf->n; i > 0; --i) {
+	leaf->index[i] = ZuMv(leaf->index[i - 1]);
+	leaf->node[i] = leaf->node[i - 1];
+      }
+      unsigned n = left->n - 1;
+      leaf->index[0] = ZuMv(left->index[n]);
+      leaf->node[0] = left->node[n];
+      left->index[n] = I();
+      left->n = n;
+      ++leaf->n;
+      branch->index[j - 1] = leaf->index[0];
+      ++pos;
+      return normalize(leaf, pos);
+    }
+    // merge with right sibling
+    if (right) {
+      mergeLeaf(leaf, right);
+      delChild(branch, j + 1);
+      return normalize(leaf, pos);
+    }
+    // merge into left sibling
+    pos += left->n;
+    mergeLeaf(left, leaf);
+    delChild(branch, j);
+    leaf = left;
+    return normalize(leaf, pos);
+  }
+  // append right to left, then free right
+  void mergeLeaf(Leaf *left, Leaf *right) {
+    unsigned n = left->n;
+    for (unsigned i = 0; i < right->n; i++) {
+      left->index[n + i] = ZuMv(right->index[i]);
+      left->node[n + i] = right->node[i];
+    }
+    left->n = n + right->n;
+    if (Leaf *next_ = next(right))
+      next_->prev = left;
+    else
+      m_tail = left;
+    left->next = right->next;
+    delete right;
+  }
+
+  // remove child j (and the separator preceding it) from branch
+  void delChild(Branch *branch, unsigned j) {
+    unsigned n = branch->n - 1;
+    for (unsigned i = j; i < n; i++) {
+      branch->index[i - 1] = ZuMv(branch->index[i]);
+      branch->child[i] = branch->child[i + 1];
+    }
+    branch->index[n - 1] = I();
+    branch->n = n;
+    if (!branch->parent) {
+      if (n == 1) {
+	(m_root = branch->child[0])->parent = nullptr;
+	--m_height;
+	delete branch;
+      }
+      return;
+    }
+    if (ZuLikely(n >= MinBranch)) return;
+    Branch *parent = branch->parent;
+    j = childPos(parent, branch);
+    Branch *right = j + 1 < parent->n ?
+      static_cast<Branch *>(parent->child[j + 1]) : nullptr;
+    Branch *left = j ? static_cast<Branch *>(parent->child[j - 1]) : nullptr;
+    // borrow from right sibling, rotating through the parent
+    if (right && right->n > MinBranch) {
+      branch->index[n - 1] = ZuMv(parent->index[j]);
+      (branch->child[n] = right->child[0])->parent = branch;
+      branch->n = n + 1;
+      parent->index[j] = ZuMv(right->index[0]);
+      unsigned m = right->n - 1;
+      for (unsigned i = 0; i < m; i++) {
+	if (i) right->index[i - 1] = ZuMv(right->index[i]);
+	right->child[i] = right->child[i + 1];
+      }
+      right->index[m - 1] = I();
+      right->n = m;
+      return;
+    }
+    // borrow from left sibling, rotating through the parent
+    if (left && left->n > MinBranch) {
+      for (unsigned i = n; i > 0; --i) {
+	if (i > 1) branch->index[i - 1] = ZuMv(branch->index[i - 2]);
+	branch->child[i] = branch->child[i - 1];
+      }
+      unsigned m = left->n - 1;
+      branch->index[0] = ZuMv(parent->index[j - 1]);
+      (branch->child[0] = left->child[m])->parent = branch;
+      branch->n = n + 1;
+      parent->index[j - 1] = ZuMv(left->index[m - 1]);
+      left->index[m - 1] = I();
+      left->n = m;
+      return;
+    }
+    // merge with a sibling
+    if (right) {
+      mergeBranch(branch, parent->index[j], right);
+      delChild(parent, j + 1);
+    } else {
+      mergeBranch(left, parent->index[j - 1], branch);
+      delChild(parent, j);
+    }
+  }
+  // append separator and right to left, then free right
+  void mergeBranch(Branch *left, const I &index, Branch *right) {
+    unsigned n = left->n;
+    left->index[n - 1] = index;
+    for (unsigned i = 0; i < right->n; i++) {
+      if (i) left->index[n + i - 1] = ZuMv(right->index[i - 1]);
+      (left->child[n + i] = right->child[i])->parent = left;
+    }
+    left->n = n + right->n;
+    delete right;
+  }
+
+  void freeBlock(Block *block, unsigned height) {
+    if (!height) {
+      delete static_cast<Leaf *>(block);
+      return;
+    }
+    Branch *branch = static_cast<Branch *>(block);
+    for (unsigned i = 0; i < branch->n; i++)
+      freeBlock(branch->child[i], height - 1);
+    delete branch;
+  }
+
+// iterator functions
+
+  template <int Direction>
+  using Iterator_ = ZmBTreeIterator_<ZmBTree, Direction>;
+
+  template <int Direction>
+  inline typename ZuIfT<(Direction >= 0)>::T startIterate(
+      Iterator_<Direction> &iterator) {
+    if (!first(iterator.m_leaf, iterator.m_pos)) iterator.m_leaf = nullptr;
+    iterator.m_lastLeaf = nullptr;
+  }
+  template <int Direction>
+  inline typename ZuIfT<(Direction < 0)>::T startIterate(
+      Iterator_<Direction> &iterator) {
+    if (!last(iterator.m_leaf, iterator.m_pos)) iterator.m_leaf = nullptr;
+    iterator.m_lastLeaf = nullptr;
+  }
+  template <int Direction, typename Index_>
+  inline void startIterate(
+      Iterator_<Direction> &iterator, const Index_ &index, int compare) {
+    if (!find_(index, compare, iterator.m_leaf, iterator.m_pos))
+      iterator.m_leaf = nullptr;
+    iterator.m_lastLeaf = nullptr;
+  }
+
+  template <int Direction>
+  inline typename ZuIfT<(Direction > 0), Node *>::T iterate(
+      Iterator_<Direction> &iterator) {
+    Leaf *leaf = iterator.m_leaf;
+    if (!leaf) return nullptr;
+    unsigned pos = iterator.m_pos;
+    iterator.m_lastLeaf = leaf;
+    iterator.m_lastPos = pos;
+    if (!step(iterator.m_leaf, iterator.m_pos)) iterator.m_leaf = nullptr;
+    return leaf->node[pos];
+  }
+  template <int Direction>
+  inline typename ZuIfT<(!Direction), Node *>::T iterate(
+      Iterator_<Direction> &iterator) {
+    Leaf *leaf = iterator.m_leaf;
+    if (!leaf) return nullptr;
+    unsigned pos = iterator.m_pos;
+    iterator.m_lastLeaf = leaf;
+    iterator.m_lastPos = pos;
+    if (!step(iterator.m_leaf, iterator.m_pos) ||
+	S::cmp_(iterator.m_leaf->index[iterator.m_pos], leaf->index[pos]))
+      iterator.m_leaf = nullptr;
+    return leaf->node[pos];
+  }
+  template <int Direction>
+  inline typename ZuIfT<(Direction < 0), Node *>::T iterate(
+      Iterator_<Direction> &iterator) {
+    Leaf *leaf = iterator.m_leaf;
+    if (!leaf) return nullptr;
+    unsigned pos = iterator.m_pos;
+    iterator.m_lastLeaf = leaf;
+    iterator.m_lastPos = pos;
+    if (!stepBack(iterator.m_leaf, iterator.m_pos)) iterator.m_leaf = nullptr;
+    return leaf->node[pos];
+  }
+
+  // deleting the last node returned relocates the iterator's next
+  // position, since elements may shift between blocks
+  template <int Direction>
+  void delIterate(Iterator_<Direction> &iterator) {
+    Leaf *leaf = iterator.m_lastLeaf;
+    if (!leaf) return;
+    iterator.m_lastLeaf = nullptr;
+    unsigned pos = iterator.m_lastPos;
+    Node *node = leaf->node[pos];
+    bool end = !iterator.m_leaf;
+    bool found = delPos(leaf, pos);
+    if (!end) {
+      if (Direction < 0) {
+	if (!found) found = last(leaf, pos);
+	else found = stepBack(leaf, pos);
+      }
+      if (found) {
+	iterator.m_leaf = leaf;
+	iterator.m_pos = pos;
+      } else
+	iterator.m_leaf = nullptr;
+    }
+    nodeDeref(node);
+    nodeDelete(node);
+  }
+
+  mutable Lock	m_lock;
+    Block	  *m_root = nullptr;
+    Leaf	  *m_head = nullptr;
+    Leaf	  *m_tail = nullptr;
+    unsigned	  m_height = 0;
+    unsigned	  m_count = 0;
+};
+
+#endif /* ZmBTree_HPP */
@@ -19,6 +19,13 @@
 
 // stack backtrace
 
+// capture only records raw frame addresses - symbolization is performed
+// when printing, and cached by frame address so that each frame is only
+// resolved once; newly captured frames that are not yet in the cache are
+// queued to a low-priority background thread that resolves them in
+// advance, so that printing (e.g. logging, ZmObject_Debug dumps) rarely
+// needs to resolve frames itself
+
 #include <zlib/ZmBackTrace.hpp>
 
 #include <stdio.h>
@@ -27,8 +34,11 @@
 
 #include <zlib/ZmCleanup.hpp>
 #include <zlib/ZmSingleton.hpp>
+#include <zlib/ZmAtomic.hpp>
 #include <zlib/ZmPLock.hpp>
 #include <zlib/ZmGuard.hpp>
+#include <zlib/ZmSemaphore.hpp>
+#include <zlib/ZmThread.hpp>
 
 #ifdef linux
 #include <execinfo.h>
@@ -133,10 +143,13 @@ template <> struct ZmCleanup<ZmBackTrace_Mgr> {
 
 struct ZmBackTrace_MgrInit;
 
+class ZmBackTrace_Resolver;
+
 class ZmBackTrace_Mgr {
 friend struct ZmSingletonCtor<ZmBackTrace_Mgr>;
 friend class ZmBackTrace;
 friend struct ZmBackTrace_MgrInit;
+friend class ZmBackTrace_Resolver;
 friend void ZmBackTrace_print(ZmStream &s, const ZmBackTrace &bt);
 
   ZmBackTrace_Mgr();
@@ -351,9 +364,35 @@ notfound:
   void printFrame(ZmStream &s, void *addr);
   bool printFrame_(ZmStream &s, void *addr);
 
+  // frame address -> printed frame cache; insert-only, lock-free lookup
+  struct Symbol {
+    Symbol		*next;
+    void		*addr;
+    unsigned		length;
+    char		data[1];
+  };
+  enum { CacheBits = 12 };
+
+  ZuInline static unsigned slot(void *addr) {
+    return ((uint64_t)(uintptr_t)addr * 0x9e3779b97f4a7c15ULL)>>
+      (64 - CacheBits);
+  }
+  ZuInline Symbol *lookup(void *addr) const {
+    for (Symbol *symbol = m_cache[slot(addr)]; symbol; symbol = symbol->next)
+      if (symbol->addr == addr) return symbol;
+    return nullptr;
+  }
+  Symbol *resolve(void *addr);		// must be called with m_lock held
+  void resolve(void *const *frames);	// called by background thread
+  void prefetch(void *const *frames);	// called by capture(skip)
+
   Lock				m_lock;
   bool				m_initialized;
 
+  ZmAtomic<uint32_t>		m_prefetch;	// background thread running
+  ZmAtomic<Symbol *>		m_cache[1<<CacheBits];
+  ZuStringN<ZmBackTrace_BUFSIZ>	m_symbolBuf;
+
 #ifdef _WIN32
   HMODULE			m_dll;
   HMODULE			m_ntdll;
@@ -383,6 +422,81 @@ ZmBackTrace_Mgr *ZmBackTrace_Mgr::instance()
   return ZmSingleton<ZmBackTrace_Mgr>::instance();
 }
 
+// background symbolization thread - stopped before thread cleanup
+class ZmBackTrace_Resolver;
+
+template <> struct ZmCleanup<ZmBackTrace_Resolver> {
+  enum { Level = ZmCleanupLevel::Library };
+};
+
+class ZmBackTrace_Resolver {
+friend struct ZmSingletonCtor<ZmBackTrace_Resolver>;
+
+  enum { QueueSize = 64 };		// must be a power of 2
+
+  typedef ZmPLock Lock;
+  typedef ZmGuard<Lock> Guard;
+
+  ZmBackTrace_Resolver() {
+    m_thread = ZmThread(0,
+	ZmFn<>::Member<&ZmBackTrace_Resolver::work>::fn(this),
+	ZmThreadParams().name("backtrace").priority(ZmThreadPriority::Low));
+    m_started.wait();
+  }
+
+public:
+  ~ZmBackTrace_Resolver() {
+    ZmBackTrace_Mgr::instance()->m_prefetch = 0;
+    {
+      Guard guard(m_lock);
+      m_stop = true;
+    }
+    m_work.post();
+    m_thread.join();
+  }
+
+  static ZmBackTrace_Resolver *instance() {
+    return ZmSingleton<ZmBackTrace_Resolver>::instance();
+  }
+
+  // traces are discarded if the queue is full - printing will resolve them
+  void enqueue(void *const *frames) {
+    {
+      Guard guard(m_lock);
+      if (m_tail - m_head >= QueueSize) return;
+      memcpy(m_queue[(m_tail++) & (QueueSize - 1)],
+	  frames, sizeof(void *) * ZmBackTrace_DEPTH);
+    }
+    m_work.post();
+  }
+
+private:
+  void work() {
+    m_started.post();
+    void *frames[ZmBackTrace_DEPTH];
+    for (;;) {
+      m_work.wait();
+      {
+	Guard guard(m_lock);
+	if (m_stop) return;
+	if (m_head == m_tail) continue;
+	memcpy(frames, m_queue[(m_head++) & (QueueSize - 1)],
+	    sizeof(void *) * ZmBackTrace_DEPTH);
+      }
+      ZmBackTrace_Mgr::instance()->resolve(frames);
+    }
+  }
+
+  Lock			m_lock;
+    unsigned		  m_head = 0;
+    unsigned		  m_tail = 0;
+    bool		  m_stop = false;
+    void		  *m_queue[QueueSize][ZmBackTrace_DEPTH];
+  ZmSemaphore		m_work;
+  ZmSemaphore		m_started;
+  ZmThread		m_thread;
+};
+
 struct ZmBackTrace_MgrInit {
   ZmBackTrace_MgrInit() {
     //printf("ZmBackTrace_Mgr::instance() = %p\n", ZmBackTrace_Mgr::instance()); fflush(stdout);
@@ -393,7 +507,8 @@ struct ZmBackTrace_MgrInit {
 static ZmBackTrace_MgrInit ZmBackTrace_mgrInit;
 
 ZmBackTrace_Mgr::ZmBackTrace_Mgr() :
-  m_initialized(false)
+  m_initialized(false),
+  m_prefetch(1)
 #ifdef _WIN32
   , m_dll(0),
   m_ntdll(0),
@@ -432,6 +547,13 @@ ZmBackTrace_Mgr::~ZmBackTrace_Mgr()
     if (m_demangleBuf) free(m_demangleBuf);
 #endif
   }
+  for (unsigned i = 0; i < (1U<<CacheBits); i++) {
+    Symbol *symbol = m_cache[i].load_();
+    while (Symbol *next = symbol) {
+      symbol = next->next;
+      ::free(next);
+    }
+  }
 }
 
 void ZmBackTrace_Mgr::init()
@@ -476,6 +598,14 @@ void ZmBackTrace_Mgr::init()
   bfd_init();
 #endif
 
+#if !defined(_WIN32) && defined(__GNUC__)
+  {
+    // the first call to ::backtrace() loads the unwinder - do it now
+    void *frames[1];
+    ::backtrace(frames, 1);
+  }
+#endif
+
   m_initialized = true;
   return;
 
@@ -499,6 +629,13 @@ error:
 }
 
 void ZmBackTrace::capture(unsigned skip)
+{
+  ZmBackTrace_Mgr *mgr = ZmBackTrace_Mgr::instance();
+  mgr->capture(++skip, (void **)m_frames);
+  mgr->prefetch(m_frames);
+}
+
+void ZmBackTrace::captureSignal(unsigned skip)
 {
   ZmBackTrace_Mgr::instance()->capture(++skip, (void **)m_frames);
 }
@@ -510,10 +647,9 @@ void ZmBackTrace::capture(EXCEPTION_POINTERS *exInfo, unsigned skip)
 }
 #endif /* _WIN32 */
 
+// ::backtrace() and RtlCaptureStackBackTrace() are thread-safe
 void ZmBackTrace_Mgr::capture(unsigned skip, void **frames)
 {
-  Guard guard(m_lock);
-
   int n = 0; // signed since ::backtrace() might return -ve
 
   ++skip;
@@ -643,8 +779,57 @@ ZmExtern void ZmBackTrace_print(ZmStream &s, const ZmBackTrace &bt)
 
 void ZmBackTrace_Mgr::print(ZmStream &s, void *const *frames)
 {
-  Guard guard(m_lock);
+  for (int depth = 0; depth < ZmBackTrace_DEPTH && frames[depth]; depth++) {
+    void *addr = frames[depth];
+    Symbol *symbol = lookup(addr);
+    if (ZuUnlikely(!symbol)) {
+      Guard guard(m_lock);
+      symbol = resolve(addr);
+    }
+    s << ZuString(symbol->data, symbol->length);
+  }
+}
+
+ZmBackTrace_Mgr::Symbol *ZmBackTrace_Mgr::resolve(void *addr)
+{
+  unsigned slot = this->slot(addr);
+  Symbol *head = m_cache[slot].load_();
+  for (Symbol *symbol = head; symbol; symbol = symbol->next)
+    if (symbol->addr == addr) return symbol;
+  m_symbolBuf.null();
+  {
+    ZmStream s(m_symbolBuf);
+    printFrame(s, addr);
+  }
+  unsigned length = m_symbolBuf.length();
+  Symbol *symbol = (Symbol *)::malloc(sizeof(Symbol) + length);
+  symbol->next = head;
+  symbol->addr = addr;
+  symbol->length = length;
+  memcpy(symbol->data, m_symbolBuf.data(), length);
+  m_cache[slot] = symbol; // release
+  return symbol;
+}
 
+void ZmBackTrace_Mgr::resolve(void *const *frames)
+{
   for (int depth = 0; depth < ZmBackTrace_DEPTH && frames[depth]; depth++)
-    printFrame(s, frames[depth]);
+    if (!lookup(frames[depth])) {
+      Guard guard(m_lock);
+      resolve(frames[depth]);
+    }
+}
+
+void ZmBackTrace_Mgr::prefetch(void *const *frames)
+{
+  // prevent re-entrance while the background thread is being started
+  thread_local bool prefetching = false;
+  if (prefetching || !m_prefetch.load_()) return;
+  for (int depth = 0; depth < ZmBackTrace_DEPTH && frames[depth]; depth++)
+    if (!lookup(frames[depth])) {
+      prefetching = true;
+      ZmBackTrace_Resolver::instance()->enqueue(frames);
+      prefetching = false;
+      return;
+    }
 }
@@ -65,8 +65,11 @@ public:
 
   void capture() { capture(0); }
   void capture(unsigned skip);
+  // signal / exception handlers - frames are not queued for background
+  // symbolization, which could start a thread or block on a lock
+  void captureSignal(unsigned skip);
 #ifdef _WIN32
-  void capture(EXCEPTION_POINTERS *exInfo, unsigned skip);
+  void capture(EXCEPTION_POINTERS *exInfo, unsigned skip); // no prefetch
 #endif
 
   ZuInline void *const *frames() const { return m_frames; }
@@ -82,6 +82,8 @@ public:
 
   enum { Size = ZmBxRingAlign(sizeof(T)) };
 
+  enum { Prefetch = 8 }; // cache lines prefetched by shiftN()
+
   template <typename ...Args>
   inline ZmBxRing(ZmRingParams params = ZmRingParams(0), Args &&... args) :
       NTP::Base{ZuFwd<Args>(args)...},
@@ -189,8 +191,10 @@ public:
     m_id = -1;
     m_ctrl = ring.m_ctrl;
     m_data = ring.m_data;
+    m_size = ring.m_size;
     m_tail = 0;
     m_full = 0;
+    ++rdrCount();
     return OK;
   }
 
@@ -386,12 +390,7 @@ public:
 	tail += Size;
 	if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
 	if (*(ZmAtomic<uint64_t> *)ptr &= ~(1ULL<<m_id)) continue;
-
-	if (ZuUnlikely(!m_params.ll())) {
-	  if (ZuUnlikely(this->tail().xch(tail) & Waiting))
-	    this->ZmRing_wake(Tail, this->tail(), 1);
-	} else
-	  this->tail() = tail; // release
+	release(tail);
       }
       head_ = head;
       head = this->head() & ~Mask; // acquire
@@ -437,16 +436,104 @@ public:
     if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
     m_tail = tail;
     if (*(ZmAtomic<uint64_t> *)ptr &= ~(1ULL<<m_id)) return;
-    if (ZuUnlikely(!m_params.ll())) {
-      if (ZuUnlikely(this->tail().xch(tail) & Waiting))
-	this->ZmRing_wake(Tail, this->tail(), 1);
-    } else
-      this->tail() = tail; // release
+    release(tail);
 
     this->outCount().store_(this->outCount().load_() + 1);
     this->outBytes().store_(this->outBytes().load_() + Size);
   }
 
+  // batched shift - returns a span of n ready messages (1 <= n <= max),
+  // contiguous in memory, i.e. the i'th message is at
+  // (uint8_t *)ptr + i * Size; the span does not wrap; shift2N(n) then
+  // releases the span, publishing the shared tail at most once
+  inline T *shiftN(unsigned max, unsigned &n) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+    ZmAssert(m_id >= 0);
+    ZmAssert(max);
+
+    uint32_t tail = m_tail;
+    uint32_t head;
+  retry:
+    head = this->head(); // acquire
+    if (tail == (head & ~Mask)) {
+      if (ZuUnlikely(head & EndOfFile_)) return 0;
+      if (ZuUnlikely(!m_params.ll()))
+	if (this->ZmRing_wait(Head, this->head(), head) != OK) return 0;
+      goto retry;
+    }
+
+    head &= ~Mask;
+    unsigned avail;
+    if ((head ^ tail) == Wrapped)
+      avail = size();
+    else if ((head & ~Wrapped) > (tail & ~Wrapped))
+      avail = (head & ~Wrapped) - (tail & ~Wrapped);
+    else
+      avail = size() - ((tail & ~Wrapped) - (head & ~Wrapped));
+    {
+      unsigned end = size() - (tail & ~Wrapped);
+      if (avail > end) avail = end;
+    }
+    avail /= Size;
+    if (max > avail) max = avail;
+    n = max;
+
+    uint8_t *ptr = &((uint8_t *)data())[tail & ~Wrapped];
+    {
+      unsigned end = n * Size;
+      if (end > (unsigned)Prefetch * CacheLineSize)
+	end = (unsigned)Prefetch * CacheLineSize;
+      for (unsigned i = CacheLineSize; i < end; i += CacheLineSize)
+	ZuPrefetchW(ptr + i);
+    }
+    return (T *)&ptr[8];
+  }
+  inline void shift2N(unsigned n) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+    ZmAssert(m_id >= 0);
+
+    uint32_t tail = m_tail, last = 0;
+    unsigned count = 0;
+    for (unsigned i = 0; i < n; i++) {
+      uint8_t *ptr = &((uint8_t *)data())[tail & ~Wrapped];
+      tail += Size;
+      if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
+      if (!(*(ZmAtomic<uint64_t> *)ptr &= ~(1ULL<<m_id))) last = tail, ++count;
+    }
+    m_tail = tail;
+    if (!count) return;
+    release(last);
+
+    this->outCount().store_(this->outCount().load_() + count);
+    this->outBytes().store_(this->outBytes().load_() + count * Size);
+  }
+
+private:
+  // the last reader to consume a message advances the shared tail; since
+  // multiple readers can concurrently be last to consume successive
+  // messages, the tail is only ever moved forwards
+  inline void release(uint32_t tail) {
+    uint32_t prev = this->tail().load_();
+    for (;;) {
+      {
+	uint32_t size = this->size();
+	uint32_t old = prev & ~Mask;
+	uint32_t d = ((tail & ~Wrapped) + ((tail & Wrapped) ? size : 0)) -
+	  ((old & ~Wrapped) + ((old & Wrapped) ? size : 0));
+	if ((int32_t)d < 0) d += size<<1;
+	if (!d || d > size) return; // already advanced past tail
+      }
+      uint32_t prev_ = this->tail().cmpXch(tail, prev);
+      if (prev_ == prev) break;
+      prev = prev_;
+    }
+    if (ZuUnlikely(!m_params.ll()) && ZuUnlikely(prev & Waiting))
+      this->ZmRing_wake(Tail, this->tail(), 1);
+  }
+
+public:
   // can be called by readers after shift() returns 0; returns
   // EndOfFile (< 0), or amount of data remaining in ring buffer (>= 0)
   int readStatus() const {
@@ -0,0 +1,223 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// concurrent queue with fast indexed on-queue find and delete
+
+// multiple producers, single consumer; push() is a lock-free MPSC enqueue
+// (an exchange on the tail of an intrusive linked list); the queue is
+// indexed by key using a lock-striped ZmHash, so that find() and del()
+// are O(1) and only contend with operations on keys in the same stripe;
+// del() does not unlink the item from the queue, it marks it deleted and
+// the consumer discards it when it reaches the head; shift() must only
+// be called from the consumer thread
+//
+// unlike ZmQueue there are no sequence IDs or iteration; keys are
+// expected to be unique - pushing a key that is already queued deletes
+// the previous item, but concurrent pushes of the same key may leave
+// both queued
+
+#ifndef ZmCQueue_HPP
+#define ZmCQueue_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmObject.hpp>
+#include <zlib/ZmRef.hpp>
+#include <zlib/ZmHeap.hpp>
+#include <zlib/ZmPLock.hpp>
+#include <zlib/ZmHash.hpp>
+#include <zlib/ZmQueue.hpp>
+
+// NTP (named template parameters) - as for ZmQueue, except that ZmQueueID
+// is not used and ZmQueueLock specifies the index (hash table) lock
+//
+// ZmCQueue<ZtString,				// keys are ZtStrings
+//   ZmQueueCmp<ZtICmp> >			// case-insensitive comparison
+
+// NTP defaults
+struct ZmCQueue_Defaults : public ZmQueue_Defaults {
+  typedef ZmPLock Lock;
+  struct HeapID { inline static const char *id() { return "ZmCQueue"; } };
+};
+
+template <typename Key, class NTP = ZmCQueue_Defaults>
+class ZmCQueue : public NTP::Base {
+  ZmCQueue(const ZmCQueue &);
+  ZmCQueue &operator =(const ZmCQueue &);	// prevent mis-use
+
+public:
+  typedef typename NTP::template CmpT<Key>::Cmp Cmp;
+  typedef typename NTP::template ICmpT<Key>::ICmp ICmp;
+  typedef typename NTP::template HashFnT<Key>::HashFn HashFn;
+  typedef typename NTP::template IHashFnT<Key>::IHashFn IHashFn;
+  typedef typename NTP::template IndexT<Key>::Index Index;
+  typedef typename NTP::Lock Lock;
+  typedef typename NTP::HeapID HeapID;
+
+private:
+  enum { Queued = 0, Shifted, Deleted };	// item state
+
+  struct Link {
+    ZmAtomic<Link *>	next;
+  };
+
+  template <typename Heap>
+  struct Node_ : public Heap, public ZmObject, public Link {
+    template <typename Key_>
+    ZuInline Node_(Key_ &&key_) : key(ZuFwd<Key_>(key_)) { }
+
+    inline static int cmp(const Node_ *n1, const Node_ *n2) {
+      return n1 < n2 ? -1 : n1 > n2 ? 1 : 0;
+    }
+    inline static bool equals(const Node_ *n1, const Node_ *n2) {
+      return n1 == n2;
+    }
+    inline static const ZmRef<Node_> &null() {
+      static const ZmRef<Node_> n;
+      return n;
+    }
+
+    Key			key;
+    ZmAtomic<uint32_t>	state;
+  };
+  struct NullHeap { }; // deconflict with ZuNull
+  typedef ZmHeap<HeapID, sizeof(Node_<NullHeap>)> NodeHeap;
+  typedef Node_<NodeHeap> Node;
+  typedef ZmRef<Node> NodeRef;
+
+public:
+  typedef ZmHash<Key,
+	    ZmHashCmp_<Cmp,
+	      ZmHashICmp<ICmp,
+		ZmHashFn<HashFn,
+		  ZmHashIFn<IHashFn,
+		    ZmHashIndex_<Index,
+		      ZmHashVal<NodeRef,
+			ZmHashValCmp<Node,
+			  ZmHashLock<Lock,
+			    ZmHashHeapID<HeapID> > > > > > > > > > Key2Node;
+
+  template <typename ...Args>
+  inline ZmCQueue(
+      const ZmHashParams &params = ZmHashParams(HeapID::id()),
+      Args &&... args) :
+      NTP::Base{ZuFwd<Args>(args)...} {
+    m_head = m_tail = &m_stub;
+    m_index = new Key2Node(params);
+  }
+
+  virtual ~ZmCQueue() { clean(); }
+
+  // producers (any thread)
+  template <typename Key_>
+  inline void push(Key_ &&key) {
+    NodeRef node = new Node(ZuFwd<Key_>(key));
+    if (NodeRef old = m_index->delVal(node->key)) del_(old);
+    m_index->add(node->key, node);
+    ++m_count;
+    node->ref(); // released by shift()
+    enqueue(node);
+  }
+
+  // consumer (single thread) - returns null if the queue is empty
+  inline Key shift() {
+    while (Node *node = dequeue()) {
+      NodeRef node_ = node;
+      node->deref();
+      if (node->state.cmpXch(Shifted, Queued) == Queued) {
+	--m_count;
+	m_index->del(node->key, node_);
+	return ZuMv(node->key);
+      }
+    }
+    return Cmp::null();
+  }
+
+  // any thread
+  template <typename Index_>
+  inline bool find(const Index_ &index) const {
+    NodeRef node = m_index->findVal(index);
+    return node && node->state.load_() == Queued;
+  }
+  template <typename Index_>
+  inline bool del(const Index_ &index) {
+    NodeRef node = m_index->delVal(index);
+    return node && del_(node);
+  }
+
+  // consumer (single thread) - discards all queued items
+  inline void clean() {
+    while (Node *node = dequeue()) if (node->deref()) delete node;
+    m_index->clean();
+    m_count = 0;
+  }
+
+  ZuInline unsigned count() const { return m_count.load_(); }
+
+private:
+  inline bool del_(Node *node) {
+    if (node->state.cmpXch(Deleted, Queued) != Queued) return false;
+    --m_count;
+    return true;
+  }
+
+  // intrusive MPSC queue (D. Vyukov) - m_stub is re-queued whenever
+  // the last item is dequeued, so that m_tail is never null
+  ZuInline void enqueue(Link *link) {
+    link->next.store_(nullptr);
+    Link *prev = m_tail.xch(link);	// full barrier
+    prev->next = link;			// release
+  }
+  inline Node *dequeue() {
+    Link *head = m_head;
+    Link *next = head->next;		// acquire
+    if (head == &m_stub) {
+      if (!next) return nullptr;
+      m_head = head = next;
+      next = next->next;
+    }
+    if (next) {
+      m_head = next;
+      return static_cast<Node *>(head);
+    }
+    // a producer may be between xch() and linking prev->next
+    if (head != m_tail.load_()) return nullptr;
+    enqueue(&m_stub);
+    if (next = head->next) {
+      m_head = next;
+      return static_cast<Node *>(head);
+    }
+    return nullptr;
+  }
+
+  Link			*m_head;	// consumer
+  ZmAtomic<unsigned>	m_count;
+  ZmRef<Key2Node>	m_index;
+  alignas(ZmPlatform::CacheLineSize) ZmAtomic<Link *> m_tail;	// producers
+  Link			m_stub;
+};
+
+#endif /* ZmCQueue_HPP */
@@ -0,0 +1,162 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// epoch-based memory reclamation
+
+#include <zlib/ZmEpoch.hpp>
+
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmPLock.hpp>
+#include <zlib/ZmGuard.hpp>
+
+namespace {
+
+enum { CacheLineSize = ZmPlatform::CacheLineSize };
+
+// a slot's epoch is 0 while its thread is outside any critical section
+struct alignas(CacheLineSize) Slot {
+  ZmAtomic<uint64_t>	epoch = 0;
+  ZmAtomic<uint32_t>	owned = 0;
+};
+
+struct Retired {
+  Retired		*next;
+  void			*ptr;
+  ZmEpoch::Fn		fn;
+  uint64_t		epoch;
+};
+
+struct Epoch {
+  ZmAtomic<uint64_t>	epoch = 1;
+  ZmAtomic<unsigned>	nSlots = 0;	// high water mark
+  ZmPLock		lock;
+    Retired		  *head = 0;
+    Retired		  *tail = 0;
+    unsigned		  count = 0;
+  Slot			slots[ZmEpoch::MaxSlots];
+
+  // returns the list of retired objects that can be reclaimed
+  Retired *reclaimable() {
+    uint64_t min = ~(uint64_t)0;
+    for (unsigned i = 0, n = nSlots.load_(); i < n; i++) {
+      uint64_t epoch = slots[i].epoch; // acquire
+      if (epoch && epoch < min) min = epoch;
+    }
+    Retired *list = head, *last = 0;
+    unsigned n = 0;
+    for (Retired *r = head; r && r->epoch < min; r = r->next) last = r, ++n;
+    if (!last) return 0;
+    if (!(head = last->next)) tail = 0;
+    last->next = 0;
+    count -= n;
+    return list;
+  }
+};
+
+// intentionally never destroyed, since reader threads may outlive statics
+Epoch *epoch_() {
+  static Epoch *epoch = new Epoch();
+  return epoch;
+}
+
+struct Local {
+  Slot		*slot = 0;
+  unsigned	depth = 0;
+
+  ~Local() {
+    if (!slot) return;
+    slot->epoch = 0;
+    slot->owned = 0;
+  }
+
+  bool alloc() {
+    Epoch *epoch = epoch_();
+    for (unsigned i = 0; i < ZmEpoch::MaxSlots; i++) {
+      Slot *slot = &epoch->slots[i];
+      if (slot->owned.load_() || slot->owned.cmpXch(1, 0)) continue;
+      unsigned n;
+      while ((n = epoch->nSlots.load_()) <= i)
+	if (epoch->nSlots.cmpXch(i + 1, n) == n) break;
+      this->slot = slot;
+      return true;
+    }
+    return false;
+  }
+};
+
+thread_local Local local;
+
+void reclaim_(Retired *list) {
+  while (Retired *r = list) {
+    list = r->next;
+    (*r->fn)(r->ptr);
+    delete r;
+  }
+}
+
+}
+
+bool ZmEpoch::enter()
+{
+  Local &local = ::local;
+  if (local.depth) { ++local.depth; return true; }
+  if (ZuUnlikely(!local.slot) && !local.alloc()) return false;
+  ++local.depth;
+  // the exchange is a full barrier - the slot's epoch must be visible to
+  // writers before any shared pointer is dereferenced
+  local.slot->epoch.xch(epoch_()->epoch.load_());
+  return true;
+}
+
+void ZmEpoch::leave()
+{
+  Local &local = ::local;
+  if (--local.depth) return;
+  local.slot->epoch = 0; // release
+}
+
+void ZmEpoch::retire(void *ptr, Fn fn)
+{
+  Epoch *epoch = epoch_();
+  Retired *r = new Retired{0, ptr, fn, 0};
+  Retired *list = 0;
+  {
+    ZmGuard<ZmPLock> guard(epoch->lock);
+    // readers that entered at or before this epoch may reference ptr
+    r->epoch = epoch->epoch++;
+    if (!epoch->tail)
+      epoch->head = epoch->tail = r;
+    else
+      epoch->tail = epoch->tail->next = r;
+    if (++epoch->count >= Batch) list = epoch->reclaimable();
+  }
+  reclaim_(list);
+}
+
+void ZmEpoch::reclaim()
+{
+  Epoch *epoch = epoch_();
+  Retired *list;
+  {
+    ZmGuard<ZmPLock> guard(epoch->lock);
+    list = epoch->reclaimable();
+  }
+  reclaim_(list);
+}
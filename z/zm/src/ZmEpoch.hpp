@@ -0,0 +1,74 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// epoch-based memory reclamation for optimistic (lock-free) readers
+
+// readers enter an epoch before dereferencing shared pointers and leave it
+// when done; writers unlink objects, then retire() them - a retired object
+// is reclaimed (by calling fn(ptr)) once all readers that could have
+// observed it have left; each reader thread is assigned a private
+// (cache-line aligned) slot on first use, so entering and leaving do not
+// write to shared cache lines; if more than MaxSlots threads concurrently
+// read, enter() fails and the caller must fall back to locking
+
+#ifndef ZmEpoch_HPP
+#define ZmEpoch_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+class ZmAPI ZmEpoch {
+public:
+  enum { MaxSlots = 256 };	// maximum number of concurrent reader threads
+  enum { Batch = 64 };		// reclamation batch size
+
+  typedef void (*Fn)(void *);
+
+  // enter and leave read-side critical sections (can be nested)
+  static bool enter();
+  static void leave();
+
+  // defer fn(ptr) until no reader can reference ptr
+  static void retire(void *ptr, Fn fn);
+
+  // reclaim everything that can be (retire() reclaims in batches)
+  static void reclaim();
+
+  class Guard {
+    Guard(const Guard &) = delete;
+    Guard &operator =(const Guard &) = delete;
+
+  public:
+    ZuInline Guard() : m_entered(enter()) { }
+    ZuInline ~Guard() { if (m_entered) leave(); }
+
+    ZuInline bool operator !() const { return !m_entered; }
+    ZuOpBool;
+
+  private:
+    bool	m_entered;
+  };
+};
+
+#endif /* ZmEpoch_HPP */
@@ -59,7 +59,10 @@
 // void foo(Fn fn);
 // foo(Fn([this, ...](params) { ... }));
 //
-// Note: The lambda closure objects are managed by a ZmHeap, but the size
+// Note: Closures of const (non-mutable) lambdas whose captures fit within
+// ZmFn_InlineSize bytes (default 32, configurable 32-64) are stored inline
+// within the ZmFn itself and are copied (not shared) when the ZmFn is copied;
+// other lambda closure objects are managed by a ZmHeap, but the size
 // of each object depends on the captures used, resulting in multiple
 // heap caches for different sizes of lambda
 //
@@ -39,6 +39,17 @@
 #include <zlib/ZmRef.hpp>
 #include <zlib/ZmPolymorph.hpp>
 
+#include <string.h>
+
+// inline closure capacity (bytes) - const (non-mutable) lambdas with
+// captures that fit are stored within ZmFn, larger ones are heap-allocated
+#ifndef ZmFn_InlineSize
+#define ZmFn_InlineSize 32
+#endif
+#if ZmFn_InlineSize < 32 || ZmFn_InlineSize > 64
+#error "ZmFn_InlineSize must be between 32 and 64"
+#endif
+
 template <typename ...Args> class ZmFn;
 
 // ZmFn traits
@@ -51,8 +62,9 @@ struct ZuTraits<ZmFn<Args...> > : public ZuGenericTraits<ZmFn<Args...> > {
 class ZmAnyFn {
   struct Pass { };
 
-  // 64bit pointer-packing - uses bit 63
+  // 64bit pointer-packing - uses bits 63 (owned) and 62 (inline)
   constexpr static const uintptr_t Owned = (((uintptr_t)1)<<63U);
+  constexpr static const uintptr_t Inline = (((uintptr_t)1)<<62U);
 
 protected:
   ZuInline static bool owned(uintptr_t o) { return o & Owned; }
@@ -64,20 +76,78 @@ protected:
     return (O *)(o & ~Owned);
   }
 
+  // inline closures - m_object is the (tagged) pointer to the closure
+  // type's operations, which is null if the closure is trivially copyable
+  struct InlineOps {
+    void	(*copy)(void *, const void *);
+    void	(*move)(void *, void *);
+    void	(*dtor)(void *);
+  };
+  template <typename L> struct InlineFn {
+    enum {
+      OK = sizeof(L) <= ZmFn_InlineSize &&
+	alignof(L) <= alignof(uintptr_t) &&
+	__is_constructible(L, const L &),
+      Trivial = __is_trivially_copyable(L)
+    };
+    static void copy(void *p, const void *l) { new (p) L(*(const L *)l); }
+    static void move(void *p, void *l) { new (p) L(ZuMv(*(L *)l)); }
+    static void dtor(void *l) { ((L *)l)->~L(); }
+    constexpr static const InlineOps Ops{&copy, &move, &dtor};
+    ZuInline static uintptr_t ops() {
+      if constexpr (Trivial)
+	return Inline;
+      else
+	return (uintptr_t)&Ops | Inline;
+    }
+  };
+
+  ZuInline static bool isInline(uintptr_t o) { return o & Inline; }
+  ZuInline static const InlineOps *inlineOps(uintptr_t o) {
+    return (const InlineOps *)(o & ~Inline);
+  }
+  // the closure immediately follows m_object, which is passed to invokers
+  ZuInline static void *inlineBuf(uintptr_t &o) { return (void *)(&o + 1); }
+
+  void inlineCopy(const ZmAnyFn &fn) {
+    if (const InlineOps *ops = inlineOps(m_object)) {
+      memset(m_buf, 0, sizeof(m_buf));
+      (*ops->copy)(m_buf, fn.m_buf);
+    } else
+      memcpy(m_buf, fn.m_buf, sizeof(m_buf));
+  }
+  void inlineMove(ZmAnyFn &fn) {
+    if (const InlineOps *ops = inlineOps(m_object)) {
+      memset(m_buf, 0, sizeof(m_buf));
+      (*ops->move)(m_buf, fn.m_buf);
+    } else
+      memcpy(m_buf, fn.m_buf, sizeof(m_buf));
+  }
+  void inlineDtor() {
+    if (const InlineOps *ops = inlineOps(m_object)) (*ops->dtor)(m_buf);
+  }
+
 public:
   ZuInline ZmAnyFn() : m_invoker(0), m_object(0) { }
 
   ZuInline ~ZmAnyFn() {
-    if (ZuUnlikely(owned(m_object))) ZmDEREF(ptr(m_object));
+    if (ZuUnlikely(owned(m_object)))
+      ZmDEREF(ptr(m_object));
+    else if (ZuUnlikely(isInline(m_object)))
+      inlineDtor();
   }
 
   ZuInline ZmAnyFn(const ZmAnyFn &fn) :
       m_invoker(fn.m_invoker), m_object(fn.m_object) {
-    if (ZuUnlikely(owned(m_object))) ZmREF(ptr(m_object));
+    if (ZuUnlikely(owned(m_object)))
+      ZmREF(ptr(m_object));
+    else if (ZuUnlikely(isInline(m_object)))
+      inlineCopy(fn);
   }
 
   ZuInline ZmAnyFn(ZmAnyFn &&fn) noexcept :
       m_invoker(fn.m_invoker), m_object(fn.m_object) {
+    if (ZuUnlikely(isInline(m_object))) { inlineMove(fn); return; }
     deref(fn.m_object);
 #ifdef ZmObject_DEBUG
     if (ZuUnlikely(owned(m_object))) ZmMVREF(ptr(m_object), &fn, this);
@@ -87,18 +157,25 @@ public:
   inline ZmAnyFn &operator =(const ZmAnyFn &fn) {
     if (this == &fn) return *this;
     if (ZuUnlikely(owned(fn.m_object))) ZmREF(ptr(fn.m_object));
-    if (ZuUnlikely(owned(m_object))) ZmDEREF(ptr(m_object));
+    if (ZuUnlikely(owned(m_object)))
+      ZmDEREF(ptr(m_object));
+    else if (ZuUnlikely(isInline(m_object)))
+      inlineDtor();
     m_invoker = fn.m_invoker;
     m_object = fn.m_object;
+    if (ZuUnlikely(isInline(m_object))) inlineCopy(fn);
     return *this;
   }
 
   inline ZmAnyFn &operator =(ZmAnyFn &&fn) noexcept {
-#ifdef ZmObject_DEBUG
-    if (ZuUnlikely(owned(m_object))) ZmDEREF(ptr(m_object));
-#endif
+    if (this == &fn) return *this;
+    if (ZuUnlikely(owned(m_object)))
+      ZmDEREF(ptr(m_object));
+    else if (ZuUnlikely(isInline(m_object)))
+      inlineDtor();
     m_invoker = fn.m_invoker;
     m_object = fn.m_object;
+    if (ZuUnlikely(isInline(m_object))) { inlineMove(fn); return *this; }
     deref(fn.m_object);
 #ifdef ZmObject_DEBUG
     if (ZuUnlikely(owned(m_object))) ZmMVREF(ptr(m_object), &fn, this);
@@ -118,6 +195,13 @@ protected:
     new (&m_object) ZmRef<O>(ZuMv(o));
     ref(m_object);
   }
+  struct InlineTag { };
+  template <typename Invoker, typename L, typename L_>
+  ZuInline ZmAnyFn(InlineTag, const Invoker &invoker, L *, L_ &&l) :
+      m_invoker((uintptr_t)invoker), m_object(InlineFn<L>::ops()) {
+    memset(m_buf, 0, sizeof(m_buf));
+    new (m_buf) L(ZuFwd<L_>(l));
+  }
 
 public:
   // downcast to ZmFn<...>
@@ -139,11 +223,17 @@ public:
     return ZuMv(*ptr);
   }
   template <typename O> ZuInline void object(O *o) {
-    if (ZuUnlikely(owned(m_object))) ZmDEREF(ptr(m_object));
+    if (ZuUnlikely(owned(m_object)))
+      ZmDEREF(ptr(m_object));
+    else if (ZuUnlikely(isInline(m_object)))
+      inlineDtor();
     m_object = (uintptr_t)o;
   }
   template <typename O> ZuInline void object(ZmRef<O> o) {
-    if (ZuLikely(owned(m_object))) ZmDEREF(ptr(m_object));
+    if (ZuLikely(owned(m_object)))
+      ZmDEREF(ptr(m_object));
+    else if (ZuUnlikely(isInline(m_object)))
+      inlineDtor();
     new (&m_object) ZmRef<O>(ZuMv(o));
     ref(m_object);
   }
@@ -152,13 +242,16 @@ public:
   ZuInline uintptr_t invoker() const { return m_invoker; }
 
   ZuInline bool operator ==(const ZmAnyFn &fn) const {
-    return m_invoker == fn.m_invoker && m_object == fn.m_object;
+    return m_invoker == fn.m_invoker && m_object == fn.m_object &&
+      (!isInline(m_object) || !memcmp(m_buf, fn.m_buf, sizeof(m_buf)));
   }
 
   ZuInline int cmp(const ZmAnyFn &fn) const {
     if (m_invoker < fn.m_invoker) return -1;
     if (m_invoker > fn.m_invoker) return 1;
-    return ZuCmp<uintptr_t>::cmp(m_object, fn.m_object);
+    if (int i = ZuCmp<uintptr_t>::cmp(m_object, fn.m_object)) return i;
+    if (!isInline(m_object)) return 0;
+    return memcmp(m_buf, fn.m_buf, sizeof(m_buf));
   }
 
   ZuInline bool operator !() const { return !m_invoker; }
@@ -172,6 +265,7 @@ public:
 protected:
   uintptr_t		m_invoker;
   mutable uintptr_t	m_object;
+  alignas(uintptr_t) char m_buf[ZmFn_InlineSize];	// inline closure
 };
 
 struct ZmLambda_HeapID {
@@ -482,6 +576,20 @@ private:
   template <typename, typename, class, bool, typename ...Args_>
   friend struct LambdaInvoker_;
 
+  // lambdas with captures (inline)
+  template <typename L, bool VoidRet> struct InlineInvoker;
+  template <typename L> struct InlineInvoker<L, 0> {
+    static uintptr_t invoke(uintptr_t &o, Args... args) {
+      return (uintptr_t)(*(const L *)inlineBuf(o))(ZuFwd<Args>(args)...);
+    }
+  };
+  template <typename L> struct InlineInvoker<L, 1> {
+    static uintptr_t invoke(uintptr_t &o, Args... args) {
+      (*(const L *)inlineBuf(o))(ZuFwd<Args>(args)...);
+      return 0;
+    }
+  };
+
   // lambdas with captures (heap-allocated)
   template <typename L, typename R, class HeapID, typename ...Args_>
   struct LambdaInvoker_<L, R, HeapID, 0, Args_...> {
@@ -491,12 +599,19 @@ private:
 	    ZmRef<O>(new typename ZmLambda<L, HeapID>::T(ZuFwd<L_>(l))));
     }
   };
+  // const lambdas with small captures are stored inline
   template <typename L, typename R, class HeapID, typename ...Args_>
   struct LambdaInvoker_<const L, R, HeapID, 0, Args_...> {
     template <typename L_> ZuInline static ZmFn fn(L_ &&l) {
-      typedef typename ZmLambda<L, HeapID>::T O;
-      return Member<&L::operator ()>::fn(
+      if constexpr (InlineFn<L>::OK) {
+	return ZmFn(ZmFn::Pass(), InlineTag(),
+	    &InlineInvoker<L, ZuConversion<void, R>::Same>::invoke,
+	    (L *)0, ZuFwd<L_>(l));
+      } else {
+	typedef typename ZmLambda<L, HeapID>::T O;
+	return Member<&L::operator ()>::fn(
 	    ZmRef<const O>(new typename ZmLambda<L, HeapID>::T(ZuFwd<L_>(l))));
+      }
     }
   };
 
@@ -0,0 +1,923 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// open addressing, SIMD group probing, globally locked
+//
+// drop-in alternative to ZmLHash - same NTP parameters and API, switch
+// by changing the typedef:
+//
+// typedef ZmGHash<uint64_t,		// was ZmLHash<uint64_t,
+//   ZmLHashVal<Order *,
+//     ZmLHashLock<ZmNoLock> > > Orders;
+//
+// layout (a "Swiss table"):
+// - slots are grouped 16 at a time; each slot has a control byte that is
+//   either Empty (0x80), Deleted (0xfe) or a 7-bit tag taken from the hash
+// - lookups match the tag against an entire group of control bytes with a
+//   single SSE2 compare, then compare keys only for the (usually 0 or 1)
+//   slots whose tags match
+// - probing proceeds group by group (triangular) until a group containing
+//   an Empty slot is encountered
+// - removal leaves a Deleted tombstone unless the group already contains an
+//   Empty slot; tombstones are purged by rehashing in place
+// - nodes are never moved by removal, so iterators remain valid across del()
+//
+// compared to ZmLHash, lookups cost one key comparison per match rather than
+// per probe, and performance degrades far less at high load factors; the
+// load factor is clamped to [0.5, 0.875]
+
+#ifndef ZmGHash_HPP
+#define ZmGHash_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZmGHash_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <zlib/ZmLHash.hpp>
+
+// control bytes for a group of 16 slots
+struct alignas(16) ZmGHash_Ctrl {
+  enum { Size = 16 };
+  enum { Empty = 0x80, Deleted = 0xfe };
+
+  // bitmask of slots whose control byte == v
+  ZuInline unsigned match(uint8_t v) const {
+#ifdef ZmGHash_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(
+	  _mm_set1_epi8((char)v), _mm_load_si128((const __m128i *)m_data)));
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < Size; i++) mask |= (m_data[i] == v)<<i;
+    return mask;
+#endif
+  }
+  // bitmask of Empty slots
+  ZuInline unsigned matchEmpty() const { return match(Empty); }
+  // bitmask of Empty or Deleted slots
+  ZuInline unsigned matchFree() const {
+#ifdef ZmGHash_SSE2
+    return _mm_movemask_epi8(_mm_load_si128((const __m128i *)m_data));
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < Size; i++) mask |= (m_data[i]>>7)<<i;
+    return mask;
+#endif
+  }
+  // bitmask of occupied slots
+  ZuInline unsigned matchFull() const { return matchFree() ^ 0xffffU; }
+
+  ZuInline void init() { memset(m_data, Empty, Size); }
+
+  uint8_t	m_data[Size];
+};
+
+template <typename Key, typename Val>
+class ZmGHash_Data {
+public:
+  template <typename Key_, typename Val_>
+  ZuInline ZmGHash_Data(Key_ &&key, Val_ &&value) :
+    m_key(ZuFwd<Key_>(key)), m_value(ZuFwd<Val_>(value)) { }
+
+  ZuInline const Key &key() const { return m_key; }
+  ZuInline Key &key() { return m_key; }
+  ZuInline const Val &value() const { return m_value; }
+  ZuInline Val &value() { return m_value; }
+
+private:
+  Key	m_key;
+  Val	m_value;
+};
+
+// common base class for both static and dynamic tables
+template <typename Key, typename NTP> class ZmGHash__ : public ZmAnyHash {
+  typedef typename NTP::Lock Lock;
+
+public:
+  inline unsigned loadFactor_() const { return m_loadFactor; }
+  inline double loadFactor() const { return (double)m_loadFactor / 16.0; }
+
+  inline unsigned count_() const { return m_count.load_(); }
+
+protected:
+  inline ZmGHash__(const ZmHashParams &params) : ZmAnyHash(params.telFreq()) {
+    double loadFactor = params.loadFactor();
+    if (loadFactor < 0.5) loadFactor = 0.5;
+    else if (loadFactor > 0.875) loadFactor = 0.875;
+    m_loadFactor = (unsigned)(loadFactor * 16.0);
+  }
+
+  // minimum size is a single group
+  inline static constexpr unsigned minBits() { return 4; }
+
+  unsigned		m_loadFactor = 0;
+  ZmAtomic<unsigned>	m_count = 0;
+  unsigned		m_deleted = 0;	// tombstones
+  Lock			m_lock;
+};
+
+// statically allocated hash table base class
+template <class Hash, typename Key, class NTP, unsigned Static>
+class ZmGHash_ : public ZmGHash__<Key, NTP> {
+  typedef ZmGHash__<Key, NTP> Base;
+  typedef typename NTP::Val Val;
+  typedef ZmGHash_Data<Key, Val> Data;
+  typedef typename NTP::template HashFnT<Key>::HashFn HashFn;
+
+  enum { Bits = Static < Base::minBits() ? Base::minBits() : Static };
+
+public:
+  inline static constexpr unsigned bits() { return Bits; }
+
+protected:
+  inline ZmGHash_(const ZmHashParams &params) : Base(params) { }
+
+  inline void init() {
+    for (unsigned i = 0; i < (1U<<(Bits - 4)); i++) m_ctrl[i].init();
+  }
+  inline void final() { static_cast<Hash *>(this)->destroy(); }
+
+  // cannot grow - purge tombstones if there are any
+  inline void grow(unsigned) { if (this->m_deleted) rehash(); }
+  inline static constexpr unsigned resized() { return 0; }
+
+  inline Data *data() { return reinterpret_cast<Data *>(m_data); }
+  inline const Data *data() const {
+    return reinterpret_cast<const Data *>(m_data);
+  }
+
+private:
+  void rehash() {
+    unsigned n = this->m_count.load_();
+    Data *tmp = (Data *)::malloc(n * sizeof(Data));
+    if (!tmp) throw std::bad_alloc();
+    unsigned j = 0;
+    for (unsigned i = 0; i < (1U<<Bits); i++)
+      if (m_ctrl[i>>4].m_data[i & 15] < 0x80) {
+	new (&tmp[j++]) Data(ZuMv(data()[i]));
+	data()[i].~Data();
+      }
+    init();
+    this->m_deleted = 0;
+    for (unsigned i = 0; i < j; i++) {
+      uint32_t code = HashFn::hash(tmp[i].key());
+      static_cast<Hash *>(this)->add__(
+	  ZuMv(tmp[i].key()), ZuMv(tmp[i].value()), code);
+      tmp[i].~Data();
+    }
+    ::free(tmp);
+  }
+
+protected:
+  ZmGHash_Ctrl	m_ctrl[1U<<(Bits - 4)];
+  alignas(Data) char m_data[(1U<<Bits) * sizeof(Data)];
+};
+
+// dynamically allocated hash table base class
+template <class Hash, typename Key, class NTP>
+class ZmGHash_<Hash, Key, NTP, 0> : public ZmGHash__<Key, NTP> {
+  typedef ZmGHash__<Key, NTP> Base;
+  typedef typename NTP::Val Val;
+  typedef ZmGHash_Data<Key, Val> Data;
+  typedef typename NTP::template HashFnT<Key>::HashFn HashFn;
+
+public:
+  inline unsigned bits() const { return m_bits; }
+
+protected:
+  inline ZmGHash_(const ZmHashParams &params) : Base(params),
+    m_bits(params.bits() < Base::minBits() ? Base::minBits() : params.bits())
+  { }
+
+  inline void init() {
+    alloc();
+    ZmHashMgr::add(this);
+  }
+
+  inline void final() {
+    ZmHashMgr::del(this);
+    static_cast<Hash *>(this)->destroy();
+    free(m_ctrl, m_data);
+  }
+
+  // purge tombstones in place if that frees enough space, otherwise double
+  void grow(unsigned count) {
+    if (((uint64_t)(count + 1)<<5) <= ((uint64_t)this->loadFactor_()<<m_bits))
+      rehash(m_bits);
+    else if (m_bits < 28) {
+      ++m_resized;
+      rehash(m_bits + 1);
+    }
+  }
+
+  unsigned resized() const { return m_resized.load_(); }
+
+  ZuInline Data *data() { return m_data; }
+  ZuInline const Data *data() const { return m_data; }
+
+private:
+  void alloc() {
+    unsigned n = 1U<<(m_bits - 4);
+    m_ctrl = new ZmGHash_Ctrl[n];
+    for (unsigned i = 0; i < n; i++) m_ctrl[i].init();
+    m_data = (Data *)::malloc((1U<<m_bits) * sizeof(Data));
+    if (!m_data) { delete [] m_ctrl; throw std::bad_alloc(); }
+  }
+  static void free(ZmGHash_Ctrl *ctrl, Data *data) {
+    delete [] ctrl;
+    ::free(data);
+  }
+
+  void rehash(unsigned bits) {
+    unsigned size = 1U<<m_bits;
+    ZmGHash_Ctrl *oldCtrl = m_ctrl;
+    Data *oldData = m_data;
+    m_bits = bits;
+    alloc();
+    this->m_deleted = 0;
+    for (unsigned i = 0; i < size; i++)
+      if (oldCtrl[i>>4].m_data[i & 15] < 0x80) {
+	uint32_t code = HashFn::hash(oldData[i].key());
+	static_cast<Hash *>(this)->add__(
+	    ZuMv(oldData[i].key()), ZuMv(oldData[i].value()), code);
+	oldData[i].~Data();
+      }
+    free(oldCtrl, oldData);
+  }
+
+protected:
+  ZmAtomic<unsigned>	m_resized = 0;
+  unsigned		m_bits;
+  ZmGHash_Ctrl		*m_ctrl = nullptr;
+  Data			*m_data = nullptr;
+};
+
+template <typename Key_, class NTP = ZmLHash_Defaults>
+class ZmGHash : public ZmGHash_<ZmGHash<Key_, NTP>, Key_, NTP, NTP::Static> {
+  ZmGHash(const ZmGHash &) = delete;
+  ZmGHash &operator =(const ZmGHash &) = delete; // prevent mis-use
+
+template <class, typename, class, unsigned> friend class ZmGHash_;
+
+  typedef ZmGHash_<ZmGHash<Key_, NTP>, Key_, NTP, NTP::Static> Base;
+
+public:
+  typedef Key_ Key;
+  typedef typename NTP::Val Val;
+  typedef typename NTP::template CmpT<Key>::Cmp Cmp;
+  typedef typename NTP::template ICmpT<Key>::ICmp ICmp;
+  typedef typename NTP::template HashFnT<Key>::HashFn HashFn;
+  typedef typename NTP::template IHashFnT<Key>::IHashFn IHashFn;
+  typedef typename NTP::template IndexT<Key>::Index Index;
+  typedef typename NTP::template ValCmpT<Val>::ValCmp ValCmp;
+  typedef typename NTP::Lock Lock;
+  typedef typename NTP::ID ID;
+  typedef ZmLockTraits<Lock> LockTraits;
+  typedef ZmGuard<Lock> Guard;
+  typedef ZmReadGuard<Lock> ReadGuard;
+  typedef ZuPair<Key, Val> KeyVal;
+  typedef ZuPair<const Key &, const Val &> KeyValRef;
+  typedef ZmGHash_Data<Key, Val> Data;
+  enum { Static = NTP::Static };
+
+private:
+  using Base::m_count;
+  using Base::m_deleted;
+  using Base::m_lock;
+  using Base::m_ctrl;
+  using Base::data;
+
+public:
+  using Base::bits;
+  using Base::loadFactor_;
+  using Base::loadFactor;
+  using Base::resized;
+
+protected:
+  class Iterator_;
+friend class Iterator_;
+  class Iterator_ {			// hash iterator
+    typedef ZmGHash<Key, NTP> Hash;
+  friend class ZmGHash<Key, NTP>;
+
+  protected:
+    inline Iterator_(Hash &hash) : m_hash(hash), m_slot(-1) { }
+
+    virtual void lock(Lock &l) = 0;
+    virtual void unlock(Lock &l) = 0;
+
+  public:
+    inline void reset() { m_hash.startIterate(*this); }
+    inline KeyValRef iterate() { return m_hash.iterate(*this); }
+    inline const Key &iterateKey() { return m_hash.iterateKey(*this); }
+    inline const Val &iterateVal() { return m_hash.iterateVal(*this); }
+
+    ZuInline unsigned count() const { return m_hash.count_(); }
+
+  protected:
+    Hash	&m_hash;
+    int		m_slot;
+  };
+
+  class IndexIterator_;
+friend class IndexIterator_;
+  class IndexIterator_ : protected Iterator_ {
+    typedef ZmGHash<Key, NTP> Hash;
+  friend class ZmGHash<Key, NTP>;
+
+    using Iterator_::m_hash;
+
+  protected:
+    template <typename Index_>
+    inline IndexIterator_(Hash &hash, const Index_ &index) :
+	Iterator_(hash), m_index(index) { }
+
+  public:
+    inline void reset() { m_hash.startIterate(*this); }
+    inline KeyValRef iterate() { return m_hash.iterate(*this); }
+    inline const Key &iterateKey() { return m_hash.iterateKey(*this); }
+    inline const Val &iterateVal() { return m_hash.iterateVal(*this); }
+
+  protected:
+    Index	m_index;
+    int		m_group = -1;	// current group, -1 when exhausted
+    unsigned	m_probe = 0;	// probe sequence position
+    unsigned	m_mask = 0;	// remaining tag matches within group
+    uint8_t	m_tag = 0;
+    bool	m_last = true;	// current group terminates the probe
+  };
+
+public:
+  class Iterator : public Iterator_ {
+    Iterator(const Iterator &);
+    Iterator &operator =(const Iterator &);	// prevent mis-use
+
+    typedef ZmGHash<Key, NTP> Hash;
+    void lock(Lock &l) { LockTraits::lock(l); }
+    void unlock(Lock &l) { LockTraits::unlock(l); }
+
+    using Iterator_::m_hash;
+
+  public:
+    inline Iterator(Hash &hash) : Iterator_(hash) { hash.startIterate(*this); }
+    inline ~Iterator() { m_hash.endIterate(*this); }
+    inline void del() { m_hash.delIterate(*this); }
+  };
+
+  class ReadIterator : public Iterator_ {
+    ReadIterator(const ReadIterator &);
+    ReadIterator &operator =(const ReadIterator &);	// prevent mis-use
+
+    typedef ZmGHash<Key, NTP> Hash;
+    void lock(Lock &l) { LockTraits::readlock(l); }
+    void unlock(Lock &l) { LockTraits::readunlock(l); }
+
+    using Iterator_::m_hash;
+
+  public:
+    inline ReadIterator(const Hash &hash) : Iterator_(const_cast<Hash &>(hash))
+      { const_cast<Hash &>(hash).startIterate(*this); }
+    inline ~ReadIterator() { m_hash.endIterate(*this); }
+  };
+
+  class IndexIterator : public IndexIterator_ {
+    IndexIterator(const IndexIterator &);
+    IndexIterator &operator =(const IndexIterator &);	// prevent mis-use
+
+    typedef ZmGHash<Key, NTP> Hash;
+    void lock(Lock &l) { LockTraits::lock(l); }
+    void unlock(Lock &l) { LockTraits::unlock(l); }
+
+    using IndexIterator_::m_hash;
+
+  public:
+    template <typename Index_>
+    inline IndexIterator(Hash &hash, Index_ &&index) :
+	IndexIterator_(hash, ZuFwd<Index_>(index)) { hash.startIterate(*this); }
+    inline ~IndexIterator() { m_hash.endIterate(*this); }
+    inline void del() { m_hash.delIterate(*this); }
+  };
+
+  class ReadIndexIterator : public IndexIterator_ {
+    ReadIndexIterator(const ReadIndexIterator &);
+    ReadIndexIterator &operator =(const ReadIndexIterator &); // prevent mis-use
+
+    typedef ZmGHash<Key, NTP> Hash;
+    void lock(Lock &l) { LockTraits::readlock(l); }
+    void unlock(Lock &l) { LockTraits::readunlock(l); }
+
+    using IndexIterator_::m_hash;
+
+  public:
+    template <typename Index_>
+    inline ReadIndexIterator(Hash &hash, Index_ &&index) :
+	IndexIterator_(const_cast<Hash &>(hash), ZuFwd<Index_>(index))
+      { const_cast<Hash &>(hash).startIterate(*this); }
+    inline ~ReadIndexIterator() { m_hash.endIterate(*this); }
+  };
+
+  template <typename ...Args>
+  inline ZmGHash(ZmHashParams params = ZmHashParams(ID::id())) : Base(params) {
+    Base::init();
+  }
+
+  ~ZmGHash() { Base::final(); }
+
+  inline unsigned size() const {
+    return (double)(((uint64_t)1)<<bits()) * loadFactor();
+  }
+
+private:
+  // split the hash code into the initial group and the 7-bit tag
+  ZuInline static uint64_t mix(uint32_t code) {
+    return (uint64_t)code * 0x9e3779b97f4a7c15ULL;
+  }
+  ZuInline unsigned group(uint64_t h) const {
+    return (unsigned)(h>>32) & ((1U<<(bits() - 4)) - 1);
+  }
+  ZuInline static uint8_t tag(uint64_t h) { return (h>>25) & 0x7f; }
+  // triangular probing (offsets 0, 1, 3, 6, ...) visits every group once;
+  // i is the (1-based) number of groups probed so far
+  ZuInline unsigned probe(unsigned group, unsigned i) const {
+    return (group + i) & ((1U<<(bits() - 4)) - 1);
+  }
+
+  ZuInline bool full(unsigned slot) const {
+    return m_ctrl[slot>>4].m_data[slot & 15] < 0x80;
+  }
+  ZuInline const Key &key(unsigned slot) const { return data()[slot].key(); }
+  ZuInline const Val &value(unsigned slot) const {
+    return data()[slot].value();
+  }
+
+public:
+  template <typename Key__>
+  inline int add(Key__ &&key) { return add(ZuFwd<Key__>(key), Val()); }
+  template <typename Key__, typename Val_>
+  inline int add(Key__ &&key, Val_ &&val) {
+    uint32_t code = HashFn::hash(key);
+    Guard guard(m_lock);
+
+    return add_(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code);
+  }
+  template <typename Key__>
+  inline int add_(Key__ &&key) {
+    uint32_t code = HashFn::hash(key);
+    return add_(ZuFwd<Key__>(key), Val(), code);
+  }
+  template <typename Key__, typename Val_>
+  inline int add_(Key__ &&key, Val_ &&val) {
+    uint32_t code = HashFn::hash(key);
+    return add_(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code);
+  }
+private:
+  template <typename Key__, typename Val_>
+  inline int add_(Key__ &&key, Val_ &&val, uint32_t code) {
+    unsigned count = m_count.load_();
+    if (((uint64_t)(count + m_deleted + 1)<<4) >
+	((uint64_t)loadFactor_()<<bits()))
+      Base::grow(count);
+
+    int slot = add__(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code);
+    if (ZuLikely(slot >= 0)) m_count.store_(count + 1);
+    return slot;
+  }
+
+  template <typename Key__, typename Val_>
+  inline int add__(Key__ &&key, Val_ &&val, uint32_t code) {
+    uint64_t h = mix(code);
+    unsigned g = group(h);
+    unsigned n = 1U<<(bits() - 4);
+    for (unsigned i = 0; i < n; ) {
+      if (unsigned mask = m_ctrl[g].matchFree()) {
+	unsigned j = __builtin_ctz(mask);
+	uint8_t &ctrl = m_ctrl[g].m_data[j];
+	if (ctrl == ZmGHash_Ctrl::Deleted) --m_deleted;
+	ctrl = tag(h);
+	unsigned slot = (g<<4) | j;
+	new (&data()[slot]) Data(ZuFwd<Key__>(key), ZuFwd<Val_>(val));
+	return slot;
+      }
+      g = probe(g, ++i);
+    }
+    return -1;
+  }
+
+  inline void destroy() {
+    unsigned size = 1U<<bits();
+    for (unsigned i = 0; i < size; i++)
+      if (full(i)) data()[i].~Data();
+  }
+
+public:
+  template <typename Index_>
+  inline bool exists(const Index_ &index) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return find__(index, code) >= 0;
+  }
+  template <typename Index_>
+  inline bool exists_(const Index_ &index) const {
+    return find__(index, IHashFn::hash(index)) >= 0;
+  }
+  template <typename Index_>
+  inline KeyVal find(const Index_ &index) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return keyVal__(find__(index, code));
+  }
+  template <typename Index_>
+  inline KeyVal find_(const Index_ &index) const {
+    return keyVal__(find__(index, IHashFn::hash(index)));
+  }
+  template <typename Index_>
+  inline Key findKey(const Index_ &index) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return key__(find__(index, code));
+  }
+  template <typename Index_>
+  inline Val findVal(const Index_ &index) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return val__(find__(index, code));
+  }
+private:
+  // l(slot) returns true if the slot matches
+  template <typename L>
+  inline int match_(uint32_t code, L l) const {
+    uint64_t h = mix(code);
+    uint8_t tag = this->tag(h);
+    unsigned g = group(h);
+    unsigned n = 1U<<(bits() - 4);
+    for (unsigned i = 0; i < n; ) {
+      const ZmGHash_Ctrl &ctrl = m_ctrl[g];
+      for (unsigned mask = ctrl.match(tag); mask; mask &= mask - 1) {
+	unsigned slot = (g<<4) | __builtin_ctz(mask);
+	if (l(slot)) return slot;
+      }
+      if (ZuLikely(ctrl.matchEmpty())) return -1;
+      g = probe(g, ++i);
+    }
+    return -1;
+  }
+  template <typename Index_>
+  inline int find__(const Index_ &index, uint32_t code) const {
+    return match_(code, [this, &index](unsigned slot) {
+      return ICmp::equals(key(slot), index);
+    });
+  }
+
+  inline KeyVal keyVal__(int slot) const {
+    if (ZuUnlikely(slot < 0))
+      return KeyVal(Cmp::null(), ValCmp::null());
+    return KeyVal(key(slot), value(slot));
+  }
+  inline KeyValRef keyValRef__(int slot) const {
+    if (ZuUnlikely(slot < 0))
+      return KeyValRef(Cmp::null(), ValCmp::null());
+    return KeyValRef(key(slot), value(slot));
+  }
+  inline const Key &key__(int slot) const {
+    if (ZuUnlikely(slot < 0)) return Cmp::null();
+    return key(slot);
+  }
+  inline const Val &val__(int slot) const {
+    if (ZuUnlikely(slot < 0)) return ValCmp::null();
+    return value(slot);
+  }
+
+public:
+  template <typename Index_, typename Val_>
+  inline KeyVal find(
+      const Index_ &index, const Val_ &val) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return keyVal__(find__(index, val, code));
+  }
+  template <typename Index_, typename Val_>
+  inline KeyVal find_(
+      const Index_ &index, const Val_ &val) const {
+    return keyVal__(find__(index, val, IHashFn::hash(index)));
+  }
+  template <typename Index_, typename Val_>
+  inline Key findKey(const Index_ &index, const Val_ &val) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return key__(find__(index, val, code));
+  }
+  template <typename Index_, typename Val_>
+  inline Val findVal(const Index_ &index, const Val_ &val) const {
+    uint32_t code = IHashFn::hash(index);
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+
+    return val__(find__(index, val, code));
+  }
+private:
+  template <typename Index_, typename Val_>
+  inline int find__(
+      const Index_ &index, const Val_ &val, uint32_t code) const {
+    return match_(code, [this, &index, &val](unsigned slot) {
+      return ICmp::equals(key(slot), index) &&
+	ValCmp::equals(value(slot), val);
+    });
+  }
+
+public:
+  template <typename Key__>
+  inline KeyVal findAdd(Key__ &&key) {
+    uint32_t code = HashFn::hash(key);
+    Guard guard(m_lock);
+
+    return keyVal__(findAdd__(ZuFwd<Key__>(key), Val(), code));
+  }
+  template <typename Key__, typename Val_>
+  inline KeyVal findAdd(Key__ &&key, Val_ &&val) {
+    uint32_t code = HashFn::hash(key);
+    Guard guard(m_lock);
+
+    return keyVal__(findAdd__(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code));
+  }
+  template <typename Key__>
+  inline KeyVal findAdd_(Key__ &&key) {
+    uint32_t code = HashFn::hash(key);
+    return keyVal__(findAdd__(ZuFwd<Key__>(key), Val(), code));
+  }
+  template <typename Key__, typename Val_>
+  inline KeyVal findAdd_(
+      Key__ &&key, Val_ &&val) {
+    uint32_t code = HashFn::hash(key);
+    return keyVal__(findAdd__(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code));
+  }
+  template <typename Key__>
+  inline Key findAddKey(Key__ &&key) {
+    uint32_t code = HashFn::hash(key);
+    Guard guard(m_lock);
+
+    return key__(findAdd__(ZuFwd<Key__>(key), Val(), code));
+  }
+  template <typename Key__, typename Val_>
+  inline Key findAddKey(Key__ &&key, Val_ &&val) {
+    uint32_t code = HashFn::hash(key);
+    Guard guard(m_lock);
+
+    return key__(findAdd__(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code));
+  }
+  template <typename Key__, typename Val_>
+  inline Val findAddVal(Key__ &&key, Val_ &&val) {
+    uint32_t code = HashFn::hash(key);
+    Guard guard(m_lock);
+
+    return val__(findAdd__(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code));
+  }
+private:
+  template <typename Key__, typename Val_>
+  inline int findAdd__(Key__ &&key, Val_ &&val, uint32_t code) {
+    int slot = match_(code, [this, &key](unsigned slot) {
+      return Cmp::equals(this->key(slot), key);
+    });
+    if (slot >= 0) return slot;
+    return add_(ZuFwd<Key__>(key), ZuFwd<Val_>(val), code);
+  }
+
+public:
+  template <typename Index_>
+  inline Key del(const Index_ &index) {
+    uint32_t code = IHashFn::hash(index);
+    Guard guard(m_lock);
+
+    return delKey__(find__(index, code));
+  }
+  template <typename Index_>
+  inline Key del_(const Index_ &index) {
+    return delKey__(find__(index, IHashFn::hash(index)));
+  }
+  template <typename Index_>
+  inline Key delKey(const Index_ &index) {
+    uint32_t code = IHashFn::hash(index);
+    Guard guard(m_lock);
+
+    return delKey__(find__(index, code));
+  }
+  template <typename Index_>
+  inline Val delVal(const Index_ &index) {
+    uint32_t code = IHashFn::hash(index);
+    Guard guard(m_lock);
+
+    return delVal__(find__(index, code));
+  }
+
+private:
+  // a group that has ever been completely full may have been probed past,
+  // so removal must leave a tombstone; otherwise the slot reverts to Empty
+  inline void del__(unsigned slot) {
+    ZmGHash_Ctrl &ctrl = m_ctrl[slot>>4];
+    data()[slot].~Data();
+    if (ctrl.matchEmpty())
+      ctrl.m_data[slot & 15] = ZmGHash_Ctrl::Empty;
+    else {
+      ctrl.m_data[slot & 15] = ZmGHash_Ctrl::Deleted;
+      ++m_deleted;
+    }
+    if (unsigned count = m_count.load_())
+      m_count.store_(count - 1);
+  }
+
+  inline KeyVal delKeyVal__(int slot) {
+    if (slot < 0) return KeyVal(Cmp::null(), ValCmp::null());
+    Data &data = this->data()[slot];
+    KeyVal keyVal(ZuMv(data.key()), ZuMv(data.value()));
+    del__(slot);
+    return keyVal;
+  }
+  inline Key delKey__(int slot) {
+    if (slot < 0) return Cmp::null();
+    Key key(ZuMv(data()[slot].key()));
+    del__(slot);
+    return key;
+  }
+  inline Val delVal__(int slot) {
+    if (slot < 0) return ValCmp::null();
+    Val val(ZuMv(data()[slot].value()));
+    del__(slot);
+    return val;
+  }
+
+public:
+  template <typename Index_, typename Val_>
+  inline KeyVal del(const Index_ &index, const Val_ &val) {
+    uint32_t code = IHashFn::hash(index);
+    Guard guard(m_lock);
+
+    return delKeyVal__(find__(index, val, code));
+  }
+  template <typename Index_, typename Val_>
+  inline KeyVal del_(const Index_ &index, const Val_ &val) {
+    return delKeyVal__(find__(index, val, IHashFn::hash(index)));
+  }
+  template <typename Index_, typename Val_>
+  inline Key delKey(const Index_ &index, const Val_ &val) {
+    uint32_t code = IHashFn::hash(index);
+    Guard guard(m_lock);
+
+    return delKey__(find__(index, val, code));
+  }
+  template <typename Index_, typename Val_>
+  inline Val delVal(const Index_ &index, const Val_ &val) {
+    uint32_t code = IHashFn::hash(index);
+    Guard guard(m_lock);
+
+    return delVal__(find__(index, val, code));
+  }
+
+  void clean() {
+    Guard guard(m_lock);
+
+    destroy();
+    unsigned n = 1U<<(bits() - 4);
+    for (unsigned i = 0; i < n; i++) m_ctrl[i].init();
+    m_count = 0;
+    m_deleted = 0;
+  }
+
+  void telemetry(ZmHashTelemetry &data) const {
+    data.id = ID::id();
+    data.addr = (uintptr_t)this;
+    data.nodeSize = sizeof(Data) + 1;
+    data.loadFactor = loadFactor_();
+    data.count = m_count.load_();
+    unsigned bits = this->bits();
+    data.effLoadFactor = ((double)data.count) / ((double)(1<<bits));
+    data.resized = resized();
+    data.bits = bits;
+    data.cBits = 0;
+    data.linear = true;
+  }
+
+  auto iterator() { return Iterator(*this); }
+  template <typename Index_>
+  auto iterator(Index_ &&index) {
+    return IndexIterator(*this, ZuFwd<Index_>(index));
+  }
+
+  auto readIterator() const { return ReadIterator(*this); }
+  template <typename Index_>
+  auto readIterator(Index_ &&index) const {
+    return ReadIndexIterator(*this, ZuFwd<Index_>(index));
+  }
+
+private:
+  inline void startIterate(Iterator_ &iterator) {
+    iterator.lock(m_lock);
+    iterator.m_slot = -1;
+  }
+  inline void startIterate(IndexIterator_ &iterator) {
+    iterator.lock(m_lock);
+    iterator.m_slot = -1;
+    uint64_t h = mix(IHashFn::hash(iterator.m_index));
+    iterator.m_tag = tag(h);
+    iterator.m_probe = 0;
+    iterator.m_group = group(h);
+    const ZmGHash_Ctrl &ctrl = m_ctrl[iterator.m_group];
+    iterator.m_mask = ctrl.match(iterator.m_tag);
+    iterator.m_last = ctrl.matchEmpty();
+  }
+  inline void iterate_(Iterator_ &iterator) {
+    unsigned next = iterator.m_slot + 1;
+    unsigned n = 1U<<(bits() - 4);
+    for (unsigned g = next>>4; g < n; g++) {
+      unsigned mask = m_ctrl[g].matchFull();
+      if (g == (next>>4)) mask &= ~0U<<(next & 15);
+      if (mask) {
+	iterator.m_slot = (g<<4) | __builtin_ctz(mask);
+	return;
+      }
+    }
+    iterator.m_slot = -1;
+  }
+  inline void iterate_(IndexIterator_ &iterator) {
+    iterator.m_slot = -1;
+    if (iterator.m_group < 0) return;
+    unsigned n = 1U<<(bits() - 4);
+    unsigned group = iterator.m_group;
+    for (;;) {
+      while (unsigned mask = iterator.m_mask) {
+	iterator.m_mask = mask & (mask - 1);
+	unsigned slot = (group<<4) | __builtin_ctz(mask);
+	if (ICmp::equals(key(slot), iterator.m_index)) {
+	  iterator.m_slot = slot;
+	  return;
+	}
+      }
+      if (iterator.m_last || ++iterator.m_probe >= n) break;
+      iterator.m_group = group = probe(group, iterator.m_probe);
+      const ZmGHash_Ctrl &ctrl = m_ctrl[group];
+      iterator.m_mask = ctrl.match(iterator.m_tag);
+      iterator.m_last = ctrl.matchEmpty();
+    }
+    iterator.m_group = -1;
+  }
+  template <typename I>
+  inline KeyValRef iterate(I &iterator) {
+    iterate_(iterator);
+    return keyValRef__(iterator.m_slot);
+  }
+  template <typename I>
+  inline const Key &iterateKey(I &iterator) {
+    iterate_(iterator);
+    return key__(iterator.m_slot);
+  }
+  template <typename I>
+  inline const Val &iterateVal(I &iterator) {
+    iterate_(iterator);
+    return val__(iterator.m_slot);
+  }
+  void endIterate(Iterator_ &iterator) {
+    iterator.unlock(m_lock);
+    iterator.m_slot = -1;
+  }
+  // removal does not move other nodes, so iteration simply continues
+  void delIterate(Iterator_ &iterator) {
+    int slot = iterator.m_slot;
+    if (slot < 0 || !full(slot)) return;
+    del__(slot);
+  }
+  void delIterate(IndexIterator_ &iterator) {
+    int slot = iterator.m_slot;
+    if (slot < 0 || !full(slot)) return;
+    del__(slot);
+  }
+};
+
+#endif /* ZmGHash_HPP */
@@ -19,6 +19,11 @@
 
 // hash table (separately chained (linked lists), lock striping)
 
+// if the lock is a ZmSeqLock (e.g. ZmHashLock<ZmSeqLock<> >), lookups are
+// optimistic and lock-free - readers do not write to shared state and
+// retry if a concurrent writer intervened; unlinked nodes (which must be
+// reference-counted) and tables are reclaimed via ZmEpoch
+
 #ifndef ZmHash_HPP
 #define ZmHash_HPP
 
@@ -46,6 +51,8 @@
 #include <zlib/ZmLock.hpp>
 #include <zlib/ZmNoLock.hpp>
 #include <zlib/ZmLockTraits.hpp>
+#include <zlib/ZmSeqLock.hpp>
+#include <zlib/ZmEpoch.hpp>
 #include <zlib/ZmKVNode.hpp>
 
 #include <zlib/ZmHashMgr.hpp>
@@ -280,7 +287,8 @@ struct ZmHashNodeIsVal : public NTP {
   enum { NodeIsVal = NodeIsVal_ };
 };
 
-// ZmHashLock - the lock type used (ZmRWLock will permit concurrent reads)
+// ZmHashLock - the lock type used (ZmRWLock will permit concurrent reads,
+// ZmSeqLock<> will permit optimistic lock-free reads)
 template <class Lock_, class NTP = ZmHash_Defaults>
 struct ZmHashLock : public NTP {
   typedef Lock_ Lock;
@@ -336,6 +344,8 @@ public:
   typedef ZmGuard<Lock> Guard;
   typedef ZmReadGuard<Lock> ReadGuard;
 
+  enum { Optimistic = LockTraits::SeqLock };
+
 private:
   using Base::lockCode;
   using Base::lockSlot;
@@ -416,6 +426,9 @@ public:
     NodeRef;
   typedef Node *NodePtr;
 
+  // optimistic readers can hold unlinked nodes, so nodes must be ref-counted
+  ZuAssert(!Optimistic || ZuIsObject_<Object>::OK);
+
 private:
   // in order to support both intrusively reference-counted and plain node
   // objects, some overloading is required for ref/deref/delete
@@ -605,6 +618,7 @@ public:
     ZmHashMgr::del(this);
     clean();
     delete [] m_table;
+    if constexpr (Optimistic) ZmEpoch::reclaim();
   }
 
   ZuInline unsigned loadFactor_() const { return m_loadFactor; }
@@ -659,46 +673,101 @@ private:
 
     nodeRef(node);
     node->Fn::next(m_table[slot]);
-    m_table[slot] = ZuFwd<NodeRef_>(node);
+    publish(m_table[slot], node);
     m_count.store_(count + 1);
   }
 
+  // nodes must be fully initialized before optimistic readers see them
+  ZuInline void publish(NodePtr &slot, Node *node) {
+    if constexpr (Optimistic) {
+      ZmAtomic_release();
+      ZmAtomic_store(&slot, node);
+    } else
+      slot = node;
+  }
+
+  // unlinked nodes may still be referenced by optimistic readers
+  ZuInline void retire(Node *node) {
+    node->ref();
+    ZmEpoch::retire(node, [](void *ptr) {
+      Node *node = (Node *)ptr;
+      if (node->deref()) delete node;
+    });
+  }
+
+  // m_bits and m_table are read by optimistic readers without locking;
+  // resize() publishes the new table before the new bits
+  ZuInline unsigned bits_() const {
+    if constexpr (Optimistic) {
+      unsigned bits = ZmAtomic_load(&m_bits);
+      ZmAtomic_acquire();
+      return bits;
+    } else
+      return m_bits;
+  }
+  ZuInline NodePtr *table_() const {
+    if constexpr (Optimistic) {
+      NodePtr *table = ZmAtomic_load(&m_table);
+      ZmAtomic_acquire();
+      return table;
+    } else
+      return m_table;
+  }
+
+  // readers either acquire a read lock or, if the lock is a ZmSeqLock,
+  // search optimistically, retrying if a concurrent writer intervened
+  template <typename L>
+  ZuInline auto read_(uint32_t code, L l) const {
+    if constexpr (Optimistic) {
+      ZmEpoch::Guard epoch;
+      if (ZuLikely(epoch))
+	for (;;) {
+	  const Lock &lock = lockCode(code);
+	  uint32_t seq = lock.readSeq();
+	  auto r = l();
+	  if (ZuLikely(lock.validate(seq))) return r;
+	}
+    }
+    ReadGuard guard(lockCode(code));
+    return l();
+  }
+
 public:
   template <typename Index_>
   inline NodeRef find(const Index_ &index) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    return find_(index, code);
+    return read_(code, [&]() -> NodeRef { return find_(index, code); });
   }
   template <typename Index_>
   inline Node *findPtr(const Index_ &index) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    return find_(index, code);
+    return read_(code, [&]() { return find_(index, code); });
   }
   template <typename Index_>
   inline Key findKey(const Index_ &index) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    Node *node = find_(index, code);
-    if (ZuUnlikely(!node)) return Cmp::null();
-    return node->Node::key();
+    return read_(code, [&]() -> Key {
+      Node *node = find_(index, code);
+      if (ZuUnlikely(!node)) return Cmp::null();
+      return node->Node::key();
+    });
   }
   template <typename Index_>
   inline Val findVal(const Index_ &index) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    Node *node = find_(index, code);
-    if (ZuUnlikely(!node)) return ValCmp::null();
-    return node->Node::val();
+    return read_(code, [&]() -> Val {
+      Node *node = find_(index, code);
+      if (ZuUnlikely(!node)) return ValCmp::null();
+      return node->Node::val();
+    });
   }
 private:
   template <typename Index_>
   inline Node *find_(const Index_ &index, uint32_t code) const {
     Node *node;
-    unsigned slot = ZmHash_Bits::hashBits(code, m_bits);
+    unsigned slot = ZmHash_Bits::hashBits(code, bits_());
 
-    for (node = m_table[slot];
+    for (node = table_()[slot];
 	 node && !ICmp::equals(node->Node::key(), index);
 	 node = node->Fn::next());
 
@@ -709,39 +778,41 @@ public:
   template <typename Index_, typename Val_>
   inline NodeRef find(const Index_ &index, const Val_ &val) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    return findKeyVal_(index, val, code);
+    return read_(code, [&]() -> NodeRef {
+      return findKeyVal_(index, val, code);
+    });
   }
   template <typename Index_, typename Val_>
   inline Node *findPtr(const Index_ &index, const Val_ &val) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    return findKeyVal_(index, val, code);
+    return read_(code, [&]() { return findKeyVal_(index, val, code); });
   }
   template <typename Index_, typename Val_>
   inline Key findKey(const Index_ &index, const Val_ &val) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    Node *node = findKeyVal_(index, val, code);
-    if (ZuUnlikely(!node)) return Cmp::null();
-    return node->Node::key();
+    return read_(code, [&]() -> Key {
+      Node *node = findKeyVal_(index, val, code);
+      if (ZuUnlikely(!node)) return Cmp::null();
+      return node->Node::key();
+    });
   }
   template <typename Index_, typename Val_>
   inline Val findVal(const Index_ &index, const Val_ &val) const {
     uint32_t code = IHashFn::hash(index);
-    ReadGuard guard(lockCode(code));
-    Node *node = findKeyVal_(index, val, code);
-    if (ZuUnlikely(!node)) return ValCmp::null();
-    return node->Node::val();
+    return read_(code, [&]() -> Val {
+      Node *node = findKeyVal_(index, val, code);
+      if (ZuUnlikely(!node)) return ValCmp::null();
+      return node->Node::val();
+    });
   }
 private:
   template <typename Index_, typename Val_>
   inline Node *findKeyVal_(
       const Index_ &index, const Val_ &val, uint32_t code) const {
     Node *node;
-    unsigned slot = ZmHash_Bits::hashBits(code, m_bits);
+    unsigned slot = ZmHash_Bits::hashBits(code, bits_());
 
-    for (node = m_table[slot];
+    for (node = table_()[slot];
 	 node && (!ICmp::equals(node->Node::key(), index) ||
 		  !ValCmp::equals(node->Node::val(), val));
 	 node = node->Fn::next());
@@ -862,6 +933,8 @@ private:
 
     m_count.store_(count - 1);
 
+    if constexpr (Optimistic) retire(node);
+
     NodeRef *ZuMayAlias(ptr) = (NodeRef *)&node;
     return ZuMv(*ptr);
   }
@@ -897,6 +970,8 @@ private:
 
     m_count.store_(count - 1);
 
+    if constexpr (Optimistic) retire(node);
+
     NodeRef *ZuMayAlias(ptr) = (NodeRef *)&node;
     return ZuMv(*ptr);
   }
@@ -1011,6 +1086,7 @@ private:
       prevNode->Fn::next(node->Fn::next());
 
     iterator.m_node = prevNode;
+    if constexpr (Optimistic) retire(node);
     nodeDeref(node);
     nodeDelete(node);
     m_count.store_(count - 1);
@@ -1024,14 +1100,14 @@ public:
       Node *node, *prevNode;
 
       node = m_table[i];
+      m_table[i] = 0;
 
       while (prevNode = node) {
 	node = prevNode->Fn::next();
+	if constexpr (Optimistic) retire(prevNode);
 	nodeDeref(prevNode);
 	nodeDelete(prevNode);
       }
-
-      m_table[i] = 0;
     }
     m_count = 0;
 
@@ -1065,7 +1141,7 @@ private:
 
     unsigned n = (1U<<bits);
 
-    m_bits = ++bits;
+    ++bits;
 
     NodePtr *table = new NodePtr[1<<bits];
     memset(table, 0, sizeof(NodePtr)<<bits);
@@ -1079,8 +1155,18 @@ private:
 	node->Fn::next(table[j]);
 	table[j] = node;
       }
-    delete [] m_table;
-    m_table = table;
+    if constexpr (Optimistic) {
+      NodePtr *old = m_table;
+      ZmAtomic_release();
+      ZmAtomic_store(&m_table, table);
+      ZmAtomic_release();
+      ZmAtomic_store(&m_bits, bits);
+      ZmEpoch::retire(old, [](void *ptr) { delete [] (NodePtr *)ptr; });
+    } else {
+      delete [] m_table;
+      m_table = table;
+      m_bits = bits;
+    }
 
     unlockAll();
   }
@@ -21,6 +21,10 @@
 
 #include <stdlib.h>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #include <zlib/ZmHeap.hpp>
 
 #include <zlib/ZuPair.hpp>
@@ -249,6 +253,7 @@ void ZmHeapCache::init_()
   }
   m_info.size = (m_info.size + config.alignment - 1) & ~(config.alignment - 1);
   uint64_t len = config.cacheSize * m_info.size;
+  if (config.arena && initArena(len)) return;
   void *cache;
   if (!config.cpuset)
     cache = hwloc_alloc(ZmTopology::hwloc(), len);
@@ -268,12 +273,94 @@ void ZmHeapCache::init_()
 
 void ZmHeapCache::free_()
 {
-  if (m_cache)
-    hwloc_free(ZmTopology::hwloc(),
-	m_cache, m_info.config.cacheSize * m_info.size);
+  if (!m_cache) return;
+#ifndef _WIN32
+  if (m_info.config.arena) {
+    ::munmap(m_cache, (uintptr_t)m_end - (uintptr_t)m_cache);
+    return;
+  }
+#endif
+  hwloc_free(ZmTopology::hwloc(),
+      m_cache, m_info.config.cacheSize * m_info.size);
+}
+
+// arena mode reserves address space for the entire cache, rounded up to
+// whole slabs; slabs are mapped (and bound) on demand as blocks are carved,
+// so that the cache remains a single contiguous region
+bool ZmHeapCache::initArena(uint64_t len)
+{
+  ZmHeapConfig &config = m_info.config;
+#ifndef _WIN32
+  len = (len + SlabSize - 1) & ~(uint64_t)(SlabSize - 1);
+  if (len < (uint64_t)config.arena * SlabSize)
+    len = (uint64_t)config.arena * SlabSize;
+  void *p = ::mmap(0, len + SlabSize, PROT_NONE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (p == MAP_FAILED) { config.arena = 0; return false; }
+  // align to slab size and trim the excess
+  uintptr_t cache =
+    ((uintptr_t)p + SlabSize - 1) & ~(uintptr_t)(SlabSize - 1);
+  if (cache > (uintptr_t)p) ::munmap(p, cache - (uintptr_t)p);
+  if ((uintptr_t)p + SlabSize > cache)
+    ::munmap((void *)(cache + len), (uintptr_t)p + SlabSize - cache);
+  config.cacheSize = len / m_info.size;
+  m_end = (void *)(cache + len);
+  m_cache = (void *)cache;
+  m_arenaMapped = cache;
+  m_arenaNext = cache;
+  for (unsigned i = 0; i < config.arena; i++) if (!mapSlab()) break;
+  return true;
+#else
+  config.arena = 0;
+  return false;
+#endif
 }
 
-void *ZmHeapCache::alloc(ZmHeapStats &stats)
+// caller must hold m_arenaLock (or be initializing)
+bool ZmHeapCache::mapSlab()
+{
+#ifndef _WIN32
+  uintptr_t slab = m_arenaMapped.load_();
+  if (slab >= (uintptr_t)m_end) return false;
+  void *p = (void *)slab;
+  // explicit huge page, falling back to transparent huge pages
+#ifdef MAP_HUGETLB
+  if (::mmap(p, SlabSize, PROT_READ | PROT_WRITE,
+	MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB,
+	-1, 0) == MAP_FAILED)
+#endif
+  {
+    // a failed MAP_FIXED mmap() may have unmapped the range - remap it
+    if (::mmap(p, SlabSize, PROT_READ | PROT_WRITE,
+	  MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+      return false;
+#ifdef MADV_HUGEPAGE
+    ::madvise(p, SlabSize, MADV_HUGEPAGE);
+#endif
+  }
+  if (!!m_info.config.cpuset)
+    hwloc_set_area_membind(ZmTopology::hwloc(), p, SlabSize,
+	m_info.config.cpuset, HWLOC_MEMBIND_BIND, 0);
+  // pre-fault so that the slab is populated on the bound node
+  for (unsigned i = 0; i < SlabSize; i += 4096) ((volatile char *)p)[i] = 0;
+  m_arenaMapped = slab + SlabSize;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void *ZmHeapCache::carve()
+{
+  Guard guard(m_arenaLock);
+  uintptr_t p = m_arenaNext.load_(), q = p + m_info.size;
+  if (q > (uintptr_t)m_end) return 0;
+  while (q > m_arenaMapped.load_()) if (!mapSlab()) return 0;
+  m_arenaNext = q;
+  return (void *)p;
+}
+
+void *ZmHeapCache::alloc(ZmHeapStats &stats, ZmHeapMagazine &mag)
 {
 #ifdef ZmHeap_DEBUG
   {
@@ -283,16 +370,37 @@ void *ZmHeapCache::alloc(ZmHeapStats &stats)
   }
 #endif
   void *p;
+  if (ZuLikely(p = mag.head)) {
+    mag.head = *(void **)p;
+    --mag.count;
+    ++stats.cacheAllocs;
+    return p;
+  }
+  if (unsigned n = m_info.config.magazine) {
+    if (ZuLikely(!m_info.sharded)) {
+      if (ZuLikely(p = allocN_(mag, n > 1 ? (n>>1) : 1))) {
+	++stats.cacheAllocs;
+	return p;
+      }
+      goto heap;
+    }
+  }
   if (ZuLikely(p = alloc_())) {
     ++stats.cacheAllocs;
     return p;
   }
+heap:
+  if (m_info.config.arena &&
+      m_arenaNext.load_() < (uintptr_t)m_end && (p = carve())) {
+    ++stats.cacheAllocs;
+    return p;
+  }
   p = ::malloc(m_info.size);
   ++stats.heapAllocs;
   return p;
 }
 
-void ZmHeapCache::free(ZmHeapStats &stats, void *p)
+void ZmHeapCache::free(ZmHeapStats &stats, ZmHeapMagazine &mag, void *p)
 {
   if (ZuUnlikely(!p)) return;
 #ifdef ZmHeap_DEBUG
@@ -301,10 +409,30 @@ void ZmHeapCache::free(ZmHeapStats &stats, void *p)
     if (ZuUnlikely(fn = m_traceFreeFn)) (*fn)(m_info.id, m_info.size);
   }
 #endif
+  if (unsigned n = m_info.config.magazine) {
+    // only blocks from this partition's cache are retained by the magazine
+    void *cache = m_cache;
+    if (ZuLikely(!m_info.sharded && cache && p >= cache && p < m_end)) {
+      if (ZuUnlikely(mag.count >= n)) freeN_(mag, n > 1 ? (n>>1) : 1);
+      *(void **)p = mag.head;
+      mag.head = p;
+      ++mag.count;
+      ++stats.frees;
+      return;
+    }
+  }
   free_(this, p);
   ++stats.frees;
 }
 
+void ZmHeapCache::retire(const ZmHeapStats &stats, ZmHeapMagazine &mag)
+{
+  if (mag.count) freeN_(mag, mag.count);
+  m_retiredHeapAllocs += stats.heapAllocs;
+  m_retiredCacheAllocs += stats.cacheAllocs;
+  m_retiredFrees += stats.frees;
+}
+
 void ZmHeapCache::free_(ZmHeapCache *self, void *p)
 {
   if (ZuLikely(self->m_info.sharded)) {
@@ -341,7 +469,9 @@ void ZmHeapCache::free_(ZmHeapCache *self, void *p)
 
 void ZmHeapCache::allStats() const
 {
-  m_stats = {};
+  m_stats.heapAllocs = m_retiredHeapAllocs.load_();
+  m_stats.cacheAllocs = m_retiredCacheAllocs.load_();
+  m_stats.frees = m_retiredFrees.load_();
   StatsFn fn = StatsFn::Lambda<ZuNull>::fn(
       [this](const ZmHeapStats &s) {
 	m_stats.heapAllocs += s.heapAllocs;
@@ -365,4 +495,12 @@ void ZmHeapCache::telemetry(ZmHeapTelemetry &data) const
   data.partition = info.partition;
   data.sharded = info.sharded;
   data.alignment = info.config.alignment;
+  if (info.config.arena) {
+    data.slabs =
+      (m_arenaMapped.load_() - (uintptr_t)m_cache) / (unsigned)SlabSize;
+    data.slabFill = m_arenaNext.load_() - (uintptr_t)m_cache;
+  } else {
+    data.slabs = 0;
+    data.slabFill = 0;
+  }
 }
@@ -63,6 +63,8 @@ struct ZmHeapConfig {
   uint64_t	cacheSize;
   ZmBitmap	cpuset;
   unsigned	telFreq;
+  unsigned	magazine;	// per-thread magazine size (0 - disabled)
+  unsigned	arena;		// preallocated huge-page slabs (0 - disabled)
 };
 
 struct ZmHeapInfo {
@@ -81,7 +83,8 @@ struct ZmHeapStats {
 
 // display sequence:
 //   id, size, alignment, partition, sharded,
-//   cacheSize, cpuset, cacheAllocs, heapAllocs, frees, allocated (*)
+//   cacheSize, cpuset, cacheAllocs, heapAllocs, frees, allocated (*),
+//   slabs, slabFill
 // derived display fields:
 //   allocated = (heapAllocs + cacheAllocs) - frees
 struct ZmHeapTelemetry {
@@ -91,10 +94,19 @@ struct ZmHeapTelemetry {
   uint64_t	cacheAllocs;	// graphable (*)
   uint64_t	heapAllocs;	// graphable (*)
   uint64_t	frees;		// graphable
+  uint64_t	slabFill;	// graphable - bytes carved from slabs
   uint32_t	size;
   uint16_t	partition;
   uint8_t	sharded;
   uint8_t	alignment;
+  uint32_t	slabs;		// huge-page slabs mapped (arena mode)
+};
+
+// per-thread magazine - bounded LIFO stack of blocks belonging to the
+// thread's own cache, refilled from and returned to the cache in bulk
+struct ZmHeapMagazine {
+  void		*head = nullptr;
+  unsigned	count = 0;
 };
 
 // cache (LIFO free list) of fixed-size blocks; one per CPU set / NUMA node
@@ -105,6 +117,7 @@ template <class, unsigned> friend class ZmHeap;
 template <class, unsigned> friend class ZmHeapCacheT;
 
   enum { CacheLineSize = ZmPlatform::CacheLineSize };
+  enum { SlabSize = 2<<20 };	// arena slab size - 2MB huge page
 
   typedef ZmPLock Lock;
   typedef ZmGuard<Lock> Guard;
@@ -165,8 +178,14 @@ private:
   void init_();
   void free_();
 
-  void *alloc(ZmHeapStats &stats);
-  void free(ZmHeapStats &stats, void *p);
+  // arena mode - blocks are carved contiguously from slabs
+  bool initArena(uint64_t len);
+  bool mapSlab();
+  void *carve();
+
+  void *alloc(ZmHeapStats &stats, ZmHeapMagazine &mag);
+  void free(ZmHeapStats &stats, ZmHeapMagazine &mag, void *p);
+  void retire(const ZmHeapStats &stats, ZmHeapMagazine &mag);
 
   static void free_(ZmHeapCache *, void *p);
 
@@ -199,6 +218,42 @@ private:
     m_head.store_((uintptr_t)p);
   }
 
+  // bulk operations used by magazines - single CAS per batch
+
+  // pop up to n blocks, returning the first; the remainder
+  // refill the (empty) magazine
+  inline void *allocN_(ZmHeapMagazine &mag, unsigned n) {
+    uintptr_t p;
+  loop:
+    p = m_head.load_();
+    if (ZuUnlikely(!p)) return 0;
+    if (ZuUnlikely(p & 1)) { ZmAtomic_acquire(); goto loop; }
+    if (ZuUnlikely(m_head.cmpXch(p | 1, p) != p)) goto loop;
+    uintptr_t q = p, r;
+    unsigned i = 1;
+    while (i < n && (r = ((ZmAtomic<uintptr_t> *)q)->load_())) q = r, ++i;
+    m_head = ((ZmAtomic<uintptr_t> *)q)->load_();
+    if (i > 1) {
+      mag.head = (void *)((ZmAtomic<uintptr_t> *)p)->load_();
+      mag.count = i - 1;
+      ((ZmAtomic<uintptr_t> *)q)->store_(0);
+    }
+    return (void *)p;
+  }
+  // push the first n blocks of the magazine
+  inline void freeN_(ZmHeapMagazine &mag, unsigned n) {
+    uintptr_t p = (uintptr_t)mag.head, q = p;
+    for (unsigned i = 1; i < n; i++) q = *(uintptr_t *)q;
+    mag.head = (void *)*(uintptr_t *)q;
+    mag.count -= n;
+    uintptr_t r;
+  loop:
+    r = m_head.load_();
+    if (r & 1) { ZmAtomic_acquire(); goto loop; }
+    ((ZmAtomic<uintptr_t> *)q)->store_(r);
+    if (m_head.cmpXch(p, r) != r) goto loop;
+  }
+
   void allStats() const;
 
   // cache, end, next are guarded by ZmHeapMgr
@@ -214,12 +269,22 @@ private:
   void			*m_cache = 0;	// bound memory region
   void			*m_end = 0;	// end of memory region
 
+  // arena - slabs are mapped within [m_cache, m_end) on demand
+  Lock			m_arenaLock;
+  ZmAtomic<uintptr_t>	m_arenaNext = 0;	// next block to carve
+  ZmAtomic<uintptr_t>	m_arenaMapped = 0;	// end of mapped slabs
+
 #ifdef ZmHeap_DEBUG
   TraceFn		m_traceAllocFn;
   TraceFn		m_traceFreeFn;
 #endif
 
   mutable ZmHeapStats	m_stats;	// aggregated on demand
+
+  // stats retired by exited threads
+  ZmAtomic<uint64_t>	m_retiredHeapAllocs = 0;
+  ZmAtomic<uint64_t>	m_retiredCacheAllocs = 0;
+  ZmAtomic<uint64_t>	m_retiredFrees = 0;
 };
 
 class ZmAPI ZmHeapMgr {
@@ -231,7 +296,7 @@ template <class, unsigned> friend class ZmHeapCacheT;
     void print() {
       m_stream <<
 	"ID,size,partition,sharded,alignment,cacheSize,cpuset,"
-	"cacheAllocs,heapAllocs,frees\n";
+	"cacheAllocs,heapAllocs,frees,slabs,slabFill\n";
       ZmHeapMgr::all(ZmFn<ZmHeapCache *>::Member<&CSV_::print_>::fn(this));
     }
     void print_(ZmHeapCache *c) {
@@ -247,7 +312,9 @@ template <class, unsigned> friend class ZmHeapCacheT;
 	ZmBitmap(data.cpuset) << ',' <<
 	ZuBoxed(data.cacheAllocs) << ',' <<
 	ZuBoxed(data.heapAllocs) << ',' <<
-	ZuBoxed(data.frees) << '\n';
+	ZuBoxed(data.frees) << ',' <<
+	ZuBoxed(data.slabs) << ',' <<
+	ZuBoxed(data.slabFill) << '\n';
     }
 
   private:
@@ -312,18 +379,23 @@ private:
 	  ZuConversion<ZmHeapSharded, ID>::Base,
 	  AllStatsFn::Ptr<&allStats>::fn())), m_stats{} { }
 
+public:
+  ~ZmHeapCacheT() { m_cache->retire(m_stats, m_magazine); }
+
+private:
   ZuInline static ZmHeapCacheT *instance() { return TLS::instance(); }
   ZuInline static void *alloc() {
     ZmHeapCacheT *self = instance();
-    return self->m_cache->alloc(self->m_stats);
+    return self->m_cache->alloc(self->m_stats, self->m_magazine);
   }
   ZuInline static void free(void *p) {
     ZmHeapCacheT *self = instance();
-    self->m_cache->free(self->m_stats, p);
+    self->m_cache->free(self->m_stats, self->m_magazine, p);
   }
 
-  ZmHeapCache	*m_cache;
-  ZmHeapStats	m_stats;
+  ZmRef<ZmHeapCache>	m_cache;
+  ZmHeapStats		m_stats;
+  ZmHeapMagazine	m_magazine;
 };
 
 // ZmHeap_Size returns a size that is minimum sizeof(uintptr_t),
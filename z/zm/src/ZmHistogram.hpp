@@ -0,0 +1,109 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// log-linear (HDR-style) histogram of non-negative integer values
+
+// values below 2^SubBits are counted exactly; above that, each power of
+// two is divided into 2^SubBits linear sub-buckets, so that the relative
+// error is at most 1/2^SubBits (~3% with the default of 5) across the
+// entire range [0, 2^MaxBits); larger values are clamped
+//
+// record() is branch-light and lock-free, and is intended to be called by
+// a single writer thread; other threads can read percentiles concurrently,
+// accepting that results may be slightly stale
+
+#ifndef ZmHistogram_HPP
+#define ZmHistogram_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <string.h>
+
+#include <zlib/ZuInt.hpp>
+
+template <unsigned SubBits_ = 5, unsigned MaxBits_ = 40>
+class ZmHistogram {
+  ZmHistogram(const ZmHistogram &);
+  ZmHistogram &operator =(const ZmHistogram &);	// prevent mis-use
+
+public:
+  enum { SubBits = SubBits_, MaxBits = MaxBits_ };
+  enum { Sub = 1U<<SubBits, Mask = Sub - 1 };
+  enum { N = (MaxBits - SubBits + 1)<<SubBits };	// number of buckets
+
+  ZuInline ZmHistogram() { reset(); }
+
+  ZuInline void record(uint64_t v) {
+    ++m_counts[index(v)];
+    ++m_count;
+    if (ZuUnlikely(v > m_max)) m_max = v;
+  }
+
+  void reset() {
+    memset(m_counts, 0, sizeof(m_counts));
+    m_count = 0;
+    m_max = 0;
+  }
+
+  ZuInline uint64_t count() const { return m_count; }
+  ZuInline uint64_t max() const { return m_max; }
+
+  // highest value equivalent to the p'th percentile (0 <= p <= 100)
+  uint64_t percentile(double p) const {
+    uint64_t total = 0;
+    for (unsigned i = 0; i < N; i++) total += m_counts[i];
+    if (!total) return 0;
+    uint64_t target = (uint64_t)((p / 100.0) * (double)total + 0.5);
+    if (!target) target = 1;
+    uint64_t n = 0;
+    for (unsigned i = 0; i < N; i++)
+      if ((n += m_counts[i]) >= target) {
+	uint64_t v = value(i);
+	return v < m_max ? v : m_max;
+      }
+    return m_max;
+  }
+
+  ZuInline static unsigned index(uint64_t v) {
+    if (v < Sub) return v;
+    if (ZuUnlikely(v >= ((uint64_t)1<<MaxBits)))
+      v = ((uint64_t)1<<MaxBits) - 1;
+    unsigned shift = (63 - __builtin_clzll(v)) - SubBits;
+    return ((shift + 1)<<SubBits) + ((unsigned)(v>>shift) & Mask);
+  }
+  // highest value that maps to bucket i
+  ZuInline static uint64_t value(unsigned i) {
+    if (i < Sub) return i;
+    unsigned shift = (i>>SubBits) - 1;
+    return (((uint64_t)((i & Mask) | Sub) + 1)<<shift) - 1;
+  }
+
+private:
+  uint64_t	m_counts[N];
+  uint64_t	m_count;
+  uint64_t	m_max;
+};
+
+#endif /* ZmHistogram_HPP */
@@ -150,7 +150,7 @@ public:
   ZuInline ZmKVNode(Key__ &&key) : m_key(ZuFwd<Key__>(key)) { }
   template <typename Key__, typename Val_>
   ZuInline ZmKVNode(Key__ &&key, Val_ &&val) :
-    m_key(ZuFwd<Key__>(key)), Val(ZuFwd<Val_>(val)) { }
+    Val(ZuFwd<Val_>(val)), m_key(ZuFwd<Key__>(key)) { }
 
   ZuInline const Key &key() const { return m_key; }
   ZuInline Key &key() { return m_key; }
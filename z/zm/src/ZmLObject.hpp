@@ -0,0 +1,114 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// intrusively reference-counted object (base class)
+// - non-atomic reference count (thread-confined)
+
+// drop-in alternative to ZmObject for objects that are only ever referenced
+// from a single thread (e.g. the contents of a shard's data structures);
+// ZmRef<T> is used as with ZmObject, but ref() and deref() are plain
+// increments and decrements rather than locked instructions
+//
+// in debug builds (ZmObject_DEBUG) the owning thread is bound by the first
+// ref() and every subsequent ref() and deref() asserts that it is called
+// from that thread; the binding is released when the count drops to zero,
+// so an unreferenced object may be handed off to another thread
+
+#ifndef ZmLObject_HPP
+#define ZmLObject_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <stddef.h>
+
+#include <zlib/ZmObject_.hpp>
+#include <zlib/ZmLObject_.hpp>
+
+class ZmLObject : public ZmObject_Debug, public ZmLObject_Owner {
+  ZmLObject(const ZmLObject &) = delete;
+  ZmLObject &operator =(const ZmLObject &) = delete;
+
+public:
+  ZuInline ZmLObject()  : m_refCount(0) { }
+
+  ZuInline ~ZmLObject() {
+#ifdef ZmObject_DEBUG
+    this->del_();
+#endif
+  }
+
+  ZuInline int refCount() const { return m_refCount; }
+
+#ifdef ZmObject_DEBUG
+  inline void ref(const void *referrer = 0) const
+#else
+  ZuInline void ref() const
+#endif
+  {
+#ifdef ZmObject_DEBUG
+    if (ZuUnlikely(this->deleted_())) return;
+    this->bind_(m_refCount);
+    if (ZuUnlikely(this->debugging_())) ZmObject_ref(this, referrer);
+#endif
+    this->ref_();
+  }
+#ifdef ZmObject_DEBUG
+  inline bool deref(const void *referrer = 0) const
+#else
+  ZuInline bool deref() const
+#endif
+  {
+#ifdef ZmObject_DEBUG
+    if (ZuUnlikely(this->deleted_())) return false;
+    this->unbind_(m_refCount);
+    if (ZuUnlikely(this->debugging_())) ZmObject_deref(this, referrer);
+#endif
+    return this->deref_();
+  }
+
+#ifdef ZmObject_DEBUG
+  inline void mvref(const void *prev, const void *next) const {
+    if (ZuUnlikely(this->debugging_())) {
+      ZmObject_ref(this, next);
+      ZmObject_deref(this, prev);
+    }
+  }
+#endif
+
+  // apps occasionally need to manipulate the refCount directly
+  ZuInline void ref_() const { ++m_refCount; }
+  ZuInline void ref2_() const { m_refCount += 2; }
+  ZuInline bool deref_() const { return !--m_refCount; }
+
+private:
+#ifdef ZmObject_DEBUG
+  ZuInline bool deleted_() const { return m_refCount < 0; }
+  ZuInline void del_() const { m_refCount = -1; }
+#endif
+
+  mutable int		m_refCount;
+};
+
+#endif /* ZmLObject_HPP */
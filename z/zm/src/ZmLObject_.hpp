@@ -0,0 +1,66 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// debug-mode owner thread binding for thread-confined (non-atomically)
+// reference-counted objects - ZmLObject, ZmLPolymorph
+
+#ifndef ZmLObject__HPP
+#define ZmLObject__HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#ifdef ZmObject_DEBUG
+#include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmAssert.hpp>
+#endif
+
+#ifdef ZmObject_DEBUG
+class ZmLObject_Owner {
+public:
+  ZuInline ZmLObject_Owner() : m_owner(0) { }
+
+  ZuInline ZmPlatform::ThreadID owner() const { return m_owner; }
+
+protected:
+  // the first reference binds the object to the calling thread
+  ZuInline void bind_(int refCount) const {
+    ZmPlatform::ThreadID tid = ZmPlatform::getTID();
+    if (!refCount) { m_owner = tid; return; }
+    ZmAssert(m_owner == tid);
+  }
+  // the last dereference releases it
+  ZuInline void unbind_(int refCount) const {
+    ZmAssert(m_owner == ZmPlatform::getTID());
+    if (refCount == 1) m_owner = 0;
+  }
+
+private:
+  mutable ZmPlatform::ThreadID	m_owner;
+};
+#else
+class ZmLObject_Owner { };
+#endif
+
+#endif /* ZmLObject__HPP */
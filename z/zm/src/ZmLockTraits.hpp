@@ -32,7 +32,7 @@
 
 template <class Lock_> struct ZmGenericLockTraits {
   typedef Lock_ Lock;
-  enum { CanTry = 1, Recursive = 1, RWLock = 0 };
+  enum { CanTry = 1, Recursive = 1, RWLock = 0, SeqLock = 0 };
   ZuInline static void lock(Lock &l) { l.lock(); }
   ZuInline static int trylock(Lock &l) { return l.trylock(); }
   ZuInline static void unlock(Lock &l) { l.unlock(); }
@@ -0,0 +1,141 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// MCS queue lock (Mellor-Crummey & Scott, 1991)
+
+// fair FIFO spinlock; each waiter enqueues a cache-line-sized node and
+// spins on its own node rather than on the shared lock word, so that
+// a hand-off invalidates a single waiter's cache line instead of
+// broadcasting to every waiter (cf. ZmPLock's ticket lock, where every
+// release is observed by all waiters); the lock itself is a single
+// pointer to the tail of the queue
+//
+// nodes are allocated from a per-thread free list (one node per lock
+// concurrently held by the thread), and the owner's node is retained in
+// the lock so that unlock() requires no argument
+//
+// waiters yield after spinning for a bounded interval, but hand-off is
+// strictly FIFO, so performance degrades severely when threads outnumber
+// CPUs (a preempted waiter stalls every waiter queued behind it); prefer
+// ZmALock where threads may be oversubscribed
+
+#ifndef ZmMCSLock_HPP
+#define ZmMCSLock_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmLockTraits.hpp>
+
+class ZmMCSLock {
+  ZmMCSLock(const ZmMCSLock &);
+  ZmMCSLock &operator =(const ZmMCSLock &);	// prevent mis-use
+
+  enum { Spin = 1000 };		// spin iterations before yielding
+
+  struct alignas(64) Node {
+    ZmAtomic<Node *>	next;
+    ZmAtomic<uint32_t>	locked;
+    Node		*free = nullptr;
+  };
+
+  struct Nodes {
+    ~Nodes() {
+      while (Node *node = free) { free = node->free; delete node; }
+    }
+    ZuInline Node *alloc() {
+      Node *node = free;
+      if (ZuLikely(node)) { free = node->free; return node; }
+      return new Node();
+    }
+    ZuInline void free_(Node *node) { node->free = free; free = node; }
+
+    Node	*free = nullptr;
+  };
+
+  ZuInline static Nodes &nodes() {
+    thread_local Nodes nodes;
+    return nodes;
+  }
+
+public:
+  ZuInline ZmMCSLock() { }
+
+  ZuInline void lock() {
+    Node *node = nodes().alloc();
+    node->next.store_(nullptr);
+    node->locked.store_(1);
+    Node *prev = m_tail.xch(node); // full barrier
+    if (ZuUnlikely(prev)) {
+      prev->next = node; // release
+      unsigned i = 0;
+      while (node->locked) { // acquire
+	if (ZuLikely(++i < Spin))
+	  ZmPlatform::pause();
+	else {
+	  i = 0;
+	  ZmPlatform::yield();
+	}
+      }
+    }
+    m_owner = node;
+  }
+  ZuInline int trylock() {
+    Node *node = nodes().alloc();
+    node->next.store_(nullptr);
+    if (m_tail.cmpXch(node, nullptr)) { // full barrier
+      nodes().free_(node);
+      return -1;
+    }
+    m_owner = node;
+    return 0;
+  }
+  ZuInline void unlock() {
+    Node *node = m_owner;
+    Node *next = node->next; // acquire
+    if (!next) {
+      if (m_tail.cmpXch(nullptr, node) == node) { // full barrier
+	nodes().free_(node);
+	return;
+      }
+      // successor is between enqueueing and linking - wait for it
+      while (!(next = node->next)) ZmPlatform::pause();
+    }
+    next->locked = 0; // release - hand off
+    nodes().free_(node);
+  }
+
+private:
+  ZmAtomic<Node *>	m_tail;
+  Node			*m_owner = nullptr;
+};
+
+template <>
+struct ZmLockTraits<ZmMCSLock> : public ZmGenericLockTraits<ZmMCSLock> {
+  enum { CanTry = 1, Recursive = 0, RWLock = 0 };
+};
+
+#endif /* ZmMCSLock_HPP */
@@ -50,7 +50,9 @@
 //
 // In general, we optimize for the uncontended case, while moderating
 // the penalty of the contended case; furthermore the most common use-case
-// in Z is assumed to be 2 threads rather than 3+
+// in Z is assumed to be 2 threads rather than 3+; see ZmMCSLock (fair,
+// local-spinning) and ZmALock (adaptive spin-then-block) for alternatives
+// that scale better with 3+ contending threads and oversubscription
 
 #ifndef _WIN32
 #if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
@@ -162,6 +162,15 @@ public:
   ZuInline static void yield() { ::Sleep(0); }
 #endif
 
+// spin-wait hint (busy-wait loops)
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+  ZuInline static void pause() { __builtin_ia32_pause(); }
+#elif defined(_MSC_VER)
+  ZuInline static void pause() { YieldProcessor(); }
+#else
+  ZuInline static void pause() { __asm__ __volatile__("" ::: "memory"); }
+#endif
+
 // (hard) exit process
 #ifndef _WIN32
   ZuInline static void exit(int code) { ::_exit(code); }
@@ -162,7 +162,10 @@ public:
 		ZmHashLock<ZmNoLock,
 		  ZmHashHeapID<HeapID> > > > > ID2Key;
 
-  inline ZmQueue() : m_head(0), m_tail(0) { }
+  inline ZmQueue() : m_head(0), m_tail(0) {
+    m_key2id = new Key2ID();
+    m_id2key = new ID2Key();
+  }
 
   template <typename ...Args>
   inline ZmQueue(ID initialID, const ZmHashParams &params, Args &&... args) :
@@ -52,6 +52,7 @@
 
 struct ZmRBTree_Defaults {
   typedef ZuNull Val;
+  typedef ZuNull Accessor;
   template <typename T> struct CmpT { typedef ZuCmp<T> Cmp; };
   template <typename T> struct ICmpT { typedef ZuCmp<T> ICmp; };
   template <typename T> struct IndexT { typedef T Index; };
@@ -88,8 +89,9 @@ struct ZmRBTreeICmp : public NTP {
 // common use case - the key is a struct and the index is a data member
 // uncommon use case - the index is calculated from the key in some way
 // pass an Accessor to override the comparator and index type
-template <class Accessor, class NTP = ZmRBTree_Defaults>
+template <class Accessor_, class NTP = ZmRBTree_Defaults>
 struct ZmRBTreeIndex : public NTP {
+  typedef Accessor_ Accessor;
   template <typename T> struct CmpT {
     typedef typename ZuIndex<Accessor>::template CmpT<T> Cmp;
   };
@@ -354,6 +354,71 @@ public:
     this->inBytes().store_(this->inBytes().load_() + Size);
   }
 
+  // batch writer - reserves up to n contiguous slots (n >= 1) with a
+  // single CAS on head, returning the first slot and updating n with
+  // the number of slots actually reserved; slot i is located at
+  // (uint8_t *)ptr + i * Size; runs never wrap past the end of the buffer
+  ZuInline void *pushN(unsigned &n) { return pushN_<1>(n); }
+  ZuInline void *tryPushN(unsigned &n) { return pushN_<0>(n); }
+  template <bool Wait> inline void *pushN_(unsigned &n) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Write);
+    ZmAssert(n);
+
+  retry:
+    uint32_t head_ = this->head().load_();
+    if (ZuUnlikely(head_ & EndOfFile_)) return 0;
+    uint32_t head = head_ & ~Mask;
+    uint32_t tail = this->tail(); // acquire
+    uint32_t tail_ = tail & ~Mask;
+    if (ZuUnlikely((head ^ tail_) == Wrapped)) {
+      ++m_full;
+      if constexpr (!Wait) return 0;
+      if (ZuUnlikely(!m_params.ll()))
+	if (this->ZmRing_wait(Tail, this->tail(), tail) != OK) return 0;
+      goto retry;
+    }
+
+    unsigned avail;
+    if ((head ^ tail_) & Wrapped)
+      avail = (tail_ & ~Wrapped) - (head & ~Wrapped);
+    else
+      avail = size() - (head & ~Wrapped);
+    avail /= Size;
+    if (avail > n) avail = n;
+
+    head += avail * Size;
+    if ((head & ~Wrapped) >= size()) head = (head ^ Wrapped) - size();
+
+    if (ZuUnlikely(this->head().cmpXch(head, head_) != head_))
+      goto retry;
+
+    n = avail;
+    ZmAtomic<uint32_t> *ptr =
+      (ZmAtomic<uint32_t> *)&((uint8_t *)data())[head_ & ~(Wrapped | Mask)];
+    return (void *)&ptr[2];
+  }
+  inline void push2N(void *ptr_, unsigned n) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Write);
+
+    uint8_t *ptr = (uint8_t *)&((ZmAtomic<uint32_t> *)ptr_)[-2];
+
+    if (ZuUnlikely(!m_params.ll())) {
+      for (unsigned i = 0; i < n; i++, ptr += Size) {
+	ZmAtomic<uint32_t> *hdr = (ZmAtomic<uint32_t> *)ptr;
+	if (ZuUnlikely(hdr->xch(Ready) & Waiting))
+	  this->ZmRing_wake(Head, *hdr, 1);
+      }
+    } else {
+      for (unsigned i = 0; i < n; i++, ptr += Size)
+	*(ZmAtomic<uint32_t> *)ptr = Ready; // release
+    }
+
+    this->inCount().store_(this->inCount().load_() + n);
+    this->inBytes().store_(this->inBytes().load_() + n * Size);
+  }
+
   void eof(bool b = true) {
     ZmAssert(m_ctrl);
     ZmAssert(m_flags & Write);
@@ -431,6 +496,63 @@ public:
     this->outBytes().store_(this->outBytes().load_() + Size);
   }
 
+  // batch reader - blocks (subject to timeout) until at least one item
+  // is ready, then returns the first of up to max contiguous ready items,
+  // updating n with the count; item i is located at
+  // (uint8_t *)ptr + i * Size; tail is published once by shift2N(n)
+  inline T *shiftN(unsigned max, unsigned &n) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+    ZmAssert(max);
+
+    uint32_t tail = this->tail().load_() & ~Mask;
+    uint8_t *data = (uint8_t *)this->data();
+    ZmAtomic<uint32_t> *ptr =
+      (ZmAtomic<uint32_t> *)&data[tail & ~Wrapped];
+  retry:
+    uint32_t header = *ptr; // acquire
+    if (!(header & ~Waiting)) {
+      if (ZuUnlikely(!m_params.ll()))
+	if (this->ZmRing_wait(Head, *ptr, header) != OK) return 0;
+      goto retry;
+    }
+
+    if (ZuUnlikely(header & EndOfFile_)) return 0;
+    ptr->store_(0);
+
+    {
+      unsigned end = (size() - (tail & ~Wrapped)) / Size;
+      if (max > end) max = end;
+    }
+    unsigned i;
+    for (i = 1; i < max; i++) {
+      ZmAtomic<uint32_t> *next =
+	(ZmAtomic<uint32_t> *)((uint8_t *)ptr + i * Size);
+      header = *next; // acquire
+      if (!(header & Ready) || (header & EndOfFile_)) break;
+      next->store_(0);
+    }
+    n = i;
+    return (T *)&ptr[2];
+  }
+  inline void shift2N(unsigned n) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+
+    uint32_t tail = this->tail().load_() & ~Mask;
+    tail += n * Size;
+    if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
+
+    if (ZuUnlikely(!m_params.ll())) {
+      if (ZuUnlikely(this->tail().xch(tail & ~Waiting) & Waiting))
+	this->ZmRing_wake(Tail, this->tail(), n);
+    } else
+      this->tail() = tail; // release
+
+    this->outCount().store_(this->outCount().load_() + n);
+    this->outBytes().store_(this->outBytes().load_() + n * Size);
+  }
+
   // can be called by a reader after shift() returns 0; returns
   // EndOfFile (< 0), or amount of data remaining in ring buffer (>= 0)
   int readStatus() const {
@@ -30,6 +30,27 @@
 
 using namespace ZmSchedState;
 
+#ifdef ZmScheduler_HISTOGRAMS
+// each job is wrapped as it is enqueued, recording its dwell time (enqueue
+// to dequeue) and execution time in the worker thread's histograms
+static thread_local ZmThreadHistograms *ZmScheduler_histograms = nullptr;
+
+static ZmFn<> ZmScheduler_stamp(ZmFn<> &fn)
+{
+  return ZmFn<>{[fn = ZuMv(fn), stamp = ZmTimeFast().nanosecs()]() {
+    ZmThreadHistograms *histograms = ZmScheduler_histograms;
+    if (ZuUnlikely(!histograms)) { fn(); return; }
+    int64_t start = ZmTimeFast().nanosecs();
+    histograms->dwell.record(start > stamp ? start - stamp : 0);
+    fn();
+    int64_t end = ZmTimeFast().nanosecs();
+    histograms->exec.record(end > start ? end - start : 0);
+  }};
+}
+#else
+ZuInline static ZmFn<> &&ZmScheduler_stamp(ZmFn<> &fn) { return ZuMv(fn); }
+#endif
+
 ZmScheduler::ZmScheduler(ZmSchedParams params) :
   m_params(ZuMv(params)),
   m_stateCond(m_stateLock),
@@ -67,9 +88,16 @@ ZmScheduler::ZmScheduler(ZmSchedParams params) :
     // if ((r = ring.attach()) != Ring::OK) throw ZmRingError(r);
     m_threads[i].overRing.init(
 	ZmDRingParams().initial(0).increment(OverRing_Increment));
-    if (!m_params.thread(tid).isolated())
+    if (m_params.stealing())
+      m_threads[i].stealRing.init(
+	  ZmDRingParams().initial(0).increment(OverRing_Increment));
+    if (!m_params.thread(tid).isolated()) {
+      m_threads[i].worker = m_nWorkers;
       m_workers[m_nWorkers++] = &m_threads[i];
+    }
   }
+  if (m_params.timerWheel())
+    m_wheel.init(ZmTimeNow(), m_params.quantum());
 }
 
 ZmScheduler::~ZmScheduler()
@@ -131,9 +159,14 @@ void ZmScheduler::start()
     m_stateCond.broadcast();
   }
 
-  m_thread = ZmThread(0,
-      ZmFn<>::Member<&ZmScheduler::timer>::fn(this),
-      m_params.thread(0));
+  if (m_params.timerWheel())
+    m_thread = ZmThread(0,
+	ZmFn<>::Member<&ZmScheduler::wheelTimer>::fn(this),
+	m_params.thread(0));
+  else
+    m_thread = ZmThread(0,
+	ZmFn<>::Member<&ZmScheduler::timer>::fn(this),
+	m_params.thread(0));
 
   runThreads();
 
@@ -329,9 +362,72 @@ void ZmScheduler::timer()
     }
   }
 }
+void ZmScheduler::wheelTimer()
+{
+  for (;;) {
+    {
+      ZmGuard<ZmLock> stateGuard(m_stateLock);
+
+      if (m_state == Stopping || m_state == Stopped) return;
+    }
+
+    {
+      ZmTime next;
+
+      {
+	ZmGuard<ZmPLock> scheduleGuard(m_scheduleLock);
+	m_wheelWait = next = m_wheel.next();
+      }
+
+      if (next)
+	m_pending.timedwait(next);
+      else
+	m_pending.wait();
+
+      {
+	ZmGuard<ZmLock> stateGuard(m_stateLock);
+
+	while (m_state == Draining || m_state == Drained)
+	  m_stateCond.wait();
+	if (m_state == Stopping || m_state == Stopped) return;
+      }
+
+      {
+	ZmTime now(ZmTime::Now);
+	now += m_params.quantum();
+	ZmGuard<ZmPLock> scheduleGuard(m_scheduleLock);
+	m_wheelWait = ZmTime();
+
+	while (TimerWheel::Node *node = m_wheel.expire(now)) {
+	  Timer timer = node;
+	  ZmDEREF(node);
+	  {
+	    Timer *ptr = (Timer *)timer->ptr;
+	    if (ZuLikely(ptr)) *ptr = nullptr;
+	  }
+	  bool ok;
+	  unsigned tid = timer->tid;
+	  ZmFn<> fn = timer->fn;
+	  if (ZuLikely(tid))
+	    ok = tryRunWake_(&m_threads[tid - 1], fn);
+	  else
+	    ok = timerAdd(fn);
+	  if (ZuUnlikely(!ok)) {
+	    m_wheel.add(timer);
+	    scheduleGuard.unlock();
+	    ZmPlatform::sleep(m_params.quantum());
+	    break;
+	  }
+	}
+      }
+    }
+  }
+}
+
 bool ZmScheduler::timerAdd(ZmFn<> &fn)
 {
   if (ZuUnlikely(!m_nWorkers)) return false;
+  if (m_params.stealing()) { addStealable(ZuMv(fn)); return true; }
   unsigned first = m_next++;
   unsigned next = first;
   do {
@@ -367,7 +463,10 @@ void ZmScheduler::run(
 	      { *ptr = ZuMv(timer); return; }
 	    break;
 	}
-	m_schedule.del(timer);
+	if (m_params.timerWheel())
+	  m_wheel.del(timer);
+	else
+	  m_schedule.del(timer);
 	timer = nullptr;
       }
     }
@@ -380,9 +479,15 @@ void ZmScheduler::run(
       }
     }
 
-    if (ZuLikely(timer = m_schedule.minimum())) kick = timeout < timer->key();
-
-    timer = m_schedule.add(timeout, Timer_{tid, ZuMv(fn), (void *)ptr});
+    if (m_params.timerWheel()) {
+      kick = !m_wheelWait || timeout < m_wheelWait;
+      timer = new TimerWheel::Node(timeout, Timer_{tid, ZuMv(fn), (void *)ptr});
+      m_wheel.add(timer);
+    } else {
+      if (ZuLikely(timer = m_schedule.minimum()))
+	kick = timeout < timer->key();
+      timer = m_schedule.add(timeout, Timer_{tid, ZuMv(fn), (void *)ptr});
+    }
 
     if (ZuLikely(ptr)) *ptr = ZuMv(timer);
   }
@@ -393,13 +498,176 @@ void ZmScheduler::del(Timer *ptr)
 {
   if (ZuUnlikely(!ptr)) return;
   ZmGuard<ZmPLock> scheduleGuard(m_scheduleLock);
-  if (ZuLikely(*ptr)) { m_schedule.del(*ptr); *ptr = nullptr; }
+  if (ZuLikely(*ptr)) {
+    if (m_params.timerWheel())
+      m_wheel.del(*ptr);
+    else
+      m_schedule.del(*ptr);
+    *ptr = nullptr;
+  }
+}
+
+void ZmScheduler::TimerWheel::init(ZmTime origin, ZmTime quantum)
+{
+  m_origin = origin;
+  if ((m_quantum = quantum.nanosecs()) <= 0) m_quantum = 1;
+  m_tick = 0;
+}
+
+uint64_t ZmScheduler::TimerWheel::tick(ZmTime t, bool ceil) const
+{
+  int64_t n = (t - m_origin).nanosecs();
+  if (n <= 0) return 0;
+  if (ceil) n += m_quantum - 1;
+  return n / m_quantum;
+}
+
+void ZmScheduler::TimerWheel::add(Node *node)
+{
+  ZmREF(node);
+  if (!m_count) { // fast-forward an idle wheel
+    uint64_t now = tick(ZmTimeNow(), false);
+    if (now > m_tick) m_tick = now;
+  }
+  node->wheelTick = tick(node->key(), true);
+  insert(node);
+  ++m_count;
+}
+
+void ZmScheduler::TimerWheel::del(Node *node)
+{
+  unlink(node);
+  --m_count;
+  ZmDEREF(node);
+}
+
+void ZmScheduler::TimerWheel::insert(Timer_ *timer)
+{
+  uint64_t tick = timer->wheelTick;
+  if (tick < m_tick) tick = m_tick;
+  uint64_t d = tick - m_tick;
+  unsigned level;
+  if (d < ((uint64_t)1<<Bits))
+    level = 0;
+  else if (d < ((uint64_t)1<<(Bits * 2)))
+    level = 1;
+  else if (d < ((uint64_t)1<<(Bits * 3)))
+    level = 2;
+  else {
+    // beyond the wheel's range - re-evaluated each time it is cascaded
+    if (d >= ((uint64_t)1<<(Bits * 4)))
+      tick = m_tick + ((uint64_t)1<<(Bits * 4)) - 1;
+    level = 3;
+  }
+  unsigned index = (tick>>(Bits * level)) & Mask;
+  Timer_ *&head = m_slots[level][index];
+  timer->wheelSlot = (level<<Bits) | index;
+  timer->wheelPrev = nullptr;
+  if (timer->wheelNext = head) head->wheelPrev = timer;
+  head = timer;
+  m_bitmap[level][index>>6] |= ((uint64_t)1)<<(index & 63);
+}
+
+void ZmScheduler::TimerWheel::unlink(Timer_ *timer)
+{
+  unsigned level = timer->wheelSlot>>Bits;
+  unsigned index = timer->wheelSlot & Mask;
+  if (timer->wheelNext) timer->wheelNext->wheelPrev = timer->wheelPrev;
+  if (timer->wheelPrev)
+    timer->wheelPrev->wheelNext = timer->wheelNext;
+  else if (!(m_slots[level][index] = timer->wheelNext))
+    m_bitmap[level][index>>6] &= ~(((uint64_t)1)<<(index & 63));
+  timer->wheelPrev = timer->wheelNext = nullptr;
+}
+
+void ZmScheduler::TimerWheel::cascade(unsigned level, unsigned index)
+{
+  Timer_ *timer = m_slots[level][index];
+  if (!timer) return;
+  m_slots[level][index] = nullptr;
+  m_bitmap[level][index>>6] &= ~(((uint64_t)1)<<(index & 63));
+  while (timer) {
+    Timer_ *next = timer->wheelNext;
+    insert(timer);
+    timer = next;
+  }
+}
+
+// returns the offset from index of the first occupied slot, or -1 if none
+int ZmScheduler::TimerWheel::scan(unsigned level, unsigned index) const
+{
+  const uint64_t *bitmap = m_bitmap[level];
+  for (unsigned i = 0; i <= (Slots>>6); i++) {
+    unsigned j = ((index>>6) + i) & ((Slots>>6) - 1);
+    uint64_t w = bitmap[j];
+    if (!i) w &= ~(uint64_t)0<<(index & 63);
+    else if (i == (Slots>>6)) w &= ~(~(uint64_t)0<<(index & 63));
+    if (w) return ((j<<6) + __builtin_ctzll(w) - index) & Mask;
+  }
+  return -1;
+}
+
+ZmTime ZmScheduler::TimerWheel::next() const
+{
+  if (!m_count) return ZmTime();
+  uint64_t next = (m_tick | Mask) + 1; // next cascade
+  int o = scan(0, m_tick & Mask);
+  if (o >= 0 && m_tick + o < next) next = m_tick + o;
+  // expire(now) processes ticks <= tick(now), where now includes quantum
+  return m_origin + ZmTime(ZmTime::Nano, (int64_t)(next - 1) * m_quantum);
+}
+
+ZmScheduler::TimerWheel::Node *ZmScheduler::TimerWheel::expire(ZmTime now)
+{
+  uint64_t target = tick(now, false);
+  for (;;) {
+    if (Timer_ *timer = m_slots[0][m_tick & Mask]) {
+      unlink(timer);
+      --m_count;
+      return static_cast<Node *>(timer);
+    }
+    if (m_tick >= target) return nullptr;
+    if (!m_count) { m_tick = target; return nullptr; }
+    if (scan(0, m_tick & Mask) < 0) {
+      // skip directly to the next cascade
+      uint64_t next = (m_tick | Mask) + 1;
+      if (next > target) { m_tick = target; continue; }
+      m_tick = next;
+    } else
+      ++m_tick;
+    if (!(m_tick & Mask)) {
+      unsigned index;
+      for (unsigned level = 1; level < Levels; level++) {
+	cascade(level, index = (m_tick>>(Bits * level)) & Mask);
+	if (index) break;
+      }
+    }
+  }
+}
+
+void ZmScheduler::TimerWheel::clean()
+{
+  for (unsigned level = 0; level < Levels; level++)
+    for (unsigned index = 0; index < Slots; index++) {
+      Timer_ *timer = m_slots[level][index];
+      m_slots[level][index] = nullptr;
+      while (timer) {
+	Timer_ *next = timer->wheelNext;
+	timer->wheelPrev = timer->wheelNext = nullptr;
+	Node *node = static_cast<Node *>(timer);
+	ZmDEREF(node);
+	timer = next;
+      }
+    }
+  memset(m_bitmap, 0, sizeof(m_bitmap));
+  m_count = 0;
 }
 
 void ZmScheduler::add(ZmFn<> fn)
 {
   if (ZuUnlikely(!fn)) return;
   if (ZuUnlikely(!m_nWorkers)) return;
+  if (m_params.stealing()) { addStealable(ZuMv(fn)); return; }
   unsigned first = m_next++;
   unsigned next = first;
   do {
@@ -409,6 +677,61 @@ void ZmScheduler::add(ZmFn<> fn)
   runWake_(m_workers[first % m_nWorkers], ZuMv(fn));
 }
 
+// stealing mode - untargeted jobs are queued on the selected worker's
+// steal ring, and a token is pushed onto its ring that will run the job
+// (or another, if it has already been stolen); if that worker is busy,
+// a token is also pushed to an idle peer, prompting it to steal the job
+void ZmScheduler::addStealable(ZmFn<> fn)
+{
+  unsigned next = m_next++;
+  Thread *thread = m_workers[next % m_nWorkers];
+  ++thread->stealCount;
+  thread->stealRing.push(ZuMv(fn));
+  {
+    ZmFn<> token = ZmFn<>::Member<&ZmScheduler::stealFn>::fn(this);
+    tryRunWake_(thread, token);
+  }
+  if (ZuLikely(!thread->busy.load_())) return;
+  for (unsigned i = 1; i < m_nWorkers; i++) {
+    Thread *peer = m_workers[(next + i) % m_nWorkers];
+    if (!peer->busy.load_()) {
+      ZmFn<> token = ZmFn<>::Member<&ZmScheduler::stealFn>::fn(this);
+      tryRunWake_(peer, token);
+      return;
+    }
+  }
+}
+
+void ZmScheduler::stealFn()
+{
+  steal(&m_threads[ZmThreadContext::self()->index() - 1]);
+}
+
+// run one job from this worker's steal ring, or failing that from a peer's
+bool ZmScheduler::steal(Thread *thread)
+{
+  ZmFn<> fn;
+  if (thread->stealCount.load_() && (fn = thread->stealRing.shift()))
+    --thread->stealCount;
+  else {
+    unsigned o = thread->worker;
+    for (unsigned i = 1; i <= m_nWorkers; i++) {
+      Thread *peer = m_workers[(o + i) % m_nWorkers];
+      if (peer == thread || !peer->stealCount.load_()) continue;
+      if (fn = peer->stealRing.shift()) {
+	--peer->stealCount;
+	ZmThreadContext::self()->stole();
+	break;
+      }
+    }
+    if (!fn) return false;
+  }
+  thread->busy.store_(1);
+  try { fn(); } catch (...) { }
+  thread->busy.store_(0);
+  return true;
+}
+
 void ZmScheduler::runWake_(Thread *thread, ZmFn<> fn)
 {
   if (ZuLikely(run__(thread, ZuMv(fn)))) wake(thread);
@@ -426,14 +749,14 @@ bool ZmScheduler::run__(Thread *thread, ZmFn<> fn)
   if (ZuLikely(!thread->overCount.load_())) goto push;
 overflow:
   ++thread->overCount;
-  thread->overRing.push(ZuMv(fn));
+  thread->overRing.push(ZmScheduler_stamp(fn));
   return true;
 push:
   {
     // Thread::Guard guard(thread->lock); // ensure serialized ring push()
     void *ptr;
     if (ZuLikely(ptr = thread->ring.tryPush())) {
-      new (ptr) ZmFn<>(ZuMv(fn));
+      new (ptr) ZmFn<>(ZmScheduler_stamp(fn));
       thread->ring.push2(ptr);
       return true;
     }
@@ -465,7 +788,7 @@ bool ZmScheduler::tryRun__(Thread *thread, ZmFn<> &fn)
     // Thread::Guard guard(thread->lock); // ensure serialized ring push()
     void *ptr;
     if (ZuLikely(ptr = thread->ring.tryPush())) {
-      new (ptr) ZmFn<>(ZuMv(fn));
+      new (ptr) ZmFn<>(ZmScheduler_stamp(fn));
       thread->ring.push2(ptr);
       return true;
     }
@@ -480,6 +803,13 @@ void ZmScheduler::work()
 
   thread->tid = ZmPlatform::getTID();
 
+  bool stealing =
+    m_params.stealing() && !m_params.thread(index).isolated();
+
+#ifdef ZmScheduler_HISTOGRAMS
+  ZmScheduler_histograms = ZmThreadContext::self()->histograms_();
+#endif
+
   m_threadInitFn();
 
   for (;;) {
@@ -495,11 +825,14 @@ void ZmScheduler::work()
       }
     }
 shift:
+    if (stealing && !thread->ring.readStatus() && steal(thread)) continue;
     if (ZmFn<> *ptr = thread->ring.shift()) {
       ZmFn<> fn = ZuMv(*ptr);
       ptr->~ZmFn<>();
       thread->ring.shift2();
+      thread->busy.store_(1);
       try { fn(); } catch (...) { }
+      thread->busy.store_(0);
     } else {
       if (thread->ring.readStatus() == Ring::EndOfFile) break;
     }
@@ -507,6 +840,10 @@ shift:
 
   m_threadFinalFn();
 
+#ifdef ZmScheduler_HISTOGRAMS
+  ZmScheduler_histograms = nullptr;
+#endif
+
   --m_runThreads;
 
   m_stopped.post();
@@ -19,6 +19,12 @@
 
 // scheduler with thread pool
 
+// if ZmScheduler_HISTOGRAMS is defined when building libZm, each job's
+// dwell time (enqueue to dequeue) and execution time are recorded in
+// per-thread histograms (see ZmThreadContext::histograms()), whose
+// percentiles are reported in ZmThreadTelemetry; otherwise the
+// instrumentation compiles out entirely
+
 #ifndef ZmScheduler_HPP
 #define ZmScheduler_HPP
 
@@ -104,6 +110,10 @@ public:
     { m_spin = v; return ZuMv(*this); }
   inline ZmSchedParams &&timeout(unsigned v)
     { m_timeout = v; return ZuMv(*this); }
+  inline ZmSchedParams &&stealing(bool v)
+    { m_stealing = v; return ZuMv(*this); }
+  inline ZmSchedParams &&timerWheel(bool v)
+    { m_timerWheel = v; return ZuMv(*this); }
 
   template <typename L>
   inline ZmSchedParams &&thread(unsigned tid, L l) {
@@ -123,6 +133,8 @@ public:
   inline bool ll() const { return m_ll; }
   inline unsigned spin() const { return m_spin; }
   inline unsigned timeout() const { return m_timeout; }
+  inline bool stealing() const { return m_stealing; }
+  inline bool timerWheel() const { return m_timerWheel; }
 
   inline const Thread &thread(unsigned tid) const { return m_threads[tid]; }
 
@@ -150,6 +162,8 @@ private:
   Threads	m_threads = Threads{m_nThreads + 1};
 
   bool		m_ll = false;
+  bool		m_stealing = false;
+  bool		m_timerWheel = false;
 };
 
 namespace ZmSchedState {
@@ -174,13 +188,67 @@ class ZmAPI ZmScheduler {
     unsigned	tid;
     ZmFn<>	fn;
     void	*ptr;
+    // timing wheel linkage (unused by ScheduleTree)
+    Timer_	*wheelPrev = nullptr;
+    Timer_	*wheelNext = nullptr;
+    uint64_t	wheelTick = 0;
+    unsigned	wheelSlot = 0;
   };
 
   using ScheduleTree =
     ZmRBTree<ZmTime,
       ZmRBTreeVal<Timer_,
-	ZmRBTreeLock<ZmNoLock,
-	  ZmRBTreeHeapID<ScheduleTree_HeapID>>>>;
+	ZmRBTreeNodeIsVal<true,
+	  ZmRBTreeLock<ZmNoLock,
+	    ZmRBTreeHeapID<ScheduleTree_HeapID>>>>>;
+
+  // hierarchical timing wheel - O(1) add and delete, selected by
+  // ZmSchedParams::timerWheel(); the wheel shares ScheduleTree's node type
+  // so that Timer handles are the same regardless of implementation;
+  // 4 levels of 256 slots, each level-0 slot spanning one quantum
+  class ZmAPI TimerWheel {
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator =(const TimerWheel &) = delete;
+
+  public:
+    using Node = ScheduleTree::Node;
+
+    enum { Bits = 8, Slots = (1<<Bits), Mask = Slots - 1, Levels = 4 };
+
+    TimerWheel() = default;
+    ~TimerWheel() { clean(); }
+
+    void init(ZmTime origin, ZmTime quantum);
+
+    ZuInline unsigned count() const { return m_count; }
+
+    void add(Node *node);	// takes a reference
+    void del(Node *node);	// releases the reference
+
+    // time at which expire() will next have work to do (null if empty)
+    ZmTime next() const;
+
+    // advance the wheel to now, returning (and removing) the next
+    // expired node, or null if none; the caller assumes the reference
+    Node *expire(ZmTime now);
+
+    void clean();
+
+  private:
+    uint64_t tick(ZmTime t, bool ceil) const;
+
+    void insert(Timer_ *timer);
+    void unlink(Timer_ *timer);
+    void cascade(unsigned level, unsigned index);
+    int scan(unsigned level, unsigned index) const;
+
+    ZmTime	m_origin;
+    int64_t	m_quantum = 1;	// nanoseconds
+    uint64_t	m_tick = 0;
+    unsigned	m_count = 0;
+    Timer_	*m_slots[Levels][Slots] = { { nullptr } };
+    uint64_t	m_bitmap[Levels][Slots>>6] = { { 0 } };
+  };
 
 public:
   using ID = ZmSchedParams::ID;
@@ -218,6 +286,7 @@ public:
     unsigned	  m_outCount = 0;
   };
   enum { OverRing_Increment = 128 };
+  using StealRing = OverRing;
   using Timer = ZmRef<ScheduleTree::Node>;
 
   // might throw ZmRingError
@@ -244,6 +313,8 @@ public:
   enum { Update = 0, Advance, Defer }; // mode
 
   // add(fn) - immediate execution (asynchronous) on any worker thread
+  //   if stealing is enabled, the job may be stolen by an idle worker
+  //   from the worker it was originally dispatched to
   // run(tid, fn) - immediate execution (asynchronous) on a specific thread
   // invoke(tid, fn) - immediate execution on a specific thread
   //   unlike run(), invoke() will execute synchronously if the caller is
@@ -346,6 +417,9 @@ public:
   inline const OverRing &overRing(unsigned tid) const {
     return m_threads[tid - 1].overRing;
   }
+  inline const StealRing &stealRing(unsigned tid) const {
+    return m_threads[tid - 1].stealRing;
+  }
 
   inline unsigned tid(ZuString s) {
     if (unsigned tid = ZuBox0(unsigned)(s))
@@ -372,13 +446,22 @@ private:
     ZmThread		thread;
     ZmAtomic<unsigned>	overCount;
     OverRing		overRing;	// fallback overflow ring
+    ZmAtomic<unsigned>	busy;
+    ZmAtomic<unsigned>	stealCount;
+    StealRing		stealRing;	// untargeted jobs (stealing mode)
+    unsigned		worker = 0;	// index in m_workers (if not isolated)
   };
 
   ZuInline void wake(Thread *thread) { (thread->wakeFn)(); }
 
   void timer();
+  void wheelTimer();
   bool timerAdd(ZmFn<> &fn);
 
+  void addStealable(ZmFn<> fn);
+  void stealFn();
+  bool steal(Thread *thread);
+
   void runWake_(Thread *thread, ZmFn<> fn);
   bool tryRunWake_(Thread *thread, ZmFn<> &fn);
   bool run__(Thread *thread, ZmFn<> fn);
@@ -399,6 +482,8 @@ private:
     ZmSemaphore			  m_pending;
     ZmThread			  m_thread;
     ScheduleTree		  m_schedule;
+    TimerWheel			  m_wheel;
+    ZmTime			  m_wheelWait;
 
   ZmAtomic<unsigned>		m_next;
   Thread			*m_threads;
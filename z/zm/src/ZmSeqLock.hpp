@@ -0,0 +1,99 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// sequence lock - wraps a lock to permit optimistic lock-free readers
+
+// writers lock as usual, incrementing the sequence number on lock and
+// unlock (odd while locked); readers obtain the sequence number with
+// readSeq(), read speculatively, then validate() that no writer intervened,
+// retrying if necessary; readers must tolerate concurrently modified data
+// (e.g. by deferring reclamation of unlinked nodes using ZmEpoch); readers
+// can alternatively acquire the underlying lock using readlock()
+
+#ifndef ZmSeqLock_HPP
+#define ZmSeqLock_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmPLock.hpp>
+#include <zlib/ZmLockTraits.hpp>
+
+template <class Lock_ = ZmPLock> class ZmSeqLock {
+  ZmSeqLock(const ZmSeqLock &);
+  ZmSeqLock &operator =(const ZmSeqLock &);	// prevent mis-use
+
+public:
+  typedef Lock_ Lock;
+  typedef ZmLockTraits<Lock> LockTraits;
+
+  ZuInline ZmSeqLock() { }
+
+  ZuInline void lock() { LockTraits::lock(m_lock); ++m_seq; }
+  ZuInline int trylock() {
+    if (LockTraits::trylock(m_lock)) return -1;
+    ++m_seq;
+    return 0;
+  }
+  ZuInline void unlock() { ++m_seq; LockTraits::unlock(m_lock); }
+
+  ZuInline void readlock() { LockTraits::readlock(m_lock); }
+  ZuInline int readtrylock() { return LockTraits::readtrylock(m_lock); }
+  ZuInline void readunlock() { LockTraits::readunlock(m_lock); }
+
+  // optimistic read - waits for any in-progress writer
+  ZuInline uint32_t readSeq() const {
+    uint32_t seq;
+    while (ZuUnlikely((seq = m_seq) & 1)) ZmPlatform::yield(); // acquire
+    return seq;
+  }
+  ZuInline bool validate(uint32_t seq) const {
+    ZmAtomic_acquire();
+    return m_seq.load_() == seq;
+  }
+
+private:
+  Lock			m_lock;
+  ZmAtomic<uint32_t>	m_seq = 0;
+};
+
+template <class Lock>
+struct ZmLockTraits<ZmSeqLock<Lock> > :
+    public ZmGenericLockTraits<ZmSeqLock<Lock> > {
+  enum {
+    CanTry = ZmLockTraits<Lock>::CanTry,
+    Recursive = 0,
+    RWLock = ZmLockTraits<Lock>::RWLock,
+    SeqLock = 1
+  };
+  ZuInline static void readlock(ZmSeqLock<Lock> &l) { l.readlock(); }
+  ZuInline static int readtrylock(ZmSeqLock<Lock> &l) {
+    return l.readtrylock();
+  }
+  ZuInline static void readunlock(ZmSeqLock<Lock> &l) { l.readunlock(); }
+};
+
+#endif /* ZmSeqLock_HPP */
@@ -34,8 +34,9 @@
 //   instances of the same type within the same thread
 
 // performance - normal run-time ZmSpecific::instance() calls are lock-free
-// and equivalent to thread_local with one additional pointer dereference;
-// object construction/destruction involves global lock acquisition and
+// and equivalent to reading a trivially constructed thread_local pointer
+// (which is cleared whenever the instance is destroyed); object
+// construction/destruction involves global lock acquisition and
 // updates to a type-specific linked list (for iteration), and a
 // module-specific linked list (for cleanup on Win32 only)
 
@@ -118,6 +119,7 @@ struct ZmAPI ZmSpecific_Object {
 
   DtorFn		dtorFn = nullptr;
   ZmObject		*ptr = nullptr;
+  ZmObject		**cache = nullptr;	// owning thread's cached ptr
   ZmSpecific_Object	*prev = nullptr;
   ZmSpecific_Object	*next = nullptr;
 #ifdef _WIN32
@@ -315,12 +317,21 @@ private:
     thread_local Object o;
     return &o;
   }
+  // fast path - unlike local_(), this requires no guarded initialization
+  // or destructor registration, so access is a single TLS load
+  ZuInline static ZmObject *&cache_() {
+    thread_local ZmObject *ptr = nullptr;
+    return ptr;
+  }
+  // called with lock held, by the owning thread
+  ZuInline static void cache(Object *o) { *(o->cache = &cache_()) = o->ptr; }
 
   void dtor_(Object *o) {
     T *ptr;
     if (ptr = static_cast<T *>(o->ptr)) {
       this->del(o);
       o->ptr = nullptr;
+      if (o->cache) *(o->cache) = nullptr;
     }
     ZmSpecific_unlock();
     if (ptr) {
@@ -336,6 +347,7 @@ private:
     Object *o = local_();
     ZmSpecific_lock();
     if (o->ptr) {
+      cache(o);
       ptr = static_cast<T *>(o->ptr);
       ZmSpecific_unlock();
       return ptr;
@@ -352,6 +364,7 @@ private:
       o->dtorFn = dtor__;
       add(o);
       ZmREF(ptr);
+      cache(o);
     } else {
       dtor_(o); // unlocks
       ZmSpecific_lock();
@@ -364,6 +377,19 @@ private:
     return ptr;
   }
 
+  // slow path - instance was not cached, e.g. first call by this thread
+  static T *instance__() {
+    Object *o = local_();
+    if (o->ptr) {
+      ZmSpecific_lock();
+      ZmObject *ptr = o->ptr;
+      if (ptr) cache(o);
+      ZmSpecific_unlock();
+      if (ptr) return static_cast<T *>(ptr);
+    }
+    return create();
+  }
+
   inline T *instance_(T *ptr) {
     Object *o = local_();
     ZmSpecific_lock();
@@ -376,6 +402,7 @@ private:
       o->dtorFn = dtor__;
       add(o);
       ZmREF(ptr);
+      cache(o);
     } else {
       dtor_(o); // unlocks
       ZmSpecific_lock();
@@ -402,9 +429,8 @@ public:
     return nullptr;
   }
   ZuInline static T *instance() {
-    ZmObject *ptr;
-    if (ZuLikely(ptr = local_()->ptr)) return static_cast<T *>(ptr);
-    return create();
+    if (ZmObject *ptr = cache_()) return static_cast<T *>(ptr);
+    return instance__();
   }
   inline static T *instance(T *ptr) {
     return global()->instance_(ptr);
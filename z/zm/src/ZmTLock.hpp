@@ -21,6 +21,21 @@
 
 // * upgraders have priority over writers - no lock release during upgrade
 // * writers have priority over readers - no writer starvation
+//
+// uncontended acquisition is lock-free - each ID has a word that records
+// a single reader or writer; acquiring a free ID, and releasing it, is a
+// single compare-and-swap on that word, following a lock-free (optimistic)
+// lookup of the ID and TID; a second locker, recursive locking, or an
+// upgrade, "inflates" the ID under the global lock - the word is
+// permanently marked as contended and the fast holder is converted into
+// the usual bookkeeping (waiters, held counts, deadlock detection); once
+// all holders of an inflated ID release it, it is removed and the next
+// locker creates a new (uncontended) lock
+//
+// * concurrent operations on the same TID are not permitted (including
+//   relock() of that TID)
+// * idle (uncontended, unlocked) IDs are retained for re-use by the fast
+//   path, and are swept whenever the number of IDs doubles
 
 #ifndef ZmTLock_HPP
 #define ZmTLock_HPP
@@ -43,7 +58,10 @@
 #include <zlib/ZuIndex.hpp>
 #include <zlib/ZuStringN.hpp>
 
+#include <zlib/ZmAtomic.hpp>
 #include <zlib/ZmLock.hpp>
+#include <zlib/ZmSeqLock.hpp>
+#include <zlib/ZmEpoch.hpp>
 #include <zlib/ZmCondition.hpp>
 #include <zlib/ZmGuard.hpp>
 #include <zlib/ZmTime.hpp>
@@ -51,7 +69,6 @@
 #include <zlib/ZmRef.hpp>
 #include <zlib/ZmHash.hpp>
 #include <zlib/ZmStack.hpp>
-#include <zlib/ZmList.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -127,6 +144,14 @@ friend struct ZmTLock_Test;
     Timed	= 2
   };
 
+  enum {				// fast word - Thread * | Read/Write
+    Free	= 0,
+    Read	= 1,
+    Write	= 2,
+    Inflated	= 3,			// contended - see m_held, etc.
+    Mask	= 3
+  };
+
   typedef ZmLock Lock_;
   typedef ZmGuard<Lock_> Guard_;
   typedef ZmReadGuard<Lock_> ReadGuard_;
@@ -168,6 +193,7 @@ friend struct Lock;
     }
 
     ID				m_id;
+    ZmAtomic<uintptr_t>		m_fast;		// uncontended holder
     int				m_useCount;	// use count (waiting + held)
     ZmCondition<Lock_>		m_readOK;	// wake-up for read lockers
     ZmCondition<Lock_>		m_writeOK;	// wake-up for write lockers
@@ -188,11 +214,7 @@ friend struct Lock;
 	    ZmHashVal<LockRef,
 	      ZmHashValCmp<Lock,
 		ZmHashHeapID<HeapID,
-		  ZmHashLock<ZmNoLock> > > > > LockHash;
-
-  typedef ZmList<LockRef,
-	    ZmListLock<ZmNoLock,
-	      ZmListHeapID<HeapID> > > LockList;
+		  ZmHashLock<ZmSeqLock<> > > > > > LockHash;
 
   struct Thread;
 friend struct Thread;
@@ -288,16 +310,107 @@ friend struct Thread;
 
   typedef ZmHash<TID,
 	    ZmHashVal<ThreadRef,
-	      ZmHashLock<ZmNoLock> > > ThreadHash;
+	      ZmHashLock<ZmSeqLock<> > > > ThreadHash;
 
 public:
   ZmTLock(ZmTLockParams params = ZmTLockParams()) {
     m_locks = new LockHash(params.m_idHash);
     m_threads = new ThreadHash(params.m_tidHash);
+    m_sweep = m_locks->size();
   }
   virtual ~ZmTLock() { }
 
 private:
+  // fast path - lock-free lookup followed by a single CAS
+  template <typename ID_, typename TID_>
+  bool fastLock(const ID_ &id, const TID_ &tid, int type) {
+    ZmEpoch::Guard epoch;
+    if (ZuUnlikely(!epoch)) return false;
+    typename LockHash::Node *lockNode = m_locks->findPtr(id);
+    if (ZuUnlikely(!lockNode)) return false;
+    typename ThreadHash::Node *threadNode = m_threads->findPtr(tid);
+    if (ZuUnlikely(!threadNode)) return false;
+    return fastLock_(lockNode->val().ptr(), threadNode->val().ptr(), type);
+  }
+  template <typename ID_, typename TID_>
+  bool fastUnlock(const ID_ &id, const TID_ &tid) {
+    ZmEpoch::Guard epoch;
+    if (ZuUnlikely(!epoch)) return false;
+    typename LockHash::Node *lockNode = m_locks->findPtr(id);
+    if (ZuUnlikely(!lockNode)) return false;
+    typename ThreadHash::Node *threadNode = m_threads->findPtr(tid);
+    if (ZuUnlikely(!threadNode)) return false;
+    return fastUnlock_(lockNode->val().ptr(), threadNode->val().ptr());
+  }
+
+  bool fastLock_(Lock *lock, Thread *thread, int type) {
+    if (lock->m_fast.load_() != Free ||
+	lock->m_fast.cmpXch((uintptr_t)thread | type, Free) != Free)
+      return false;
+    if (type == Read)
+      thread->readLock(lock);
+    else
+      thread->writeLock(lock);
+    return true;
+  }
+  bool fastUnlock_(Lock *lock, Thread *thread) {
+    uintptr_t fast = lock->m_fast.load_();
+    if ((fast & ~(uintptr_t)Mask) != (uintptr_t)thread ||
+	lock->m_fast.cmpXch(Free, fast) != fast)
+      return false;
+    if ((fast & Mask) == Read)
+      thread->readUnlock(lock);
+    else
+      thread->writeUnlock(lock);
+    return true;
+  }
+
+  // convert the uncontended holder (if any) into a held lock
+  void inflate(Lock *lock) {
+    uintptr_t fast = lock->m_fast.load_();
+    if (fast == Inflated) return;
+    while (lock->m_fast.cmpXch(Inflated, fast) != fast)
+      fast = lock->m_fast.load_();
+    if (fast == Free) return;
+    void *thread = (void *)(fast & ~(uintptr_t)Mask);
+    lock->m_useCount++;
+    lock->m_held.push(Held(thread, 1));
+    if ((fast & Mask) == Read)
+      lock->m_readCount++;
+    else {
+      lock->m_writeLocker = thread;
+      lock->m_lockCount = 1;
+    }
+  }
+
+  // remove idle locks - an idle lock is inflated before removal, so that
+  // the fast path cannot acquire it after it has been removed
+  void sweep() {
+    {
+      auto i = m_locks->iterator();
+      typename LockHash::Node *node;
+
+      while (node = i.iterate()) {
+	Lock *lock = node->val().ptr();
+	if (!lock->m_useCount && lock->m_fast.cmpXch(Inflated, Free) == Free)
+	  i.del();
+      }
+    }
+    unsigned n = m_locks->count_()<<1;
+    if ((m_sweep = m_locks->size()) < n) m_sweep = n;
+  }
+
+  template <typename ID_, typename TID_>
+  void find(const ID_ &id, const TID_ &tid, LockRef &lock, ThreadRef &thread) {
+    if (ZuUnlikely(m_locks->count_() >= m_sweep)) sweep();
+
+    if (!(lock = m_locks->findVal(id)))
+      m_locks->add(id, lock = new Lock(id, m_lock));
+
+    if (!(thread = m_threads->findVal(tid)))
+      m_threads->add(tid, thread = new Thread(tid));
+  }
+
   template <typename ID_, typename TID_>
   int readLock_(const ID_ &id, const TID_ &tid, int flags, ZmTime timeout) {
     LockRef lock;
@@ -306,19 +419,13 @@ private:
 
     // printf("Read Locking\t(TID = %d, ID = %d)\n", (int)tid, (int)id);
 
-    if (!(lock = m_locks->findVal(id)))
-      m_locks->add(id, lock = allocLock(id));
+    find(id, tid, lock, thread);
 
-    lock->m_useCount++;
+    if (fastLock_(lock, thread, Read)) return 0;
 
-    {
-      typename ThreadHash::NodeRef threadNode;
+    inflate(lock);
 
-      if (threadNode = m_threads->find(tid))
-	thread = threadNode->val();
-      else
-	m_threads->add(tid, thread = new Thread(tid));
-    }
+    lock->m_useCount++;
 
     if (lock->m_writeLocker == thread) { // we already write locked it
       lock->m_lockCount >= 0 ? lock->m_lockCount++ : lock->m_lockCount--;
@@ -356,7 +463,7 @@ acquire:
     return 0;
 
 fail:
-    if (!--lock->m_useCount) { freeLock(lock); m_locks->del(id); }
+    if (!--lock->m_useCount) m_locks->del(id);
     return -1;
   }
 
@@ -368,25 +475,13 @@ fail:
 
     // printf("Write Locking\t(TID = %d, ID = %d)\n", (int)tid, (int)id);
 
-    {
-      typename LockHash::NodeRef lockNode;
-
-      if (lockNode = m_locks->find(id))
-	lock = lockNode->val();
-      else
-	m_locks->add(id, lock = allocLock(id));
-    }
+    find(id, tid, lock, thread);
 
-    lock->m_useCount++;
+    if (fastLock_(lock, thread, Write)) return 0;
 
-    {
-      typename ThreadHash::NodeRef threadNode;
+    inflate(lock);
 
-      if (threadNode = m_threads->find(tid))
-	thread = threadNode->val();
-      else
-	m_threads->add(tid, thread = new Thread(tid));
-    }
+    lock->m_useCount++;
 
     if (lock->m_writeLocker == thread) {	// we already write locked it
       lock->m_lockCount >= 0 ? lock->m_lockCount++ : lock->m_lockCount--;
@@ -460,6 +555,8 @@ fail:
   }
 
   void unlock_(Lock *lock, Thread *thread) {
+    if (fastUnlock_(lock, thread)) return;
+
     Held *held = lock->m_held.findPtr(thread);
 
     if (!held) return;
@@ -510,24 +607,36 @@ unused:
 
 public:
   template <typename ID_, typename TID_>
-  inline int readLock(ID_ &&id, TID_ &&tid)
-    { return readLock_(ZuFwd<ID_>(id), ZuFwd<TID_>(tid), 0, ZmTime()); }
+  inline int readLock(const ID_ &id, const TID_ &tid) {
+    if (ZuLikely(fastLock(id, tid, Read))) return 0;
+    return readLock_(id, tid, 0, ZmTime());
+  }
   template <typename ID_, typename TID_>
-  inline int tryReadLock(ID_ &&id, TID_ &&tid)
-    { return readLock_(ZuFwd<ID_>(id), ZuFwd<TID_>(tid), Try, ZmTime()); }
+  inline int tryReadLock(const ID_ &id, const TID_ &tid) {
+    if (ZuLikely(fastLock(id, tid, Read))) return 0;
+    return readLock_(id, tid, Try, ZmTime());
+  }
   template <typename ID_, typename TID_, typename T>
-  inline int timedReadLock(ID_ &&id, TID_ &&tid, T &&t)
-    { return readLock_(ZuFwd<ID_>(id), ZuFwd<TID_>(tid), Timed, ZuFwd<T>(t)); }
+  inline int timedReadLock(const ID_ &id, const TID_ &tid, T &&t) {
+    if (ZuLikely(fastLock(id, tid, Read))) return 0;
+    return readLock_(id, tid, Timed, ZuFwd<T>(t));
+  }
 
   template <typename ID_, typename TID_>
-  inline int writeLock(ID_ &&id, TID_ &&tid)
-    { return writeLock_(ZuFwd<ID_>(id), ZuFwd<TID_>(tid), 0, ZmTime()); }
+  inline int writeLock(const ID_ &id, const TID_ &tid) {
+    if (ZuLikely(fastLock(id, tid, Write))) return 0;
+    return writeLock_(id, tid, 0, ZmTime());
+  }
   template <typename ID_, typename TID_>
-  inline int tryWriteLock(ID_ &&id, TID_ &&tid)
-    { return writeLock_(ZuFwd<ID_>(id), ZuFwd<TID_>(tid), Try, ZmTime()); }
+  inline int tryWriteLock(const ID_ &id, const TID_ &tid) {
+    if (ZuLikely(fastLock(id, tid, Write))) return 0;
+    return writeLock_(id, tid, Try, ZmTime());
+  }
   template <typename ID_, typename TID_, typename T>
-  inline int timedWriteLock(ID_ &&id, TID_ &&tid, T &&t)
-    { return writeLock_(ZuFwd<ID_>(id), ZuFwd<TID_>(tid), Timed, ZuFwd<T>(t)); }
+  inline int timedWriteLock(const ID_ &id, const TID_ &tid, T &&t) {
+    if (ZuLikely(fastLock(id, tid, Write))) return 0;
+    return writeLock_(id, tid, Timed, ZuFwd<T>(t));
+  }
 
 #define ZmTLock_ID2LOCK(id, lock, ret) do { \
       typename LockHash::NodeRef lockNode; \
@@ -544,13 +653,15 @@ public:
     } while (0)
 
   template <typename ID_, typename TID_>
-  void unlock(ID_ &&id, TID_ &&tid) {
+  void unlock(const ID_ &id, const TID_ &tid) {
+    if (ZuLikely(fastUnlock(id, tid))) return;
+
     LockRef lock;
     ThreadRef thread;
     Guard_ guard(m_lock);
 
-    ZmTLock_ID2LOCK(ZuFwd<ID_>(id), lock, (void)0);
-    ZmTLock_TID2THREAD(ZuFwd<TID_>(tid), thread, (void)0);
+    ZmTLock_ID2LOCK(id, lock, (void)0);
+    ZmTLock_TID2THREAD(tid, thread, (void)0);
 
     unlock_(lock, thread);
   }
@@ -564,7 +675,8 @@ public:
     ZmTLock_ID2LOCK(ZuFwd<ID_>(id), lock, false);
     ZmTLock_TID2THREAD(ZuFwd<TID_>(tid), thread, false);
 
-    return lock->m_held.findPtr(thread);
+    return (lock->m_fast.load_() & ~(uintptr_t)Mask) ==
+	(uintptr_t)thread.ptr() || lock->m_held.findPtr(thread);
   }
 
   template <typename ID_, typename TID_>
@@ -576,7 +688,8 @@ public:
     ZmTLock_ID2LOCK(ZuFwd<ID_>(id), lock, false);
     ZmTLock_TID2THREAD(ZuFwd<TID_>(tid), thread, false);
 
-    return lock->m_writeLocker == thread;
+    return lock->m_fast.load_() == ((uintptr_t)thread.ptr() | Write) ||
+      lock->m_writeLocker == thread;
   }
 
   template <typename ID_, typename TID_>
@@ -606,11 +719,27 @@ public:
       lock = lockNode->val();
     }
 
-    s << "C" << ZuBoxed(lock->m_useCount).fmt(ZuFmt::Right<3>()) <<
-      ":R" << ZuBoxed(lock->m_readCount).fmt(ZuFmt::Right<3>()) <<
+    // report an uncontended holder as if it had been inflated
+    int useCount = lock->m_useCount;
+    int readCount = lock->m_readCount;
+    int lockCount = lock->m_lockCount;
+    {
+      uintptr_t fast = lock->m_fast.load_();
+
+      if (fast != Free && fast != Inflated) {
+	useCount = 1;
+	if ((fast & Mask) == Read)
+	  readCount = 1;
+	else
+	  lockCount = 1;
+      }
+    }
+
+    s << "C" << ZuBoxed(useCount).fmt(ZuFmt::Right<3>()) <<
+      ":R" << ZuBoxed(readCount).fmt(ZuFmt::Right<3>()) <<
       ":U" << ZuBoxed(lock->m_upgradeCount).fmt(ZuFmt::Right<3>()) <<
       ":W" << ZuBoxed(lock->m_writeCount).fmt(ZuFmt::Right<3>()) <<
-      ":L" << ZuBoxed(lock->m_lockCount).fmt(ZuFmt::Right<3>());
+      ":L" << ZuBoxed(lockCount).fmt(ZuFmt::Right<3>());
     return s;
   }
 
@@ -634,6 +763,8 @@ public:
 	m_threads->add(newTID, newThread = new Thread(newTID));
     }
 
+    inflate(lock);
+
     while (oldThread->readUnlock(lock)) newThread->readLock(lock);
     if (lock->m_writeLocker == oldThread) {
       if (oldThread->downgrade(lock))
@@ -665,21 +796,10 @@ public:
   unsigned count_() { return m_locks->count_(); }
 
 private:
-  template <typename ID_>
-  LockRef allocLock(ID_ &&id) {
-    if (ZuUnlikely(!m_freeLocks.count()))
-      return new Lock(ZuFwd<ID_>(id), m_lock);
-    LockRef lock = m_freeLocks.pop();
-    lock->m_id = ZuFwd<ID_>(id);
-    return lock;
-  }
-
-  void freeLock(Lock *lock) { m_freeLocks.push(lock); }
-
   Lock_			m_lock;		// global lock
     ZmRef<LockHash>	  m_locks;	// locks
     ZmRef<ThreadHash>	  m_threads;	// threads
-    LockList		  m_freeLocks;	// free list
+    unsigned		  m_sweep;	// sweep idle locks at this count
 };
 
 #ifdef _MSC_VER
@@ -145,6 +145,20 @@ void ZmThreadContext::telemetry(ZmThreadTelemetry &data) const {
   data.tid = tid();
   data.stackSize = m_stackSize;
   data.cpuset = m_cpuset.uint64(); // FIXME
+  data.stolen = m_stolen;
+  if (const ZmThreadHistograms *histograms = m_histograms) {
+    data.dwellP50 = histograms->dwell.percentile(50);
+    data.dwellP99 = histograms->dwell.percentile(99);
+    data.dwellP999 = histograms->dwell.percentile(99.9);
+    data.dwellMax = histograms->dwell.max();
+    data.execP50 = histograms->exec.percentile(50);
+    data.execP99 = histograms->exec.percentile(99);
+    data.execP999 = histograms->exec.percentile(99.9);
+    data.execMax = histograms->exec.max();
+  } else {
+    data.dwellP50 = data.dwellP99 = data.dwellP999 = data.dwellMax = 0;
+    data.execP50 = data.execP99 = data.execP999 = data.execMax = 0;
+  }
   data.cpuUsage = cpuUsage();
   data.sysPriority = sysPriority();
   data.index = m_index;
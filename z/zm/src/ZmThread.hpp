@@ -46,6 +46,7 @@
 #include <zlib/ZmCleanup.hpp>
 #include <zlib/ZmFn.hpp>
 #include <zlib/ZmTime.hpp>
+#include <zlib/ZmHistogram.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -68,12 +69,25 @@ typedef ZuStringN<28> ZmThreadName;
 
 // display sequence:
 //   name, id, tid, cpuUsage, cpuset, priority, sysPriority,
-//   stackSize, partition, main, detached
+//   stackSize, partition, main, detached, stolen,
+//   dwellP50, dwellP99, dwellP999, dwellMax,
+//   execP50, execP99, execP999, execMax
+// dwell/exec are job queueing/execution times in nanosecs (ZmScheduler),
+// zero unless ZmScheduler_HISTOGRAMS is defined
 struct ZmThreadTelemetry {
   ZmThreadName	name;
   uint64_t	tid;		// primary key
   uint64_t	stackSize;
   uint64_t	cpuset;		// FIXME
+  uint64_t	stolen;		// jobs stolen from peers (ZmScheduler)
+  uint64_t	dwellP50;
+  uint64_t	dwellP99;	// graphable
+  uint64_t	dwellP999;
+  uint64_t	dwellMax;
+  uint64_t	execP50;
+  uint64_t	execP99;	// graphable
+  uint64_t	execP999;
+  uint64_t	execMax;
   double	cpuUsage;	// graphable (*)
   int32_t	sysPriority;
   int16_t	index;		// index within thread pool (ZmScheduler, ...)
@@ -83,6 +97,14 @@ struct ZmThreadTelemetry {
   uint8_t	detached;
 };
 
+// job dwell (enqueue to dequeue) and execution time, in nanosecs
+struct ZmThreadHistograms {
+  typedef ZmHistogram<> Histogram;
+
+  Histogram	dwell;
+  Histogram	exec;
+};
+
 class ZmThreadContext;
 
 #ifndef _WIN32
@@ -239,7 +261,7 @@ class ZmAPI ZmThreadContext : public ZmObject, public ZmThreadContext_ {
       m_detached(params.detached()) { }
 
 public:
-  ~ZmThreadContext() { }
+  ~ZmThreadContext() { delete m_histograms; }
 
   void init();
 
@@ -275,6 +297,20 @@ public:
 
   ZuInline bool detached() const { return m_detached; }
 
+  // count of jobs stolen from peer threads (ZmScheduler work-stealing)
+  ZuInline uint64_t stolen() const { return m_stolen; }
+  ZuInline void stole() { ++m_stolen; }
+
+  // job dwell/execution time histograms (ZmScheduler), null unless
+  // allocated by histograms_(), which must be called by this thread
+  ZuInline const ZmThreadHistograms *histograms() const {
+    return m_histograms;
+  }
+  ZmThreadHistograms *histograms_() {
+    if (!m_histograms) m_histograms = new ZmThreadHistograms();
+    return m_histograms;
+  }
+
   void telemetry(ZmThreadTelemetry &data) const;
 
   template <typename S> inline void print(S &s) const {
@@ -299,6 +335,10 @@ private:
 
   void		*m_result = nullptr;
 
+  uint64_t	m_stolen = 0;
+
+  ZmThreadHistograms	*m_histograms = nullptr;
+
   bool		m_detached = false;
 };
 
@@ -366,7 +406,9 @@ public:
     CSV_(S &stream) : m_stream(stream) { 
       m_stream <<
 	"name,tid,cpuUsage,cpuSet,sysPriority,priority,"
-	"stackSize,partition,main,detached\n";
+	"stackSize,partition,main,detached,stolen,"
+	"dwellP50,dwellP99,dwellP999,dwellMax,"
+	"execP50,execP99,execP999,execMax\n";
     }
     void print(const ZmThreadContext *tc) {
       ZmThreadTelemetry data;
@@ -382,7 +424,12 @@ public:
 	<< ',' << data.stackSize
 	<< ',' << ZuBoxed(data.partition)
 	<< ',' << ZuBoxed(data.main)
-	<< ',' << ZuBoxed(data.detached) << '\n';
+	<< ',' << ZuBoxed(data.detached)
+	<< ',' << data.stolen
+	<< ',' << data.dwellP50 << ',' << data.dwellP99
+	<< ',' << data.dwellP999 << ',' << data.dwellMax
+	<< ',' << data.execP50 << ',' << data.execP99
+	<< ',' << data.execP999 << ',' << data.execMax << '\n';
     }
     S &stream() { return m_stream; }
 
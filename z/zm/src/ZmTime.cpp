@@ -233,6 +233,198 @@ uint64_t ZmTime::cpuFreq() {
 
 #endif /* !_WIN32 */
 
+// fast()
+
+#if !defined(_WIN32) && defined(__GNUC__) && defined(__x86_64__)
+
+#include <cpuid.h>
+#include <x86intrin.h>
+
+#include <zlib/ZmSeqLock.hpp>
+
+// ns = base + ((tsc - tscBase) * mult)>>Shift, published by a seqlock;
+// the first Calib interval is spent sampling (falling back to now()),
+// after which the scale and offset are recalibrated every Interval by
+// whichever caller first observes that the interval has elapsed
+
+class ZmTime_TSC {
+  enum { Uncalibrated = 0, Calibrating, Calibrated, Disabled };
+
+  enum { Shift = 32 };
+  enum { Calib = 10000000 };		// initial calibration (10ms)
+  enum { Interval = 1000000000 };	// recalibration interval (1s)
+  enum { MaxError = 1000000 };		// step rather than slew (1ms)
+
+  typedef unsigned __int128 UInt128;
+
+public:
+  ZmTime &fast(ZmTime &t) {
+    if (ZuLikely(m_state.load_() == Calibrated)) {
+      uint64_t tsc;
+      int64_t ns;
+      uint32_t seq;
+      do {
+	seq = m_lock.readSeq();
+	tsc = __rdtsc();
+	if (ZuUnlikely(tsc >= m_tscNext)) goto recalibrate;
+	ns = convert(tsc);
+      } while (ZuUnlikely(!m_lock.validate(seq)));
+      return t = ZmTime(ZmTime::Nano, ns);
+    }
+  recalibrate:
+    return slow(t);
+  }
+
+  bool tsc() const { return m_state.load_() != Disabled; }
+
+private:
+  static bool invariant() {
+    unsigned a, b, c, d;
+    if (!__get_cpuid(0x80000000, &a, &b, &c, &d) || a < 0x80000007)
+      return false;
+    __get_cpuid(0x80000007, &a, &b, &c, &d);
+    return d & (1U<<8);
+  }
+
+  // bracket the system clock with TSC reads, taking the tightest of 3
+  static int64_t sample(uint64_t &tsc) {
+    ZmTime t;
+    tsc = 0;
+    uint64_t min = ~(uint64_t)0;
+    for (unsigned i = 0; i < 3; i++) {
+      ZmTime t_;
+      uint64_t begin = __rdtsc();
+      t_.now();
+      uint64_t end = __rdtsc();
+      if (end - begin < min) {
+	min = end - begin;
+	tsc = begin + (min>>1);
+	t = t_;
+      }
+    }
+    return t.nanosecs();
+  }
+
+  int64_t convert(uint64_t tsc) const {
+    if (ZuUnlikely(tsc < m_tscBase)) tsc = m_tscBase;
+    return m_base + (int64_t)(((UInt128)(tsc - m_tscBase) * m_mult)>>Shift);
+  }
+  uint64_t cycles(uint64_t ns) const {
+    return (uint64_t)(((UInt128)ns<<Shift) / m_mult);
+  }
+
+  // extrapolate with the current scale and offset, waiting for any
+  // in-progress recalibration; used by threads that lose the race to
+  // recalibrate, since now() could be behind times already returned
+  int64_t extrapolate() const {
+    int64_t ns;
+    uint32_t seq;
+    do {
+      seq = m_lock.readSeq();
+      ns = convert(__rdtsc());
+    } while (ZuUnlikely(!m_lock.validate(seq)));
+    return ns;
+  }
+
+  ZmTime &slow(ZmTime &t) {
+    if (m_state.load_() == Disabled) return t.now();
+    if (m_lock.trylock()) {
+      if (m_state.load_() != Calibrated) return t.now();
+      return t = ZmTime(ZmTime::Nano, extrapolate());
+    }
+    uint64_t tsc;
+    int64_t ns;
+    switch ((int)m_state.load_()) {
+      case Uncalibrated:
+	if (!invariant()) {
+	  m_state = Disabled;
+	  m_lock.unlock();
+	  return t.now();
+	}
+	m_anchor = sample(m_tscAnchor);
+	m_state = Calibrating;
+	t = ZmTime(ZmTime::Nano, m_anchor);
+	break;
+      case Calibrating:
+	ns = sample(tsc);
+	if (ns - m_anchor >= Calib && tsc > m_tscAnchor) {
+	  m_mult = (uint64_t)(((UInt128)(ns - m_anchor)<<Shift) /
+	      (tsc - m_tscAnchor));
+	  m_tscBase = tsc;
+	  m_base = ns;
+	  m_tscNext = tsc + cycles(Interval);
+	  m_state = Calibrated;
+	}
+	t = ZmTime(ZmTime::Nano, ns);
+	break;
+      case Calibrated:
+	tsc = __rdtsc();
+	if (tsc < m_tscNext) { // lost the race to recalibrate
+	  t = ZmTime(ZmTime::Nano, convert(tsc));
+	  break;
+	}
+	recalibrate();
+	t = ZmTime(ZmTime::Nano, m_base);
+	break;
+      default:
+	t.now();
+	break;
+    }
+    m_lock.unlock();
+    return t;
+  }
+
+  // long-term scale is derived from the anchor sample, then adjusted so
+  // that the current error is eliminated over the next interval; the
+  // offset remains continuous unless the system clock has been stepped
+  void recalibrate() {
+    uint64_t tsc;
+    int64_t ns = sample(tsc);
+    int64_t cur = convert(tsc);
+    int64_t error = ns - cur;
+    if (error > MaxError || error < -MaxError || tsc <= m_tscAnchor) {
+      m_anchor = ns;
+      m_tscAnchor = tsc;
+      m_base = ns;
+    } else {
+      if (ns - m_anchor >= Calib)
+	m_mult = (uint64_t)(((UInt128)(ns - m_anchor)<<Shift) /
+	    (tsc - m_tscAnchor));
+      uint64_t interval = cycles(Interval);
+      if (error >= 0)
+	m_mult += (uint64_t)(((UInt128)error<<Shift) / interval);
+      else
+	m_mult -= (uint64_t)(((UInt128)(-error)<<Shift) / interval);
+      m_base = cur;
+    }
+    m_tscBase = tsc;
+    m_tscNext = tsc + cycles(Interval);
+  }
+
+  ZmSeqLock<ZmPLock>	m_lock;
+  ZmAtomic<uint32_t>	m_state;
+  uint64_t		m_tscBase = 0;	// TSC at m_base
+  int64_t		m_base = 0;	// nanosecs since epoch
+  uint64_t		m_mult = 0;	// nanosecs per cycle << Shift
+  uint64_t		m_tscNext = 0;	// TSC at next recalibration
+  uint64_t		m_tscAnchor = 0; // TSC at m_anchor
+  int64_t		m_anchor = 0;	// long-term calibration sample
+};
+
+static ZmTime_TSC ZmTime_tsc;
+
+ZmTime &ZmTime::fast() { return ZmTime_tsc.fast(*this); }
+
+bool ZmTime::fastTSC() { return ZmTime_tsc.tsc(); }
+
+#else
+
+ZmTime &ZmTime::fast() { return now(); }
+
+bool ZmTime::fastTSC() { return false; }
+
+#endif
+
 // sleep()
 
 #ifndef _WIN32
@@ -56,6 +56,7 @@ class ZmAPI ZmTime : public timespec {
 public:
   enum Now_ { Now };		// disambiguator
   enum Nano_ { Nano };		// ''
+  enum Fast_ { Fast };		// ''
 
   ZuInline ZmTime() : timespec{0, 0} { }
 
@@ -81,6 +82,7 @@ public:
 
 public:
   ZuInline ZmTime(Now_) { now(); }
+  ZuInline ZmTime(Fast_) { fast(); }
   template <typename T>
   ZuInline ZmTime(Now_, T i, typename MatchInt<T>::T *_ = 0) {
     now(i);
@@ -135,6 +137,15 @@ public:
   static uint64_t cpuFreq();
 #endif /* !_WIN32 */
 
+  // fast() is a cheaper alternative to now() - if the CPU has an invariant
+  // TSC, it is read and converted to wall time using a scale and offset
+  // that are periodically recalibrated against now() (slewing gradually,
+  // so that fast() does not go backwards unless the system clock is
+  // stepped); otherwise fast() is equivalent to now()
+  ZmTime &fast();
+  // true unless fast() has fallen back to now()
+  static bool fastTSC();
+
   template <typename T>
   ZuInline typename MatchInt<T, ZmTime &>::T now(T i) { return now() += i; }
   ZuInline ZmTime &now(double d) { return now() += d; }
@@ -303,6 +314,7 @@ ZuInline typename ZmTime::MatchInt<T, ZmTime>::T ZmTimeNow(T i) {
 }
 ZuInline ZmTime ZmTimeNow(double d) { return ZmTime(ZmTime::Now, d); }
 ZuInline ZmTime ZmTimeNow(const ZmTime &d) { return ZmTime(ZmTime::Now, d); }
+ZuInline ZmTime ZmTimeFast() { return ZmTime(ZmTime::Fast); }
 
 template <> struct ZuTraits<ZmTime> : public ZuGenericTraits<ZmTime> {
   enum { IsPOD = 1, IsHashable = 1, IsComparable = 1 };
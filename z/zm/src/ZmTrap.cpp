@@ -122,7 +122,7 @@ void ZmTrap_sigsegv(int s, siginfo_t *si, void *c)
     sigaction(SIGSEGV, &s, 0);
   }
   ZmBackTrace bt;
-  bt.capture(1);
+  bt.captureSignal(1);
   write(2, "SIGSEGV @", 10);
   {
     ZuStringN<32> buf;
@@ -0,0 +1,394 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// FIFO ring buffer with fan-in (MPSC) of variable-length messages
+
+// in-process counterpart to ZiRing's variable-length messages; each
+// message is preceded by an 8 byte header (flags, length) and padded to
+// 16 bytes; a message that would straddle the end of the buffer is
+// preceded by a skip record that pads out the remainder of the buffer;
+// the reader zeroes consumed messages so that any offset can subsequently
+// hold a header; messages are limited to half the buffer size
+
+#ifndef ZmVRing_HPP
+#define ZmVRing_HPP
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#ifndef ZmLib_HPP
+#include <zlib/ZmLib.hpp>
+#endif
+
+#include <zlib/ZmRing.hpp>
+
+template <typename T_, class NTP = ZmRing_Defaults>
+class ZmVRing : public NTP::Base, public ZmRing_ {
+  ZmVRing(const ZmVRing &);
+  ZmVRing &operator =(const ZmVRing &);	// prevent mis-use
+
+public:
+  enum { CacheLineSize = ZmPlatform::CacheLineSize };
+
+  enum { // open() flags
+    Read	= 0x00000001,
+    Write	= 0x00000002
+  };
+
+  typedef T_ T;
+
+  ZuInline static unsigned align(unsigned size) {
+    return ZmRingAlign(size);
+  }
+
+  template <typename ...Args>
+  inline ZmVRing(ZmRingParams params = ZmRingParams(0), Args &&... args) :
+      NTP::Base{ZuFwd<Args>(args)...},
+      ZmRing_(params),
+      m_flags(0), m_ctrl(0), m_data(0), m_full(0) { }
+
+  ~ZmVRing() { close(); }
+
+private:
+  enum {
+    Skip	= 0x08000000		// header - skip to end of buffer
+  };
+
+  struct Ctrl {
+    ZmAtomic<uint32_t>		head;
+    uint32_t			pad_1;
+    ZmAtomic<uint64_t>		inCount;
+    ZmAtomic<uint64_t>		inBytes;
+    char			pad_2[CacheLineSize - 24];
+
+    ZmAtomic<uint32_t>		tail;
+    uint32_t			pad_3;
+    ZmAtomic<uint64_t>		outCount;
+    ZmAtomic<uint64_t>		outBytes;
+    char			pad_4[CacheLineSize - 24];
+  };
+
+  ZuInline const Ctrl *ctrl() const { return (const Ctrl *)m_ctrl; }
+  ZuInline Ctrl *ctrl() { return (Ctrl *)m_ctrl; }
+
+  ZuInline const ZmAtomic<uint32_t> &head() const { return ctrl()->head; }
+  ZuInline ZmAtomic<uint32_t> &head() { return ctrl()->head; }
+
+  ZuInline const ZmAtomic<uint32_t> &tail() const { return ctrl()->tail; }
+  ZuInline ZmAtomic<uint32_t> &tail() { return ctrl()->tail; }
+
+  ZuInline const ZmAtomic<uint64_t> &inCount() const
+    { return ctrl()->inCount; }
+  ZuInline ZmAtomic<uint64_t> &inCount() { return ctrl()->inCount; }
+  ZuInline const ZmAtomic<uint64_t> &inBytes() const
+    { return ctrl()->inBytes; }
+  ZuInline ZmAtomic<uint64_t> &inBytes() { return ctrl()->inBytes; }
+  ZuInline const ZmAtomic<uint64_t> &outCount() const
+    { return ctrl()->outCount; }
+  ZuInline ZmAtomic<uint64_t> &outCount() { return ctrl()->outCount; }
+  ZuInline const ZmAtomic<uint64_t> &outBytes() const
+    { return ctrl()->outBytes; }
+  ZuInline ZmAtomic<uint64_t> &outBytes() { return ctrl()->outBytes; }
+
+  ZuInline ZmAtomic<uint32_t> *hdr(uint32_t offset) {
+    return (ZmAtomic<uint32_t> *)&((uint8_t *)data())[offset];
+  }
+
+public:
+  ZuInline bool operator !() const { return !m_ctrl; }
+  ZuOpBool;
+
+  ZuInline void *data() const { return m_data; }
+
+  ZuInline unsigned full() const { return m_full; }
+
+  int open(unsigned flags) {
+    if (m_ctrl) return OK;
+    if (!m_params.size()) return Error;
+    m_flags = flags & (Read | Write);
+    m_size = (m_params.size() + 15) & ~15;
+    if (!m_params.ll() && ZmRing_::open() != OK) return Error;
+    if (!m_params.cpuset())
+      m_ctrl = hwloc_alloc(ZmTopology::hwloc(), sizeof(Ctrl));
+    else
+      m_ctrl = hwloc_alloc_membind(
+	  ZmTopology::hwloc(), sizeof(Ctrl),
+	  m_params.cpuset(), HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE);
+    if (!m_ctrl) { if (!m_params.ll()) ZmRing_::close(); return Error; }
+    memset(m_ctrl, 0, sizeof(Ctrl));
+    if (!m_params.cpuset())
+      m_data = hwloc_alloc(ZmTopology::hwloc(), size());
+    else
+      m_data = hwloc_alloc_membind(
+	  ZmTopology::hwloc(), size(),
+	  m_params.cpuset(), HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE);
+    if (!m_data) {
+      hwloc_free(ZmTopology::hwloc(), m_ctrl, sizeof(Ctrl));
+      m_ctrl = 0;
+      if (!m_params.ll()) ZmRing_::close();
+      return Error;
+    }
+    memset(m_data, 0, size());
+    return OK;
+  }
+
+  void close() {
+    if (!m_ctrl) return;
+    hwloc_free(ZmTopology::hwloc(), m_ctrl, sizeof(Ctrl));
+    hwloc_free(ZmTopology::hwloc(), m_data, size());
+    m_ctrl = m_data = 0;
+    if (!m_params.ll()) ZmRing_::close();
+  }
+
+  int reset() {
+    if (!m_ctrl) return Error;
+    memset(m_ctrl, 0, sizeof(Ctrl));
+    memset(m_data, 0, size());
+    m_full = 0;
+    return OK;
+  }
+
+  inline unsigned ctrlSize() const { return sizeof(Ctrl); }
+  inline unsigned size() const { return m_size; }
+
+  unsigned length() {
+    uint32_t head = this->head().load_() & ~Mask;
+    uint32_t tail = this->tail().load_() & ~Mask;
+    if (head == tail) return 0;
+    if ((head ^ tail) == Wrapped) return size();
+    head &= ~Wrapped;
+    tail &= ~Wrapped;
+    if (head > tail) return head - tail;
+    return size() - (tail - head);
+  }
+
+  // length of a message, as passed to push()
+  ZuInline static unsigned length(const void *ptr) {
+    return ((const uint32_t *)ptr)[-1];
+  }
+
+  // writer
+
+  ZuInline void *push(unsigned size) { return push_<1>(size); }
+  ZuInline void *tryPush(unsigned size) { return push_<0>(size); }
+  template <bool Wait> inline void *push_(unsigned size) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Write);
+
+    unsigned size_ = align(size);
+    if (ZuUnlikely(size_ > (this->size()>>1))) return 0;
+
+  retry:
+    uint32_t head_ = this->head().load_();
+    if (ZuUnlikely(head_ & EndOfFile_)) return 0;
+    uint32_t head = head_ & ~Mask;
+    uint32_t tail = this->tail(); // acquire
+    uint32_t tail_ = tail & ~Mask;
+
+    unsigned free;
+    if (head == tail_)
+      free = this->size();
+    else if ((head ^ tail_) == Wrapped)
+      free = 0;
+    else if ((head ^ tail_) & Wrapped)
+      free = (tail_ & ~Wrapped) - (head & ~Wrapped);
+    else
+      free = this->size() - ((head & ~Wrapped) - (tail_ & ~Wrapped));
+
+    // pad out the end of the buffer if the message would straddle it
+    unsigned end = this->size() - (head & ~Wrapped);
+    unsigned skip = size_ > end ? end : 0;
+
+    if (ZuUnlikely(skip + size_ > free)) {
+      ++m_full;
+      if constexpr (!Wait) return 0;
+      if (ZuUnlikely(!m_params.ll()))
+	if (this->ZmRing_wait(Tail, this->tail(), tail) != OK) return 0;
+      goto retry;
+    }
+
+    head += skip + size_;
+    if ((head & ~Wrapped) >= this->size())
+      head = (head ^ Wrapped) - this->size();
+
+    if (ZuUnlikely(this->head().cmpXch(head, head_) != head_))
+      goto retry;
+
+    uint32_t offset = head_ & ~(Wrapped | Mask);
+    if (skip) {
+      ZmAtomic<uint32_t> *ptr = hdr(offset);
+      ptr[1].store_(skip);
+      if (ZuUnlikely(!m_params.ll())) {
+	if (ZuUnlikely(ptr->xch(Skip) & Waiting))
+	  this->ZmRing_wake(Head, *ptr, 1);
+      } else
+	*ptr = Skip; // release
+      offset = 0;
+    }
+    ZmAtomic<uint32_t> *ptr = hdr(offset);
+    ptr[1].store_(size);
+    return (void *)&ptr[2];
+  }
+  inline void push2(void *ptr_) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Write);
+
+    ZmAtomic<uint32_t> *ptr = &((ZmAtomic<uint32_t> *)ptr_)[-2];
+    unsigned size_ = align(ptr[1].load_());
+
+    if (ZuUnlikely(!m_params.ll())) {
+      if (ZuUnlikely(ptr->xch(Ready) & Waiting))
+	this->ZmRing_wake(Head, *ptr, 1);
+    } else
+      *ptr = Ready; // release
+
+    this->inCount().store_(this->inCount().load_() + 1);
+    this->inBytes().store_(this->inBytes().load_() + size_);
+  }
+
+  void eof(bool b = true) {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Write);
+
+    uint32_t head = this->head().load_();
+    ZmAtomic<uint32_t> *ptr = hdr(head & ~(Wrapped | Mask));
+    if (!b) {
+      *ptr = 0; // release
+      this->head() = head & ~EndOfFile_; // release
+      return;
+    }
+    if (ZuUnlikely(!m_params.ll())) {
+      if (ZuUnlikely(ptr->xch(EndOfFile_) & Waiting))
+	this->ZmRing_wake(Head, *ptr, 1);
+    } else
+      *ptr = EndOfFile_; // release
+    this->head() = head | EndOfFile_; // release
+  }
+
+  // can be called by writers after push() returns 0; returns
+  // EndOfFile, or amount of space remaining in ring buffer (>= 0)
+  int writeStatus() {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Write);
+
+    uint32_t head = this->head().load_();
+    if (ZuUnlikely(head & EndOfFile_)) return EndOfFile;
+    head &= ~Mask;
+    uint32_t tail = this->tail() & ~Mask;
+    if ((head ^ tail) == Wrapped) return 0;
+    head &= ~Wrapped;
+    tail &= ~Wrapped;
+    if (head < tail) return tail - head;
+    return size() - (head - tail);
+  }
+
+  // reader
+
+  inline T *shift() {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+
+    uint32_t tail = this->tail().load_() & ~Mask;
+  retry:
+    ZmAtomic<uint32_t> *ptr = hdr(tail & ~Wrapped);
+    uint32_t header = *ptr; // acquire
+    if (!(header & ~Waiting)) {
+      if (ZuUnlikely(!m_params.ll()))
+	if (this->ZmRing_wait(Head, *ptr, header) != OK) return 0;
+      goto retry;
+    }
+
+    if (ZuUnlikely(header & EndOfFile_)) return 0;
+    if (ZuUnlikely(header & Skip)) {
+      tail = consume(tail, ptr[1].load_());
+      goto retry;
+    }
+    return (T *)&ptr[2];
+  }
+  inline void shift2() {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+
+    uint32_t tail = this->tail().load_() & ~Mask;
+    unsigned size_ = align(hdr(tail & ~Wrapped)[1].load_());
+    consume(tail, size_);
+
+    this->outCount().store_(this->outCount().load_() + 1);
+    this->outBytes().store_(this->outBytes().load_() + size_);
+  }
+
+private:
+  // zero the consumed region and advance tail past it
+  uint32_t consume(uint32_t tail, unsigned size_) {
+    memset((void *)hdr(tail & ~Wrapped), 0, size_);
+
+    tail += size_;
+    if ((tail & ~Wrapped) >= size()) tail = (tail ^ Wrapped) - size();
+
+    if (ZuUnlikely(!m_params.ll())) {
+      if (ZuUnlikely(this->tail().xch(tail & ~Waiting) & Waiting))
+	this->ZmRing_wake(Tail, this->tail(), 1);
+    } else
+      this->tail() = tail; // release
+
+    return tail;
+  }
+
+public:
+  // can be called by a reader after shift() returns 0; returns
+  // EndOfFile (< 0), or amount of data remaining in ring buffer (>= 0)
+  int readStatus() const {
+    ZmAssert(m_ctrl);
+    ZmAssert(m_flags & Read);
+
+    uint32_t tail = this->tail().load_() & ~Mask;
+    {
+      ZmAtomic<uint32_t> *ptr =
+	const_cast<ZmVRing *>(this)->hdr(tail & ~Wrapped);
+      if (ZuUnlikely(ptr->load_() & EndOfFile_)) return EndOfFile;
+    }
+    uint32_t head = const_cast<ZmVRing *>(this)->head() & ~Mask; // acquire
+    if ((head ^ tail) == Wrapped) return size();
+    head &= ~Wrapped;
+    tail &= ~Wrapped;
+    if (head >= tail) return head - tail;
+    return size() - (tail - head);
+  }
+
+  inline void stats(
+      uint64_t &inCount, uint64_t &inBytes,
+      uint64_t &outCount, uint64_t &outBytes) const {
+    ZmAssert(m_ctrl);
+
+    inCount = this->inCount().load_();
+    inBytes = this->inBytes().load_();
+    outCount = this->outCount().load_();
+    outBytes = this->outBytes().load_();
+  }
+
+private:
+  uint32_t		m_flags;
+  void			*m_ctrl;
+  void			*m_data;
+  uint32_t		m_size;
+  uint32_t		m_full;
+};
+
+#endif /* ZmVRing_HPP */
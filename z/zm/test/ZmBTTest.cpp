@@ -25,6 +25,7 @@
 #include <stdlib.h>
 
 #include <zlib/ZmBackTrace.hpp>
+#include <zlib/ZmTime.hpp>
 #include <zlib/ZmObject.hpp>
 #include <zlib/ZmRef.hpp>
 #ifdef ZDEBUG
@@ -86,6 +87,32 @@ int main()
     std::cout << t;
   }
 
+  // symbols are cached - repeated printing should be identical and cheap
+  {
+    enum { N = 100000 };
+    ZmBackTrace t;
+    ZmTime start(ZmTime::Now);
+    for (unsigned i = 0; i < N; i++) a(t);
+    ZmTime end(ZmTime::Now);
+    std::cout << "capture: " <<
+      ZuBoxed((end - start).dtime() * 1E9 / (double)N).fmt(ZuFmt::FP<1>()) << "ns\n";
+    ZuStringN<ZmBackTrace_BUFSIZ> s1, s2;
+    start = ZmTime(ZmTime::Now);
+    s1 << t;
+    end = ZmTime(ZmTime::Now);
+    std::cout << "print: " <<
+      ZuBoxed((end - start).dtime() * 1E6).fmt(ZuFmt::FP<1>()) << "us\n";
+    start = ZmTime(ZmTime::Now);
+    for (unsigned i = 0; i < N; i++) { s2.null(); s2 << t; }
+    end = ZmTime(ZmTime::Now);
+    std::cout << "print (cached): " <<
+      ZuBoxed((end - start).dtime() * 1E6 / (double)N).fmt(ZuFmt::FP<1>()) << "us\n";
+    if (s1 != s2) {
+      std::cout << "FAILED - cached backtrace differs\n";
+      return 1;
+    }
+  }
+
 #ifdef ZmObject_DEBUG
   ZmRef<A> a = s();
 
@@ -9,6 +9,7 @@
 #include <zlib/ZmFn.hpp>
 #include <zlib/ZmTime.hpp>
 #include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmHeap.hpp>
 
 struct A {
   A(int i) : m_i(i) { }
@@ -140,6 +141,19 @@ void fail() { ZmPlatform::exit(1); }
 
 #define CHECK(x) ((x) ? puts("OK  " #x) : (fail(), puts("NOK " #x)))
 
+// count heap-allocated lambda closures
+uint64_t lambdaAllocs()
+{
+  uint64_t n = 0;
+  ZmHeapMgr::all(ZmFn<ZmHeapCache *>::fn([&n](ZmHeapCache *c) {
+    if (strcmp(c->info().id, "ZmLambda")) return;
+    ZmHeapTelemetry data;
+    c->telemetry(data);
+    n += data.cacheAllocs + data.heapAllocs;
+  }));
+  return n;
+}
+
 #if 0
 template <typename L> void isStateless(const L &l) {
   printf("%d", (int)(ZmFn<>::template LambdaStateless<L, void>::OK));
@@ -354,6 +368,66 @@ int main()
       })};
     fn();
   }
+  {
+    // inline closures
+    uint64_t allocs = lambdaAllocs();
+    ZmRef<E_> e = new E_(42);
+    int j = 0;
+    {
+      ZmFn<> fn{[e, &j]() { j += e->m_i; }};
+      CHECK(lambdaAllocs() == allocs);
+      CHECK(e->refCount() == 2);
+      ZmFn<> fn2 = fn;
+      CHECK(e->refCount() == 3);
+      ZmFn<> fn3 = ZuMv(fn2);
+      fn3();
+      fn();
+      CHECK(j == 84);
+      CHECK(fn == fn3);
+    }
+    CHECK(e->refCount() == 1);
+    char buf[ZmFn_InlineSize + 1] = { 0 };
+    {
+      ZmFn<> fn{[buf, &j]() { j += buf[0] + 1; }};
+      CHECK(lambdaAllocs() == allocs + 1);
+      fn();
+      CHECK(j == 85);
+    }
+  }
+  {
+    // allocation counting benchmark - construct, dispatch, destroy
+    const unsigned n = 10000000;
+    uint64_t j = 0;
+    {
+      uint64_t allocs = lambdaAllocs();
+      uint64_t a = 1, b = 2;
+      ZmTime begin(ZmTime::Now);
+      for (unsigned i = 0; i < n; i++) {
+	ZmFn<> fn{[a, b, i, &j]() { j += a + b + i; }};
+	ZmFn<> fn2 = ZuMv(fn);
+	fn2();
+      }
+      ZmTime end(ZmTime::Now); end -= begin;
+      std::cout << "inline lambdaFn:\t" <<
+	ZuBoxed(end.dtime()).fmt(ZuFmt::FP<9>()) << "\tallocs: " <<
+	ZuBoxed(lambdaAllocs() - allocs) << '\n';
+    }
+    {
+      uint64_t allocs = lambdaAllocs();
+      char buf[ZmFn_InlineSize + 1] = { 0 };
+      ZmTime begin(ZmTime::Now);
+      for (unsigned i = 0; i < n; i++) {
+	ZmFn<> fn{[buf, i, &j]() { j += buf[0] + i; }};
+	ZmFn<> fn2 = ZuMv(fn);
+	fn2();
+      }
+      ZmTime end(ZmTime::Now); end -= begin;
+      std::cout << "heap lambdaFn:\t" <<
+	ZuBoxed(end.dtime()).fmt(ZuFmt::FP<9>()) << "\tallocs: " <<
+	ZuBoxed(lambdaAllocs() - allocs) << '\n';
+    }
+    CHECK(j);
+  }
   {
     ZmAtomic<uint64_t> i;
     double baseline;
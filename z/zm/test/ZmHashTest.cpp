@@ -36,6 +36,8 @@
 #include <zlib/ZmSingleton.hpp>
 #include <zlib/ZmSpecific.hpp>
 #include <zlib/ZmPolymorph.hpp>
+#include <zlib/ZmRWLock.hpp>
+#include <zlib/ZmSeqLock.hpp>
 
 struct X : public ZmPolymorph {
   virtual void helloWorld();
@@ -157,6 +159,51 @@ struct J : public ZmObject {
   I	m_i;
 };
 
+// read-heavy benchmark - each thread looks up random keys, with 1 in
+// readBenchRatio operations deleting and re-adding a key
+int readBenchKeys = 10000;
+int readBenchOps = 100000;
+int readBenchRatio = 100;
+
+template <typename H>
+void readBenchThread(H *h, unsigned seed, bool *failed)
+{
+  uint32_t k = seed * 7919 + 1;
+  for (int i = 0; i < readBenchOps; i++) {
+    k = k * 1103515245 + 12345;
+    int key = (k>>8) % readBenchKeys;
+    if (!(i % readBenchRatio)) {
+      h->del(key);
+      h->add(key, key);
+    } else {
+      int val = h->findVal(key);
+      if (!H::ValCmp::null(val) && val != key) *failed = true;
+    }
+  }
+}
+
+template <typename H>
+void readBench(const char *name)
+{
+  for (unsigned n = 1; n <= 32; n <<= 1) {
+    ZmRef<H> h = new H(ZmHashParams().bits(14).loadFactor(1.0).cBits(6));
+    for (int i = 0; i < readBenchKeys; i++) h->add(i, i);
+    bool failed = false;
+    ZmThread r[32];
+    ZmTime start(ZmTime::Now);
+    for (unsigned i = 0; i < n; i++)
+      r[i] = ZmThread(0, ZmFn<>([h = h.ptr(), i, failed = &failed]() {
+	readBenchThread(h, i, failed);
+      }));
+    for (unsigned i = 0; i < n; i++) r[i].join(0);
+    ZmTime end(ZmTime::Now);
+    end -= start;
+    printf("%s threads: %2u  ops/s: %10.0f%s\n",
+	name, n, (double)n * readBenchOps / end.dtime(),
+	failed ? "  FAILED" : "");
+  }
+}
+
 int main(int argc, char **argv)
 {
   ZmTime overallStart, overallEnd;
@@ -164,6 +211,7 @@ int main(int argc, char **argv)
   overallStart.now();
 
   if (argc > 1) hashTestSize = atoi(argv[1]);
+  if (argc > 2) readBenchOps = atoi(argv[2]);
 
   ZmThread r[80];
   int j, k;
@@ -246,4 +294,10 @@ int main(int argc, char **argv)
       puts("");
     }
   }
+
+  readBench<ZmHash<int, ZmHashVal<int> > >("ZmLock:   ");
+  readBench<ZmHash<int, ZmHashVal<int,
+    ZmHashLock<ZmRWLock> > > >("ZmRWLock: ");
+  readBench<ZmHash<int, ZmHashVal<int,
+    ZmHashLock<ZmSeqLock<> > > > >("ZmSeqLock:");
 }
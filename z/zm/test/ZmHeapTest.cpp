@@ -32,6 +32,7 @@
 #include <zlib/ZmHeap.hpp>
 #include <zlib/ZmThread.hpp>
 #include <zlib/ZmFn.hpp>
+#include <zlib/ZmRing.hpp>
 
 static bool verbose = false;
 
@@ -60,27 +61,95 @@ void doit()
   }
 }
 
+// cross-thread producer/consumer - blocks are allocated by the producer
+// and freed by the consumer, so each thread's magazine is continually
+// drained (producer) or filled (consumer)
+
+typedef ZmRing<S *> Ring;
+
+static Ring *rings = 0;
+
+void produce(Ring *ring)
+{
+  for (unsigned i = 0; i < count; ) {
+    void *ptr = ring->push();
+    if (ZuUnlikely(!ptr)) continue;
+    S *s = new S(i++);
+    new (ptr) S *(s);
+    ring->push2(ptr);
+  }
+  ring->eof();
+}
+
+void consume(Ring *ring)
+{
+  while (S *const *ptr = ring->shift()) {
+    S *s = *ptr;
+    ring->shift2();
+    s->doit();
+    delete s;
+  }
+}
+
 void usage()
 {
   fputs(
-"usage: ZmHeapTest COUNT SIZE NTHR [VERB]\n\n"
+"usage: ZmHeapTest [-m MAG] [-a SLABS] [-x] COUNT SIZE NTHR [VERB]\n\n"
 "    COUNT\t- number of iterations\n"
 "    SIZE\t- size of heap\n"
 "    NTHR\t- number of threads\n"
-"    VERB\t- verbose (0 | 1 - defaults to 0)\n"
+"    VERB\t- verbose (0 | 1 - defaults to 0)\n\n"
+"Options:\n"
+"    -m MAG\t- per-thread magazine size (defaults to 0 - disabled)\n"
+"    -a SLABS\t- arena mode - preallocate SLABS 2MB huge-page slabs\n"
+"    -x\t\t- cross-thread - NTHR producer/consumer pairs\n"
 , stderr);
   ZmPlatform::exit(1);
 }
 
 int main(int argc, char **argv)
 {
+  unsigned magazine = 0;
+  unsigned arena = 0;
+  bool xthread = false;
+  int i;
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    switch (argv[i][1]) {
+      case 'm':
+	if (++i >= argc) usage();
+	magazine = atoi(argv[i]);
+	break;
+      case 'a':
+	if (++i >= argc) usage();
+	arena = atoi(argv[i]);
+	break;
+      case 'x':
+	xthread = true;
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+  argc -= i - 1, argv += i - 1;
   if (argc < 4 || argc > 5) usage();
   count = atoi(argv[1]);
   int size = atoi(argv[2]);
   int nthr = atoi(argv[3]);
   if (argc == 5) verbose = atoi(argv[4]);
   if (!count || !nthr) usage();
-  ZmHeapMgr::init("S", 0, ZmHeapConfig{0, (unsigned)size});
+  ZmHeapMgr::init("S", 0, ZmHeapConfig{0, (unsigned)size, {}, 0, magazine, arena});
+  if (xthread) {
+    rings = (Ring *)::malloc(sizeof(Ring) * nthr);
+    for (int i = 0; i < nthr; i++) {
+      new (&rings[i]) Ring(ZmRingParams(65536));
+      if (rings[i].open(Ring::Read | Ring::Write) != Ring::OK) {
+	fputs("ring open failed\n", stderr);
+	ZmPlatform::exit(1);
+      }
+    }
+    nthr <<= 1;
+  }
   ZmThread *threads;
 #ifdef __GNUC__
   threads = (ZmThread *)alloca(sizeof(ZmThread) * nthr);
@@ -99,10 +168,22 @@ int main(int argc, char **argv)
   }
   ZmTime start(ZmTime::Now);
   for (int i = 0; i < nthr; i++)
-    new (&threads[i]) ZmThread(0, ZmFn<>::Ptr<&doit>::fn());
+    if (!xthread)
+      new (&threads[i]) ZmThread(0, ZmFn<>::Ptr<&doit>::fn());
+    else if (!(i & 1))
+      new (&threads[i]) ZmThread(0, ZmFn<>::Bound<&consume>::fn(&rings[i>>1]));
+    else
+      new (&threads[i]) ZmThread(0, ZmFn<>::Bound<&produce>::fn(&rings[i>>1]));
   for (int i = 0; i < nthr; i++)
     threads[i].join();
   ZmTime end(ZmTime::Now);
+  if (xthread) {
+    for (int i = 0; i < (nthr>>1); i++) {
+      rings[i].close();
+      rings[i].~Ring();
+    }
+    ::free(rings);
+  }
   end -= start;
   printf("%u.%09u\n", (unsigned)end.sec(), (unsigned)end.nsec());
   std::cout << ZmHeapMgr::csv();
@@ -0,0 +1,89 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/* ZmHistogram test program */
+
+#include <zlib/ZuLib.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include <zlib/ZmHistogram.hpp>
+#include <zlib/ZmRandom.hpp>
+#include <zlib/ZmTime.hpp>
+
+typedef ZmHistogram<> Hist;
+
+void fail(const char *s, uint64_t v, uint64_t w)
+{
+  printf("FAILED %s: %llu %llu\n", s,
+      (unsigned long long)v, (unsigned long long)w);
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned count = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (!count) {
+    fputs("usage: ZmHistogramTest [count]\n", stderr);
+    return 1;
+  }
+
+  // buckets are contiguous and each value maps to the bucket it bounds
+  for (unsigned i = 1; i < Hist::N; i++) {
+    uint64_t v = Hist::value(i - 1) + 1;
+    if (Hist::index(v) != i) fail("index", v, i);
+    if (Hist::index(Hist::value(i)) != i) fail("value", Hist::value(i), i);
+  }
+
+  // percentiles are within the relative error bound (log-uniform values)
+  static Hist hist;
+  uint64_t *values = new uint64_t[count];
+  for (unsigned i = 0; i < count; i++) {
+    uint64_t v = (uint64_t)1<<ZmRand::randInt(31);
+    hist.record(values[i] = v + (uint64_t)ZmRand::randExc((double)v));
+  }
+  std::sort(values, values + count);
+  static const double p[] = { 0, 50, 90, 99, 99.9, 100 };
+  for (unsigned i = 0; i < sizeof(p) / sizeof(p[0]); i++) {
+    unsigned j = (unsigned)((p[i] / 100.0) * (double)count + 0.5);
+    if (j) --j;
+    uint64_t exact = values[j];
+    uint64_t v = hist.percentile(p[i]);
+    if (v < exact || v - exact > (exact>>Hist::SubBits))
+      fail("percentile", v, exact);
+    printf("%g%%:\t%llu\t(exact %llu)\n", p[i],
+	(unsigned long long)v, (unsigned long long)exact);
+  }
+  if (hist.max() != values[count - 1])
+    fail("max", hist.max(), values[count - 1]);
+
+  // cost of record()
+  hist.reset();
+  ZmTime start(ZmTime::Now);
+  for (unsigned i = 0; i < count; i++) hist.record(values[i]);
+  ZmTime end(ZmTime::Now);
+  if (hist.count() != count) fail("count", hist.count(), count);
+  printf("record():\t%.1fns\n", (end - start).dtime() * 1E9 / (double)count);
+
+  delete [] values;
+  return 0;
+}
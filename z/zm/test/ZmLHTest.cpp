@@ -33,6 +33,7 @@
 #include <zlib/ZmLock.hpp>
 #include <zlib/ZmHash.hpp>
 #include <zlib/ZmLHash.hpp>
+#include <zlib/ZmGHash.hpp>
 #include <zlib/ZmNoLock.hpp>
 #include <zlib/ZmRWLock.hpp>
 #include <zlib/ZmTime.hpp>
@@ -107,6 +108,9 @@ typedef ZmHash<S,
 typedef ZmLHash<S,
 	  ZmLHashVal<int,
 	    ZmLHashLock<ZmNoLock> > > LHash;
+typedef ZmGHash<S,
+	  ZmLHashVal<int,
+	    ZmLHashLock<ZmNoLock> > > GHash;
 
 template <typename H>
 struct HashAdapter {
@@ -280,6 +284,7 @@ template <typename H, template <typename> class A> void funcTest()
 
 typedef ZmHash<int, ZmHashVal<String<16>, ZmHashLock<ZmLock> > > PerfHash;
 typedef ZmLHash<int, ZmLHashVal<String<16>, ZmLHashLock<ZmLock> > > PerfLHash;
+typedef ZmGHash<int, ZmLHashVal<String<16>, ZmLHashLock<ZmLock> > > PerfGHash;
 
 int perfTestSize = 1000;
 
@@ -319,12 +324,71 @@ template <typename H, template <typename> class A> void perfTest()
   for (int bits = 8; bits < 12; bits++) perfTest_<H, A>(bits);
 }
 
+// lookup benchmark - integer keys and string keys
+typedef ZmLHash<uint64_t,
+	  ZmLHashVal<uint64_t,
+	    ZmLHashLock<ZmNoLock> > > IntLHash;
+typedef ZmGHash<uint64_t,
+	  ZmLHashVal<uint64_t,
+	    ZmLHashLock<ZmNoLock> > > IntGHash;
+typedef ZmLHash<S,
+	  ZmLHashVal<uint64_t,
+	    ZmLHashLock<ZmNoLock> > > StrLHash;
+typedef ZmGHash<S,
+	  ZmLHashVal<uint64_t,
+	    ZmLHashLock<ZmNoLock> > > StrGHash;
+
+inline void lookupKey(uint64_t &key, uint64_t v) { key = v; }
+inline void lookupKey(S &key, uint64_t v) {
+  snprintf(key.data(), 16, "%llx",
+      (unsigned long long)(v & 0xffffffffffffULL));	// 48 bits fits in S
+}
+
+int lookupBits = 16;
+int lookupCount = 10000000;
+
+// fill to the given load, then time alternating hits and misses
+template <typename H> void lookupBench(const char *name, double load)
+{
+  typedef typename H::Key Key;
+
+  ZmRef<H> h_ = new H(ZmHashParams().bits(lookupBits).loadFactor(1.0));
+  H &h = *h_;
+  unsigned n = (unsigned)((double)(1U<<lookupBits) * load);
+  Key *keys = new Key[n];
+  uint64_t seed = 1;
+  for (unsigned i = 0; i < n; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    seed &= ~(uint64_t)1;		// even keys are hits, odd keys are misses
+    lookupKey(keys[i], seed);
+    h.add(keys[i], seed);
+    lookupKey(keys[i], seed | (i & 1));
+  }
+  uint64_t sum = 0;
+  unsigned hits = 0;
+  ZmTime start, end;
+  start.now();
+  for (unsigned i = 0, j = 0; i < (unsigned)lookupCount; i++) {
+    uint64_t v = h.findVal(keys[j]);
+    if (!ZuCmp<uint64_t>::null(v)) sum += v, hits++;
+    if (++j >= n) j = 0;
+  }
+  end.now();
+  end -= start;
+  printf("%s load %.3f: %10.0f lookups/s  hits %u\n", name,
+      (double)h.count_() / (double)(1U<<h.bits()),
+      (double)lookupCount / end.dtime(), hits);
+  if (sum == 1) puts("");	// prevent elision
+  delete [] keys;
+}
+
 int main(int argc, char **argv)
 {
   ZmTime start, end;
 
   funcTest<Hash, HashAdapter>();
   funcTest<LHash, LHashAdapter>();
+  funcTest<GHash, LHashAdapter>();
 
   if (argc > 1) perfTestSize = atoi(argv[1]);
   if (argc > 2) concurrency = atoi(argv[2]);
@@ -344,4 +408,21 @@ int main(int argc, char **argv)
   end -= start;
   printf("ZmLHash time: %d.%.3d\n",
     (int)end.sec(), (int)(end.nsec() / 1000000));
+
+  start.now();
+  for (int i = 0; i < 10; i++) perfTest<PerfGHash, LHashAdapter>();
+  end.now();
+  end -= start;
+  printf("ZmGHash time: %d.%.3d\n",
+    (int)end.sec(), (int)(end.nsec() / 1000000));
+
+  if (argc > 3) lookupCount = atoi(argv[3]);
+
+  static const double loads[] = { 0.5, 0.75, 0.85 };
+  for (unsigned i = 0; i < sizeof(loads) / sizeof(loads[0]); i++) {
+    lookupBench<IntLHash>("ZmLHash int", loads[i]);
+    lookupBench<IntGHash>("ZmGHash int", loads[i]);
+    lookupBench<StrLHash>("ZmLHash str", loads[i]);
+    lookupBench<StrGHash>("ZmGHash str", loads[i]);
+  }
 }
@@ -30,6 +30,10 @@
 #include <zlib/ZmRandom.hpp>
 #include <zlib/ZmObject.hpp>
 #include <zlib/ZmRef.hpp>
+#include <zlib/ZmTime.hpp>
+#include <zlib/ZmPLock.hpp>
+#include <zlib/ZmMCSLock.hpp>
+#include <zlib/ZmALock.hpp>
 
 struct Lock : public ZmObject {
   inline Lock(unsigned rn) : m_rn(rn), m_nThreads(0) { }
@@ -97,14 +101,91 @@ void *run(void *c_)
   return 0;
 }
 
+// lock+unlock benchmark
+
+#ifndef _WIN32
+struct PThread {
+  ZuInline PThread() { pthread_mutex_init(&m_lock, 0); }
+  ZuInline ~PThread() { pthread_mutex_destroy(&m_lock); }
+  ZuInline void lock() { pthread_mutex_lock(&m_lock); }
+  ZuInline void unlock() { pthread_mutex_unlock(&m_lock); }
+
+private:
+  pthread_mutex_t	m_lock;
+};
+#endif
+
+template <typename Lock> struct B {
+  Lock			lock;
+  ZmAtomic<unsigned>	ready;
+  ZmAtomic<unsigned>	go;
+  unsigned		count = 0;	// per thread
+  unsigned		total = 0;	// protected by lock
+};
+
+template <typename Lock> void *bench_(void *b_)
+{
+  B<Lock> *b = (B<Lock> *)b_;
+  ++b->ready;
+  while (!b->go) ZmPlatform::yield();
+  for (unsigned i = 0, n = b->count; i < n; i++) {
+    b->lock.lock();
+    ++b->total;
+    b->lock.unlock();
+  }
+  return 0;
+}
+
+template <typename Lock> void bench(const char *name, unsigned count)
+{
+  static const unsigned nthreads[] = { 1, 2, 4, 8, 16 };
+  printf("%s:", name);
+  for (unsigned j = 0; j < sizeof(nthreads) / sizeof(nthreads[0]); j++) {
+    unsigned n = nthreads[j];
+    B<Lock> b;
+    b.count = count / n;
+    pthread_t *tids = (pthread_t *)alloca(n * sizeof(pthread_t));
+    for (unsigned i = 0; i < n; i++)
+      pthread_create(&tids[i], 0, &bench_<Lock>, (void *)&b);
+    while (b.ready < n) ZmPlatform::yield();
+    ZmTime start(ZmTime::Now);
+    b.go = 1;
+    for (unsigned i = 0; i < n; i++) pthread_join(tids[i], 0);
+    ZmTime end(ZmTime::Now);
+    if (b.total != b.count * n) {
+      printf(" FAILED (%u != %u)\n", b.total, b.count * n);
+      ZmPlatform::exit(1);
+    }
+    end -= start;
+    printf("\t%u:%.1fns", n, end.dtime() * 1E9 / (double)(b.count * n));
+    fflush(stdout);
+  }
+  putchar('\n');
+}
+
 void usage()
 {
-  fputs("usage: ZmLockTest nthreads nrecords maxdelay\n", stderr);
+  fputs("usage: ZmLockTest2 nthreads nrecords maxdelay\n"
+	"       ZmLockTest2 -b [count]\n"
+	"\n"
+	"  -b\treport lock+unlock cost with 1-16 threads\n", stderr);
   ZmPlatform::exit(1);
 }
 
 int main(int argc, char **argv)
 {
+  if (argc > 1 && argv[1][0] == '-' && argv[1][1] == 'b') {
+    if (argc > 3) usage();
+    unsigned count = argc > 2 ? atoi(argv[2]) : 10000000;
+    if (!count) usage();
+    bench<ZmPLock>("ZmPLock", count);
+#ifndef _WIN32
+    bench<PThread>("PThread", count);
+#endif
+    bench<ZmMCSLock>("ZmMCSLock", count);
+    bench<ZmALock>("ZmALock", count);
+    ZmPlatform::exit(0);
+  }
   if (argc != 4) usage();
   int nthreads = atoi(argv[1]);
   nrecords = atoi(argv[2]);
@@ -4,11 +4,15 @@
 #include <zlib/ZuLib.hpp>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <zlib/ZmObject.hpp>
 #include <zlib/ZmRef.hpp>
 #include <zlib/ZmQueue.hpp>
+#include <zlib/ZmCQueue.hpp>
+#include <zlib/ZmAtomic.hpp>
+#include <zlib/ZmTime.hpp>
 
 typedef ZmQueue<int, ZmQueueID<unsigned char> > Queue;
 typedef ZmQueue<int> Queue2;
@@ -37,8 +41,156 @@ void check(Queue &queue, int *l, int m)
   }
 }
 
+// concurrent benchmark - producers push disjoint keys, a canceller deletes
+// every 4th key, the consumer (main thread) shifts until the queue drains;
+// each key must be either shifted or deleted exactly once
+
+#ifndef _WIN32
+template <typename Queue> struct B {
+  Queue			queue;
+  unsigned		count = 0;	// total
+  unsigned		nProducers = 0;
+  ZmAtomic<unsigned>	ready;
+  ZmAtomic<unsigned>	go;
+  ZmAtomic<unsigned>	done;
+  ZmAtomic<uint32_t>	*seen = nullptr;
+};
+
+template <typename Queue> struct BThread {
+  B<Queue>	*b;
+  unsigned	id;
+};
+
+template <typename Queue> void *produce(void *t_)
+{
+  BThread<Queue> *t = (BThread<Queue> *)t_;
+  B<Queue> *b = t->b;
+  unsigned n = b->count / b->nProducers;
+  int base = t->id * n;
+  ++b->ready;
+  while (!b->go) ZmPlatform::yield();
+  for (unsigned i = 0; i < n; i++) b->queue.push(base + (int)i);
+  ++b->done;
+  return 0;
+}
+
+template <typename Queue> void *cancel(void *b_)
+{
+  B<Queue> *b = (B<Queue> *)b_;
+  ++b->ready;
+  while (!b->go) ZmPlatform::yield();
+  for (unsigned i = 0; i < b->count; i += 4)
+    if (b->queue.del((int)i)) ++b->seen[i];
+  ++b->done;
+  return 0;
+}
+
+template <typename Queue>
+void bench(const char *name, unsigned nProducers, unsigned count)
+{
+  B<Queue> b;
+  b.count = (count / nProducers) * nProducers;
+  b.nProducers = nProducers;
+  b.seen = new ZmAtomic<uint32_t>[b.count];
+  pthread_t *tids = (pthread_t *)alloca((nProducers + 1) * sizeof(pthread_t));
+  BThread<Queue> *threads =
+    (BThread<Queue> *)alloca(nProducers * sizeof(BThread<Queue>));
+  for (unsigned i = 0; i < nProducers; i++) {
+    threads[i].b = &b;
+    threads[i].id = i;
+    pthread_create(&tids[i], 0, &produce<Queue>, (void *)&threads[i]);
+  }
+  pthread_create(&tids[nProducers], 0, &cancel<Queue>, (void *)&b);
+  while (b.ready < nProducers + 1) ZmPlatform::yield();
+  ZmTime start(ZmTime::Now);
+  b.go = 1;
+  for (;;) {
+    bool done = b.done == nProducers + 1;
+    int k = b.queue.shift();
+    if (ZuCmp<int>::null(k)) {
+      if (done) break;
+      ZmPlatform::yield();
+      continue;
+    }
+    ++b.seen[k];
+  }
+  ZmTime end(ZmTime::Now);
+  for (unsigned i = 0; i <= nProducers; i++) pthread_join(tids[i], 0);
+  for (unsigned i = 0; i < b.count; i++)
+    if (b.seen[i] != 1) {
+      printf("%s FAILED - key %u seen %u times\n",
+	  name, i, (unsigned)b.seen[i].load_());
+      ZmPlatform::exit(1);
+    }
+  delete [] b.seen;
+  end -= start;
+  printf("%s %u producers: %.1fns/item\n", name, nProducers,
+      end.dtime() * 1E9 / (double)b.count);
+  fflush(stdout);
+}
+#endif
+
+typedef ZmCQueue<int> CQueue;
+
+// key counting live instances, to detect leaked CQueue items
+struct CKey {
+  static ZmAtomic<int> live;
+
+  CKey() : v(-1) { ++live; }
+  CKey(int v_) : v(v_) { ++live; }
+  CKey(const CKey &k) : v(k.v) { ++live; }
+  CKey &operator =(const CKey &k) { v = k.v; return *this; }
+  ~CKey() { --live; }
+
+  bool operator ==(const CKey &k) const { return v == k.v; }
+  bool operator <(const CKey &k) const { return v < k.v; }
+  bool operator >(const CKey &k) const { return v > k.v; }
+  bool operator !() const { return v < 0; }
+  uint32_t hash() const { return ZuHash<int>::hash(v); }
+
+  int	v;
+};
+ZmAtomic<int> CKey::live;
+template <> struct ZuTraits<CKey> : public ZuGenericTraits<CKey> {
+  enum { IsHashable = 1 };
+};
+
 int main(int argc, char **argv)
 {
+  {
+    CQueue q;
+
+    for (int i = 0; i < 100; i++) q.push(i);
+    for (int i = 0; i < 100; i += 2) q.del(i);
+    q.push(1); // re-push - moves 1 to the tail
+    if (q.count() != 50 || q.find(0) || !q.find(3))
+      printf("CQueue find/del failed (count %u)\n", q.count());
+    for (int i = 3; i < 100; i += 2)
+      if (i != q.shift()) {
+	printf("CQueue shift() failed @%d\n", i);
+	break;
+      }
+    if (q.shift() != 1 || !ZuCmp<int>::null(q.shift()) || q.count())
+      puts("CQueue shift() failed @1");
+    puts("CQueue done"); fflush(stdout);
+  }
+
+  {
+    int live = CKey::live;
+    {
+      ZmCQueue<CKey> q;
+
+      // deleted and re-pushed items are released when the queue is
+      // destroyed, even though they were never shifted
+      for (int i = 0; i < 1000; i++) q.push(CKey{i});
+      for (int i = 0; i < 1000; i += 2) q.del(CKey{i});
+      for (int i = 1; i < 1000; i += 4) q.push(CKey{i});
+    }
+    if (CKey::live != live)
+      printf("CQueue leaked %d keys\n", CKey::live - live);
+    puts("CQueue clean done"); fflush(stdout);
+  }
+
   {
     Queue queue;
 
@@ -96,4 +248,15 @@ int main(int argc, char **argv)
       }
     puts("q2 shift() done"); fflush(stdout);
   }
+
+#ifndef _WIN32
+  if (argc > 1) {
+    unsigned count = atoi(argv[1]);
+    if (!count) count = 1000000;
+    for (unsigned n = 1; n <= 4; n <<= 1) {
+      bench<Queue2>("ZmQueue", n, count);
+      bench<CQueue>("ZmCQueue", n, count);
+    }
+  }
+#endif
 }
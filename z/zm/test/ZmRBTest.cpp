@@ -17,7 +17,7 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 
-/* red/black tree test program */
+/* red/black tree / B+tree test program */
 
 #include <zlib/ZuLib.hpp>
 
@@ -30,7 +30,9 @@
 #include <zlib/ZmRef.hpp>
 #include <zlib/ZmObject.hpp>
 #include <zlib/ZmRBTree.hpp>
+#include <zlib/ZmBTree.hpp>
 #include <zlib/ZmNoLock.hpp>
+#include <zlib/ZmTime.hpp>
 
 class Z : public ZmObject {
 public:
@@ -50,19 +52,22 @@ template <> struct ZuTraits<Z> {
   enum { IsComparable = 1, IsReal = 0, IsBase = 0 };
 };
 
-typedef ZmRBTree<ZmRef<Z>, ZmRBTreeCmp<ZCmp> > Tree;
+typedef ZmRBTree<ZmRef<Z>, ZmRBTreeCmp<ZCmp> > RBTree;
+typedef ZmBTree<ZmRef<Z>, ZmRBTreeCmp<ZCmp> > BTree;
 
+template <typename Tree>
 static void delptr(Tree *tree, Z *z) {
   tree->del(z, z);
 #if 0
   auto iter = tree->iterator<ZmRBTreeEqual>(z);
-  Tree::NodeRef node;
+  typename Tree::NodeRef node;
 
   while (node = iter.iterate()) if (z == node->key()) { iter.del(); return; }
 #endif
 }
 
-int main()
+template <typename Tree, typename Tree2>
+void funcTest()
 {
   Tree tree;
   ZmRef<Z> z;
@@ -73,7 +78,7 @@ int main()
   fputs("0 to 19: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -86,8 +91,8 @@ int main()
 
   fputs("17 to 1, odd: ", stdout);
   {
-    auto iter = tree.iterator<ZmRBTreeLess>();
-    Tree::NodeRef node;
+    auto iter = tree.template iterator<ZmRBTreeLess>();
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -101,8 +106,8 @@ int main()
   fputs("7 to 19, odd: ", stdout);
   {
     ZmRef<Z> iz = new Z(i);
-    auto iter = tree.iterator<ZmRBTreeGreater>(iz);
-    Tree::NodeRef node;
+    auto iter = tree.template iterator<ZmRBTreeGreater>(iz);
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -116,8 +121,8 @@ int main()
   fputs("1 to 7, odd: ", stdout);
   {
     ZmRef<Z> iz = new Z(i);
-    auto iter = tree.iterator<ZmRBTreeLessEqual>(iz);
-    Tree::NodeRef node;
+    auto iter = tree.template iterator<ZmRBTreeLessEqual>(iz);
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -134,7 +139,7 @@ int main()
   fputs("20 to 39 #1: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -149,7 +154,7 @@ int main()
   fputs("0 to 19 #1: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -164,7 +169,7 @@ int main()
   fputs("20 to 39 #2: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -179,7 +184,7 @@ int main()
   fputs("0 to 19 #2: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -195,7 +200,7 @@ int main()
   fputs("20 to 39 #3: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -211,7 +216,7 @@ int main()
   fputs("0 to 19 #3: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -227,7 +232,7 @@ int main()
   fputs("20 to 39 #4: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -243,7 +248,7 @@ int main()
   fputs("0 to 19 #4: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -260,7 +265,7 @@ int main()
   fputs("20 to 39 #5: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -277,7 +282,7 @@ int main()
   fputs("0 to 19 #5: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -294,7 +299,7 @@ int main()
   fputs("20 to 39 #6: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -311,7 +316,7 @@ int main()
   fputs("0 to 19 #6: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -329,7 +334,7 @@ int main()
     fputs("0 to 9 with 4 duplicates: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -341,7 +346,7 @@ int main()
     fputs("0 to 9 with 3 duplicates: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -353,7 +358,7 @@ int main()
     fputs("0 to 9 with 2 duplicates: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -365,7 +370,7 @@ int main()
     fputs("0 to 9 with 1 duplicate: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -377,7 +382,7 @@ int main()
     fputs("empty: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -394,7 +399,7 @@ int main()
     fputs("0 to 9 with 4 duplicates: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -409,7 +414,7 @@ int main()
     fputs("0 to 9, odd, with 3 duplicates: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -421,8 +426,8 @@ int main()
     fputs("5 to 9, odd, with 3 duplicates: ", stdout);
     {
       ZmRef<Z> iz = new Z(i);
-      auto iter = tree.iterator<ZmRBTreeGreater>(iz);
-      Tree::NodeRef node;
+      auto iter = tree.template iterator<ZmRBTreeGreater>(iz);
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -434,7 +439,7 @@ int main()
     fputs("0 to 9, odd, with 2 duplicates: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -446,7 +451,7 @@ int main()
     fputs("0 to 9, odd, with 1 duplicate: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -458,7 +463,7 @@ int main()
     fputs("empty: ", stdout);
     {
       auto iter = tree.iterator();
-      Tree::NodeRef node;
+      typename Tree::NodeRef node;
 
       while (node = iter.iterate())
 	printf("%d ", node->key()->m_z);
@@ -478,7 +483,7 @@ int main()
 
   {
     ZmRef<Z> iz = new Z(i);
-    Tree::NodeRef node = tree.find(iz);
+    typename Tree::NodeRef node = tree.find(iz);
 
     if (node) z = node->key(); else z = 0;
   }
@@ -511,7 +516,7 @@ int main()
   fputs("0 to 19, deleting all elements: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate()) {
       printf("%d ", node->key()->m_z);
@@ -527,7 +532,7 @@ int main()
   fputs("0 to 19, deleting odd elements: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate()) {
       printf("%d ", (z = node->key())->m_z);
@@ -539,7 +544,7 @@ int main()
   fputs("0 to 18, even: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -555,7 +560,7 @@ int main()
   fputs("0 to 19 with 3 duplicates, deleting every fourth element: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
     int j = 0;
 
     while (node = iter.iterate()) {
@@ -571,8 +576,8 @@ int main()
   fputs("0 to 19 reverse order, remaining duplicates: ", stdout);
   {
     ZmRef<Z> iz = new Z(i);
-    auto iter = tree.iterator<ZmRBTreeLess>(iz);
-    Tree::NodeRef node;
+    auto iter = tree.template iterator<ZmRBTreeLess>(iz);
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -590,8 +595,8 @@ int main()
   fputs("0 to 19 with 3 duplicates reverse order, deleting every fourth element: ", stdout);
   {
     ZmRef<Z> iz = new Z(i);
-    auto iter = tree.iterator<ZmRBTreeLess>(iz);
-    Tree::NodeRef node;
+    auto iter = tree.template iterator<ZmRBTreeLess>(iz);
+    typename Tree::NodeRef node;
     int j = 0;
 
     while (node = iter.iterate()) {
@@ -605,7 +610,7 @@ int main()
   fputs("0 to 19, remaining duplicates: ", stdout);
   {
     auto iter = tree.iterator();
-    Tree::NodeRef node;
+    typename Tree::NodeRef node;
 
     while (node = iter.iterate())
       printf("%d ", node->key()->m_z);
@@ -617,7 +622,7 @@ int main()
   tree.clean();
 
   {
-    ZmRBTree<uint64_t> tree2;
+    Tree2 tree2;
     uint64_t add[] = {
       0x7fd2c4296790, 0x7fd2c4296800, 0x7fd2c4296870, 0x7fd2c42a2f80,
       0x7fd2c42975d0, 0x7fd2c4297640, 0x7fd2c429a870, 0x7fd2c42a2490,
@@ -634,3 +639,71 @@ int main()
     printf("tree2 count: %u\n", (unsigned)tree2.count());
   }
 }
+
+// side-by-side benchmark - add, find, iterate, delete n random keys
+
+typedef ZmRBTree<uint64_t, ZmRBTreeLock<ZmNoLock> > PerfRBTree;
+typedef ZmBTree<uint64_t, ZmRBTreeLock<ZmNoLock> > PerfBTree;
+
+template <typename Tree>
+void perfTest(const char *name, const uint64_t *keys, unsigned n)
+{
+  Tree tree;
+  ZmTime t[6];
+  uint64_t sum = 0;
+
+  t[0].now();
+  for (unsigned i = 0; i < n; i++) tree.add(keys[i]);
+  t[1].now();
+  for (unsigned i = 0; i < n; i++) sum += tree.findPtr(keys[i])->key();
+  t[2].now();
+  {
+    auto iter = tree.template readIterator<ZmRBTreeGreaterEqual>();
+    while (auto node = iter.iterate()) sum += node->key();
+  }
+  t[3].now();
+  for (unsigned i = 0; i < n; i++) {
+    auto iter =
+      tree.template readIterator<ZmRBTreeLessEqual>(keys[i]);
+    for (unsigned j = 0; j < 4; j++)
+      if (auto node = iter.iterate()) sum += node->key(); else break;
+  }
+  t[4].now();
+  for (unsigned i = 0; i < n; i++) tree.del(keys[i]);
+  t[5].now();
+
+  printf("%s (%u keys, checksum %llx)\n", name, n, (unsigned long long)sum);
+  static const char *ops[] = {
+    "add", "find", "iterate", "find+iterate(4)", "del"
+  };
+  for (unsigned i = 5; i > 0; --i) t[i] -= t[i - 1];
+  for (unsigned i = 0; i < 5; i++)
+    printf("  %-16s %8.2f ns/key\n", ops[i], t[i + 1].dtime() * 1E9 / n);
+  if (tree.count()) puts("  count() != 0 after deletion");
+}
+
+int main(int argc, char **argv)
+{
+  puts("ZmRBTree:");
+  funcTest<RBTree, ZmRBTree<uint64_t> >();
+  puts("ZmBTree:");
+  funcTest<BTree, ZmBTree<uint64_t> >();
+
+  unsigned n = argc > 1 ? atoi(argv[1]) : 0;
+  if (!n) n = 1000000;
+  uint64_t *keys = new uint64_t[n];
+  {
+    uint64_t x = 0x9e3779b97f4a7c15ULL;
+    for (unsigned i = 0; i < n; i++) {
+      x ^= x<<13; x ^= x>>7; x ^= x<<17;
+      keys[i] = x;
+    }
+  }
+  for (unsigned m = 1000; m < n; m *= 100) {
+    perfTest<PerfRBTree>("ZmRBTree", keys, m);
+    perfTest<PerfBTree>("ZmBTree", keys, m);
+  }
+  perfTest<PerfRBTree>("ZmRBTree", keys, n);
+  perfTest<PerfBTree>("ZmBTree", keys, n);
+  delete [] keys;
+}
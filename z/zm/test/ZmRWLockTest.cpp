@@ -8,6 +8,9 @@
 #include <zlib/ZmObject.hpp>
 #include <zlib/ZmRef.hpp>
 #include <zlib/ZmRWLock.hpp>
+#include <zlib/ZmBRWLock.hpp>
+#include <zlib/ZmGuard.hpp>
+#include <zlib/ZmTime.hpp>
 #include <zlib/ZmSingleton.hpp>
 #include <zlib/ZmList.hpp>
 #include <zlib/ZmFn.hpp>
@@ -147,14 +150,15 @@ void Work::dump(int tid, const char *prePost, ZmRWLock &lock)
   ZmTime now = ZmTimeNow();
   ZmTime stamp = now - Global::started();
 
+  ZuStringN<256> s;
+  s << lock;
+
   if (m_try)
     printf("%+14.3f %3d %s %10s %3d %s Try\n",
-	   stamp.dtime(), tid, prePost, insns[m_insn], m_lock,
-	   lock.dump().data());
+	   stamp.dtime(), tid, prePost, insns[m_insn], m_lock, s.data());
   else
     printf("%+14.3f %3d %s %10s %3d %s\n",
-	   stamp.dtime(), tid, prePost, insns[m_insn], m_lock,
-	   lock.dump().data());
+	   stamp.dtime(), tid, prePost, insns[m_insn], m_lock, s.data());
 
   fflush(stdout);
 }
@@ -216,8 +220,63 @@ int result(int tid)
 #define TryReadLock(l) new Work(Work::ReadLock, l, true)
 #define ReadUnlock(l) new Work(Work::ReadUnlock, l, false)
 
+// scaling benchmark - each thread performs count read lock / unlock pairs,
+// with one write lock / unlock in every writeRatio (0 - no writes)
+
+template <typename Lock>
+void bench(const char *name,
+    unsigned maxThreads, unsigned count, unsigned writeRatio)
+{
+  for (unsigned n = 1; n <= maxThreads; n <<= 1) {
+    Lock lock;
+    ZmAtomic<unsigned> ready = 0;
+    ZmAtomic<unsigned> go = 0;
+    uint64_t data = 0;
+    ZmAtomic<uint64_t> sum = 0;
+    ZmThread *threads = new ZmThread[n];
+    for (unsigned i = 0; i < n; i++)
+      threads[i] = ZmThread(0, ZmFn<>([&]() {
+	uint64_t sum_ = 0;
+	++ready;
+	while (!go) ZmPlatform::yield();
+	for (unsigned j = 1; j <= count; j++) {
+	  if (writeRatio && !(j % writeRatio)) {
+	    ZmGuard<Lock> guard(lock);
+	    ++data;
+	  } else {
+	    ZmReadGuard<Lock> guard(lock);
+	    sum_ += data;
+	  }
+	}
+	sum += sum_;
+      }));
+    while (ready < n) ZmPlatform::yield();
+    ZmTime start = ZmTimeNow();
+    go = 1;
+    for (unsigned i = 0; i < n; i++) threads[i].join();
+    ZmTime end = ZmTimeNow();
+    delete [] threads;
+    end -= start;
+    double ops = (double)count * n;
+    printf("%-10s threads: %2u  %8.2f ns/op  %8.2f Mops/s\n",
+	name, n, end.dtime() * 1E9 / count, ops / end.dtime() / 1E6);
+  }
+}
+
 int main(int argc, char **argv)
 {
+  if (argc > 1 && !strcmp(argv[1], "-b")) {
+    unsigned maxThreads = argc > 2 ? atoi(argv[2]) : 16;
+    unsigned count = argc > 3 ? atoi(argv[3]) : 1000000;
+    unsigned writeRatio = argc > 4 ? atoi(argv[4]) : 0;
+    if (!maxThreads) maxThreads = 1;
+    if (!count) count = 1;
+    bench<ZmRWLock>("ZmRWLock", maxThreads, count, writeRatio);
+    bench<ZmPRWLock>("ZmPRWLock", maxThreads, count, writeRatio);
+    bench<ZmBRWLock>("ZmBRWLock", maxThreads, count, writeRatio);
+    return 0;
+  }
+
   int n = argc < 2 ? 1 : atoi(argv[1]);
   Global::start(8, 8);
 
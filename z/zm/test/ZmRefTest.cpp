@@ -0,0 +1,108 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/* ZmRef / ZmObject test program */
+
+#include <zlib/ZuLib.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zlib/ZuObject.hpp>
+
+#include <zlib/ZmObject.hpp>
+#include <zlib/ZmPolymorph.hpp>
+#include <zlib/ZmLObject.hpp>
+#include <zlib/ZmLPolymorph.hpp>
+#include <zlib/ZmRef.hpp>
+#include <zlib/ZmTime.hpp>
+#include <zlib/ZmPlatform.hpp>
+
+static unsigned deleted = 0;
+
+struct A : public ZmObject { ~A() { ++deleted; } };
+struct B : public ZmPolymorph { ~B() { ++deleted; } };
+struct C : public ZmLObject { ~C() { ++deleted; } };
+struct D : public ZmLPolymorph { ~D() { ++deleted; } };
+struct D2 : public D { ~D2() { ++deleted; } };
+struct E : public ZuObject { ~E() { ++deleted; } };
+
+void fail(const char *s)
+{
+  printf("FAILED: %s\n", s);
+  ZmPlatform::exit(1);
+}
+
+template <typename T> void test(const char *name)
+{
+  deleted = 0;
+  {
+    ZmRef<T> o = new T();
+    {
+      ZmRef<T> p = o;
+      if (o->refCount() != 2) fail(name);
+      ZmRef<T> q = ZuMv(p);
+      if (o->refCount() != 2 || p) fail(name);
+    }
+    if (o->refCount() != 1) fail(name);
+  }
+  if (deleted != 1) fail(name);
+}
+
+// each iteration overwrites a slot - one ref() and one deref()
+template <typename T> void bench(const char *name, unsigned count)
+{
+  enum { Slots = 64 };
+  ZmRef<T> o = new T();
+  ZmRef<T> *slots = new ZmRef<T>[Slots];
+  ZmTime start(ZmTime::Now);
+  for (unsigned i = 0; i < count; i++) {
+    slots[i & (Slots - 1)] = nullptr;
+    slots[i & (Slots - 1)] = o;
+  }
+  ZmTime end(ZmTime::Now);
+  delete [] slots;
+  end -= start;
+  printf("%-14s %.2fns/ref+deref\n", name,
+      end.dtime() * 1E9 / (double)count);
+}
+
+int main(int argc, char **argv)
+{
+  test<A>("ZmObject");
+  test<B>("ZmPolymorph");
+  test<C>("ZmLObject");
+  test<D>("ZmLPolymorph");
+  test<E>("ZuObject");
+
+  // virtual destructor via base class reference
+  deleted = 0;
+  { ZmRef<D> d = new D2(); ZmRef<D2> d2 = d.ptr<D2>(); }
+  if (deleted != 2) fail("ZmLPolymorph dtor");
+
+  puts("test done");
+
+  unsigned count = argc > 1 ? atoi(argv[1]) : 100000000;
+
+  bench<A>("ZmObject", count);
+  bench<B>("ZmPolymorph", count);
+  bench<C>("ZmLObject", count);
+  bench<D>("ZmLPolymorph", count);
+  bench<E>("ZuObject", count);
+}
@@ -0,0 +1,177 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+// ZmRing single-item vs batched push/shift throughput benchmark
+
+#include <zlib/ZuStringN.hpp>
+
+#include <zlib/ZmRing.hpp>
+#include <zlib/ZmThread.hpp>
+#include <zlib/ZmTime.hpp>
+
+void usage()
+{
+  std::cerr <<
+"usage: ZmRingTest2 [OPTION]...\n"
+"  compare single-item and batched ZmRing push/shift throughput\n\n"
+"Options:\n"
+"  -b BUFSIZE\t- set buffer size to BUFSIZE (default: 65536)\n"
+"  -n COUNT\t- set number of messages per writer to COUNT "
+  "(default: 10000000)\n"
+"  -w N\t\t- number of writer threads (default: 1)\n"
+"  -B N\t\t- batch size (default: 64)\n"
+"  -L\t\t- low-latency (readers spin indefinitely and do not yield)\n"
+"  -s SPIN\t- set spin count to SPIN (default: 1000)\n";
+  ZmPlatform::exit(1);
+}
+
+struct Msg {
+  ZuInline Msg(uint64_t v) : m_v(v) { }
+  uint64_t m_v;
+};
+
+typedef ZmRing<Msg> Ring;
+
+struct App {
+  int main(int, char **);
+  void run(bool batch);
+  void reader(bool batch);
+  void writer(bool batch);
+
+  Ring		*ring = 0;
+  unsigned	count = 10000000;
+  unsigned	writers = 1;
+  unsigned	batch = 64;
+  uint64_t	sum = 0;
+};
+
+int main(int argc, char **argv)
+{
+  App a;
+  return a.main(argc, argv);
+}
+
+int App::main(int argc, char **argv)
+{
+  unsigned bufsize = 65536;
+  bool ll = false;
+  unsigned spin = 1000;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') usage();
+    switch (argv[i][1]) {
+      case 'b':
+	if (++i >= argc) usage();
+	bufsize = atoi(argv[i]);
+	break;
+      case 'n':
+	if (++i >= argc) usage();
+	count = atoi(argv[i]);
+	break;
+      case 'w':
+	if (++i >= argc) usage();
+	writers = atoi(argv[i]);
+	break;
+      case 'B':
+	if (++i >= argc) usage();
+	if (!(batch = atoi(argv[i]))) usage();
+	break;
+      case 'L':
+	ll = true;
+	break;
+      case 's':
+	if (++i >= argc) usage();
+	spin = atoi(argv[i]);
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+
+  ring = new Ring(ZmRingParams(bufsize).ll(ll).spin(spin));
+
+  run(false);
+  run(true);
+
+  delete ring;
+  return 0;
+}
+
+void App::run(bool batch)
+{
+  if (ring->open(Ring::Read | Ring::Write) != Ring::OK) {
+    std::cerr << "open failed\n";
+    ZmPlatform::exit(1);
+  }
+  sum = 0;
+  ZmTime start, end;
+  {
+    ZmThread r, w[writers];
+
+    start.now();
+    r = ZmThread(0, ZmFn<>([this, batch]() { reader(batch); }));
+    for (unsigned i = 0; i < writers; i++)
+      w[i] = ZmThread(0, ZmFn<>([this, batch]() { writer(batch); }));
+    for (unsigned i = 0; i < writers; i++)
+      if (!!w[i]) w[i].join();
+    ring->eof();
+    if (!!r) r.join();
+    end.now();
+  }
+  end -= start;
+  uint64_t n = (uint64_t)count * writers;
+  bool ok = sum == (uint64_t)writers * count * ((uint64_t)count + 1) / 2;
+  {
+    ZuStringN<160> s;
+    s << (batch ? "batched: " : "single:  ") <<
+      ZuBoxed(end.dtime()).fmt(ZuFmt::FP<9>()) << "s  " <<
+      ZuBoxed((double)n / end.dtime()).fmt(ZuFmt::FP<0>()) << " msgs/s" <<
+      (ok ? "" : "  CHECKSUM FAILED") << '\n';
+    std::cerr << s;
+  }
+  ring->close();
+}
+
+void App::reader(bool batch)
+{
+  uint64_t sum = 0;
+  if (!batch) {
+    while (const Msg *msg = ring->shift()) {
+      sum += msg->m_v;
+      ring->shift2();
+    }
+  } else {
+    unsigned n;
+    while (const Msg *msg = ring->shiftN(this->batch, n)) {
+      for (unsigned i = 0; i < n; i++)
+	sum += ((const Msg *)((const uint8_t *)msg + i * Ring::Size))->m_v;
+      ring->shift2N(n);
+    }
+  }
+  this->sum = sum;
+}
+
+void App::writer(bool batch)
+{
+  uint64_t v = 0;
+  if (!batch) {
+    for (unsigned j = 0; j < count; j++) {
+      void *ptr = ring->push();
+      if (ZuUnlikely(!ptr)) { --j; continue; }
+      new (ptr) Msg(++v);
+      ring->push2(ptr);
+    }
+  } else {
+    for (unsigned j = 0; j < count; ) {
+      unsigned n = count - j;
+      if (n > this->batch) n = this->batch;
+      void *ptr = ring->pushN(n);
+      if (ZuUnlikely(!ptr)) continue;
+      for (unsigned i = 0; i < n; i++)
+	new ((uint8_t *)ptr + i * Ring::Size) Msg(++v);
+      ring->push2N(ptr, n);
+      j += n;
+    }
+  }
+}
@@ -29,6 +29,7 @@
 #include <zlib/ZmSpecific.hpp>
 #include <zlib/ZmBackoff.hpp>
 #include <zlib/ZmTimeout.hpp>
+#include <zlib/ZmSemaphore.hpp>
 
 struct TLS : public ZmObject {
   TLS() : m_ping(0) { }
@@ -93,6 +94,7 @@ void usage()
     "  -n N\tset number of threads to N\n"
     "  -c ID=CPUSET\tset thread ID affinity to CPUSET (e.g. 1=2,4)\n"
     "  -i BITMAP\tset isolation (e.g. 1,3-4)\n"
+    "  -w\tuse hierarchical timing wheel\n"
     , stderr);
   ZmPlatform::exit(1);
 }
@@ -102,6 +104,51 @@ void fail(const char *s)
   printf("FAIL: %s\n", s);
 }
 
+// stealing - untargeted jobs dispatched to a busy worker migrate to an
+// idle one, while jobs run on a specific thread remain there
+void stealTest()
+{
+  enum { N = 100 };
+
+  ZmScheduler s(ZmSchedParams().id("steal").nThreads(2).stealing(true));
+  ZmSemaphore blocked, release, done, pinnedDone;
+  ZmAtomic<unsigned> ran[3];	// untargeted jobs run, per thread
+  unsigned pinned = 0;		// thread that ran the pinned job
+
+  s.start();
+
+  // block thread 1
+  s.run(1, [&blocked, &release]() { blocked.post(); release.wait(); });
+  blocked.wait();
+
+  for (unsigned i = 0; i < N; i++)
+    s.add([&ran, &done]() {
+      ++ran[ZmThreadContext::self()->index()];
+      done.post();
+    });
+  s.run(1, [&pinned, &pinnedDone]() {
+    pinned = ZmThreadContext::self()->index();
+    pinnedDone.post();
+  });
+
+  for (unsigned i = 0; i < N; i++)
+    if (done.timedwait(ZmTimeNow(5)) < 0) {
+      fail("steal: untargeted jobs not stolen from busy thread");
+      break;
+    }
+  if (ran[1] || ran[2] != N) fail("steal: untargeted job ran on busy thread");
+  if (pinnedDone.timedwait(ZmTimeNow(.1)) >= 0)
+    fail("steal: pinned job ran while its thread was busy");
+
+  release.post();
+  if (pinnedDone.timedwait(ZmTimeNow(5)) < 0 || pinned != 1)
+    fail("steal: pinned job did not run on its thread");
+
+  s.stop();
+
+  printf("steal: %u/%u jobs ran on idle thread\n", ran[2].load_(), (unsigned)N);
+}
+
 #define test(t, x) \
   (((ZuStringN<32>() << t(x)) == x) ? (void)0 : fail(#t " \"" x "\""))
 #define test2(t, x, y) \
@@ -121,6 +168,8 @@ int main(int argc, char **argv)
     test(ZmBitmap, "3-5,7,9-");
   }
 
+  stealTest();
+
   signal(SIGSEGV, segv);
 
   ZmSchedParams params = ZmSchedParams().id("sched");
@@ -148,6 +197,9 @@ int main(int argc, char **argv)
 	if (++i >= argc) usage();
 	isolation = argv[i];
 	break;
+      case 'w':
+	params.timerWheel(true);
+	break;
     }
   }
 
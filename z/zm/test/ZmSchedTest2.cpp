@@ -0,0 +1,161 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+// scheduler timer churn benchmark - RB tree vs. timing wheel
+
+#include <zlib/ZuLib.hpp>
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <zlib/ZuStringN.hpp>
+
+#include <zlib/ZmScheduler.hpp>
+#include <zlib/ZmThread.hpp>
+#include <zlib/ZmTime.hpp>
+
+void usage()
+{
+  fputs(
+    "usage: ZmSchedTest2 [OPTION]...\n\n"
+    "Options:\n"
+    "  -n N\tset number of timers per thread to N (default: 10000)\n"
+    "  -c N\tset number of operations per thread to N (default: 1000000)\n"
+    "  -t N\tset number of churning threads to N (default: 1)\n"
+    "  -f N\tset number of short timers to verify expiry (default: 1000)\n"
+    , stderr);
+  ZmPlatform::exit(1);
+}
+
+struct App {
+  int main(int, char **);
+  void bench(bool wheel);
+  void churn(ZmScheduler *s, unsigned seed);
+  bool expiry(ZmScheduler *s);
+
+  unsigned		nTimers = 10000;
+  unsigned		nOps = 1000000;
+  unsigned		nThreads = 1;
+  unsigned		nShort = 1000;
+};
+
+int main(int argc, char **argv)
+{
+  App a;
+  return a.main(argc, argv);
+}
+
+int App::main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') usage();
+    switch (argv[i][1]) {
+      case 'n':
+	if (++i >= argc) usage();
+	nTimers = atoi(argv[i]);
+	break;
+      case 'c':
+	if (++i >= argc) usage();
+	nOps = atoi(argv[i]);
+	break;
+      case 't':
+	if (++i >= argc) usage();
+	nThreads = atoi(argv[i]);
+	break;
+      case 'f':
+	if (++i >= argc) usage();
+	nShort = atoi(argv[i]);
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+  if (!nTimers || !nThreads) usage();
+
+  bench(false);
+  bench(true);
+  return 0;
+}
+
+void App::bench(bool wheel)
+{
+  ZmScheduler s(ZmSchedParams().id("sched").nThreads(1).timerWheel(wheel));
+  s.start();
+
+  ZmTime start(ZmTime::Now);
+  {
+    ZmThread threads[nThreads];
+    for (unsigned i = 0; i < nThreads; i++)
+      threads[i] = ZmThread(0, ZmFn<>([this, &s, i]() { churn(&s, i + 1); }));
+    for (unsigned i = 0; i < nThreads; i++) threads[i].join();
+  }
+  ZmTime end(ZmTime::Now);
+  end -= start;
+
+  bool ok = expiry(&s);
+
+  s.stop();
+
+  ZuStringN<160> out;
+  out << (wheel ? "wheel:   " : "RB tree: ") <<
+    ZuBoxed((end.dtime() * 1000000000.0) /
+	((double)nOps * nThreads)).fmt(ZuFmt::FP<2>()) <<
+    " nsec/op  expiry " << (ok ? "OK" : "FAILED") << '\n';
+  fputs(out.data(), stderr);
+}
+
+// random add / reschedule (Update, Advance, Defer) / cancel churn
+// over a population of long-dated timers, as with per-link heartbeats
+void App::churn(ZmScheduler *s, unsigned seed)
+{
+  ZmScheduler::Timer *timers = new ZmScheduler::Timer[nTimers];
+  uint64_t r = seed * 0x9e3779b97f4a7c15ULL;
+  ZmTime now(ZmTime::Now);
+  for (unsigned j = 0; j < nOps; j++) {
+    r ^= r<<13; r ^= r>>7; r ^= r<<17;
+    unsigned i = r % nTimers;
+    unsigned op = (r>>32) & 7;
+    if (!op)
+      s->del(&timers[i]);
+    else
+      s->add([]() { }, now + ZmTime(60 + (int)((r>>40) & 1023)),
+	  op & 3, &timers[i]);
+  }
+  for (unsigned i = 0; i < nTimers; i++) s->del(&timers[i]);
+  delete [] timers;
+}
+
+// schedule short timers, cancel half, check that exactly the rest fire
+bool App::expiry(ZmScheduler *s)
+{
+  ZmAtomic<unsigned> fired = 0;
+  ZmScheduler::Timer *timers = new ZmScheduler::Timer[nShort];
+  ZmTime now(ZmTime::Now);
+  for (unsigned i = 0; i < nShort; i++)
+    s->add([&fired]() { ++fired; },
+	now + ZmTime((double)(i % 50 + 10) / 100.0), &timers[i]);
+  for (unsigned i = 0; i < nShort; i += 2) s->del(&timers[i]);
+  ZmPlatform::sleep(1);
+  unsigned n = nShort - ((nShort + 1)>>1);
+  bool ok = fired == n;
+  for (unsigned i = 0; i < nShort; i++) if (timers[i]) ok = false;
+  delete [] timers;
+  return ok;
+}
@@ -1,13 +1,82 @@
 #include <zlib/ZuBox.hpp>
 
 #include <zlib/ZmPlatform.hpp>
+#include <zlib/ZmSpecific.hpp>
+#include <zlib/ZmThread.hpp>
+#include <zlib/ZmTime.hpp>
 
 ZmPlatform::ThreadID getTID() {
   return ZmPlatform::getTID();
 }
 
-int main()
+struct O : public ZmObject {
+  unsigned	n = 0;
+};
+
+struct TL { // thread_local with a non-trivial destructor
+  ~TL() { if (o) ZmDEREF(o); }
+  O	*o = nullptr;
+};
+
+static O *tlInstance() {
+  thread_local TL tl;
+  if (ZuUnlikely(!tl.o)) ZmREF(tl.o = new O());
+  return tl.o;
+}
+
+void fail(const char *s)
+{
+  std::cout << "FAILED: " << s << '\n' << std::flush;
+  ZmPlatform::exit(1);
+}
+
+int main(int argc, char **argv)
 {
   std::cout << ZuBoxed(getTID()) << '\n';
+
+  unsigned count = argc > 1 ? atoi(argv[1]) : 100000000;
+
+  // replacing the instance updates the cached pointer
+  {
+    O *o1 = ZmSpecific<O>::instance();
+    if (ZmSpecific<O>::instance() != o1) fail("instance");
+    O *o2 = new O();
+    ZmSpecific<O>::instance(o2);
+    if (ZmSpecific<O>::instance() != o2) fail("replace");
+  }
+
+  // instances are per-thread, and can be iterated over
+  {
+    O *o = ZmSpecific<O>::instance();
+    ZmThread t(0, [o]() {
+      if (ZmSpecific<O>::instance() == o) fail("per-thread");
+      ZmSpecific<O>::instance()->n = 42;
+    });
+    t.join();
+    unsigned n = 0;
+    ZmSpecific<O>::all([&n](O *o) { n++; });
+    if (n != 1) fail("all");
+  }
+
+  // cost of instance()
+  {
+    uintptr_t v = 0;
+    ZmTime start(ZmTime::Now);
+    for (unsigned i = 0; i < count; i++)
+      v += (uintptr_t)ZmSpecific<O>::instance()->n++;
+    ZmTime end(ZmTime::Now);
+    std::cout << "ZmSpecific::instance():\t"
+      << ZuBoxed((end - start).dtime() * 1E9 / (double)count).fmt(
+	  ZuFmt::FP<2>()) << "ns\n";
+    start.now();
+    for (unsigned i = 0; i < count; i++)
+      v += (uintptr_t)tlInstance()->n++;
+    end.now();
+    std::cout << "thread_local:\t\t"
+      << ZuBoxed((end - start).dtime() * 1E9 / (double)count).fmt(
+	  ZuFmt::FP<2>()) << "ns\n";
+    if (!v) std::cout << '\n';
+  }
+
   return 0;
 }
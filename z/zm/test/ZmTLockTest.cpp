@@ -7,6 +7,7 @@
 
 #include <zlib/ZmObject.hpp>
 #include <zlib/ZmRef.hpp>
+#include <zlib/ZmAtomic.hpp>
 #include <zlib/ZmTLock.hpp>
 #include <zlib/ZmSingleton.hpp>
 #include <zlib/ZmList.hpp>
@@ -232,8 +233,113 @@ struct ZmTLock_Test {
   }
 };
 
+// lock+unlock throughput benchmark
+
+#ifndef _WIN32
+struct B {
+  ZmTLock<int, int>	locks;
+  ZmAtomic<unsigned>	ready;
+  ZmAtomic<unsigned>	go;
+  unsigned		count = 0;	// per thread
+  bool			write = false;
+  bool			overlap = false;
+};
+
+struct BThread {
+  B		*b;
+  int		tid;
+};
+
+enum { BenchIDs = 64 };		// IDs per thread (disjoint) or in total
+
+void *bench_(void *t_)
+{
+  BThread *t = (BThread *)t_;
+  B *b = t->b;
+  int base = b->overlap ? 0 : t->tid * BenchIDs;
+  ++b->ready;
+  while (!b->go) ZmPlatform::yield();
+  for (unsigned i = 0, n = b->count; i < n; i++) {
+    int id = base + (i & (BenchIDs - 1));
+    int r = b->write ?
+      b->locks.writeLock(id, t->tid) : b->locks.readLock(id, t->tid);
+    if (r) {
+      printf(" FAILED (lock %d tid %d)\n", id, t->tid);
+      ZmPlatform::exit(1);
+    }
+    b->locks.unlock(id, t->tid);
+  }
+  return 0;
+}
+
+void bench(bool write, bool overlap, unsigned count)
+{
+  static const unsigned nthreads[] = { 1, 2, 4, 8 };
+  printf("%s %s:",
+      overlap ? "overlapping" : "disjoint", write ? "write" : "read");
+  for (unsigned j = 0; j < sizeof(nthreads) / sizeof(nthreads[0]); j++) {
+    unsigned n = nthreads[j];
+    B b;
+    b.count = count / n;
+    b.write = write;
+    b.overlap = overlap;
+    pthread_t *tids = (pthread_t *)alloca(n * sizeof(pthread_t));
+    BThread *threads = (BThread *)alloca(n * sizeof(BThread));
+    for (unsigned i = 0; i < n; i++) {
+      threads[i].b = &b;
+      threads[i].tid = i;
+      pthread_create(&tids[i], 0, &bench_, (void *)&threads[i]);
+    }
+    while (b.ready < n) ZmPlatform::yield();
+    ZmTime start(ZmTime::Now);
+    b.go = 1;
+    for (unsigned i = 0; i < n; i++) pthread_join(tids[i], 0);
+    ZmTime end(ZmTime::Now);
+    for (unsigned i = 0; i < n; i++)
+      for (unsigned k = 0; k < BenchIDs; k++) {
+	int id = (overlap ? 0 : i * BenchIDs) + k;
+	if (b.locks.isReadLocked(id, (int)i)) {
+	  printf(" FAILED (lock %d still held by %u)\n", id, i);
+	  ZmPlatform::exit(1);
+	}
+      }
+    end -= start;
+    printf("\t%u:%.1fM/s", n,
+	(double)(b.count * n) / (end.dtime() * 1E6));
+    fflush(stdout);
+  }
+  putchar('\n');
+}
+#endif
+
+void usage()
+{
+  fputs("usage: ZmTLockTest [iterations]\n"
+#ifndef _WIN32
+	"       ZmTLockTest -b [count]\n"
+	"\n"
+	"  -b\treport lock+unlock throughput with 1-8 threads, for disjoint\n"
+	"\tand overlapping sets of IDs\n"
+#endif
+	, stderr);
+  ZmPlatform::exit(1);
+}
+
 int main(int argc, char **argv)
 {
+#ifndef _WIN32
+  if (argc > 1 && argv[1][0] == '-' && argv[1][1] == 'b') {
+    if (argc > 3) usage();
+    unsigned count = argc > 2 ? atoi(argv[2]) : 10000000;
+    if (!count) usage();
+    bench(false, false, count);
+    bench(true, false, count);
+    bench(false, true, count);
+    bench(true, true, count);
+    ZmPlatform::exit(0);
+  }
+#endif
+  if (argc > 2) usage();
   int n = argc < 2 ? 1 : atoi(argv[1]);
   Global::start(8, 8);
 
@@ -0,0 +1,85 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/* ZmTime::fast() test program */
+
+#include <zlib/ZuLib.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zlib/ZmTime.hpp>
+#include <zlib/ZmPlatform.hpp>
+
+void usage()
+{
+  fputs("usage: ZmTimeTest [count [seconds]]\n"
+	"\n"
+	"  count\tcalls to time for each clock (default 10000000)\n"
+	"  seconds\tduration of drift measurement (default 10)\n", stderr);
+  ZmPlatform::exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc > 3) usage();
+  unsigned count = argc > 1 ? atoi(argv[1]) : 10000000;
+  unsigned seconds = argc > 2 ? atoi(argv[2]) : 10;
+  if (!count) usage();
+
+  // wait for initial calibration
+  {
+    ZmTime end = ZmTimeNow(0.1);
+    while (ZmTimeNow() < end) ZmTimeFast();
+  }
+  printf("fast() is %s\n",
+      ZmTime::fastTSC() ? "TSC-based" : "falling back to now()");
+
+  // cost per call, checking that fast() does not go backwards
+  {
+    ZmTime start, end, t;
+    start.now();
+    for (unsigned i = 0; i < count; i++) t.now();
+    end.now();
+    printf("now():\t%.1fns\n",
+	(end - start).dtime() * 1E9 / (double)count);
+
+    unsigned backwards = 0;
+    ZmTime prev = ZmTimeFast();
+    start.now();
+    for (unsigned i = 0; i < count; i++) {
+      t.fast();
+      if (t < prev) ++backwards;
+      prev = t;
+    }
+    end.now();
+    printf("fast():\t%.1fns (%u backwards)\n",
+	(end - start).dtime() * 1E9 / (double)count, backwards);
+  }
+
+  // drift of fast() relative to now(), sampled every 100ms
+  for (unsigned i = 0, n = seconds * 10; i < n; i++) {
+    ZmPlatform::sleep(ZmTime(0.1));
+    ZmTime fast = ZmTimeFast();
+    ZmTime now = ZmTimeNow();
+    if (!((i + 1) % 10))
+      printf("%us drift:\t%lldns\n", (i + 1) / 10,
+	  (long long)(now - fast).nanosecs());
+  }
+}
@@ -0,0 +1,173 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2
+
+// ZmVRing variable-length message MPSC test / throughput benchmark
+
+#include <zlib/ZuStringN.hpp>
+
+#include <zlib/ZmVRing.hpp>
+#include <zlib/ZmThread.hpp>
+#include <zlib/ZmTime.hpp>
+
+void usage()
+{
+  std::cerr <<
+"usage: ZmVRingTest [OPTION]...\n"
+"  variable-length ZmVRing push/shift test and throughput benchmark\n\n"
+"Options:\n"
+"  -b BUFSIZE\t- set buffer size to BUFSIZE (default: 65536)\n"
+"  -n COUNT\t- set number of messages per writer to COUNT "
+  "(default: 1000000)\n"
+"  -w N\t\t- number of writer threads (default: 1)\n"
+"  -m MAXLEN\t- maximum message length (default: 256)\n"
+"  -L\t\t- low-latency (readers spin indefinitely and do not yield)\n"
+"  -s SPIN\t- set spin count to SPIN (default: 1000)\n";
+  ZmPlatform::exit(1);
+}
+
+// message - payload bytes are (seqNo + i) & 0xff
+struct Msg {
+  uint32_t	writer;
+  uint32_t	seqNo;
+  uint32_t	length;
+  uint8_t	data[1];
+};
+
+typedef ZmVRing<Msg> Ring;
+
+struct App {
+  int main(int, char **);
+  void reader();
+  void writer(unsigned id);
+
+  Ring		*ring = 0;
+  unsigned	count = 1000000;
+  unsigned	writers = 1;
+  unsigned	maxLen = 256;
+  uint64_t	bytes = 0;
+  bool		ok = true;
+};
+
+int main(int argc, char **argv)
+{
+  App a;
+  return a.main(argc, argv);
+}
+
+int App::main(int argc, char **argv)
+{
+  unsigned bufsize = 65536;
+  bool ll = false;
+  unsigned spin = 1000;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') usage();
+    switch (argv[i][1]) {
+      case 'b':
+	if (++i >= argc) usage();
+	bufsize = atoi(argv[i]);
+	break;
+      case 'n':
+	if (++i >= argc) usage();
+	count = atoi(argv[i]);
+	break;
+      case 'w':
+	if (++i >= argc) usage();
+	if (!(writers = atoi(argv[i]))) usage();
+	break;
+      case 'm':
+	if (++i >= argc) usage();
+	maxLen = atoi(argv[i]);
+	break;
+      case 'L':
+	ll = true;
+	break;
+      case 's':
+	if (++i >= argc) usage();
+	spin = atoi(argv[i]);
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+  if (maxLen < sizeof(Msg)) maxLen = sizeof(Msg);
+
+  ring = new Ring(ZmRingParams(bufsize).ll(ll).spin(spin));
+  if (ring->open(Ring::Read | Ring::Write) != Ring::OK) {
+    std::cerr << "open failed\n";
+    ZmPlatform::exit(1);
+  }
+
+  ZmTime start, end;
+  {
+    ZmThread r, w[writers];
+
+    start.now();
+    r = ZmThread(0, ZmFn<>([this]() { reader(); }));
+    for (unsigned i = 0; i < writers; i++)
+      w[i] = ZmThread(0, ZmFn<>([this, i]() { writer(i); }));
+    for (unsigned i = 0; i < writers; i++)
+      if (!!w[i]) w[i].join();
+    ring->eof();
+    if (!!r) r.join();
+    end.now();
+  }
+  end -= start;
+
+  uint64_t n = (uint64_t)count * writers;
+  {
+    ZuStringN<160> s;
+    s << ZuBoxed(end.dtime()).fmt(ZuFmt::FP<9>()) << "s  " <<
+      ZuBoxed((double)n / end.dtime()).fmt(ZuFmt::FP<0>()) << " msgs/s  " <<
+      ZuBoxed((double)bytes / end.dtime()).fmt(ZuFmt::FP<0>()) <<
+      " bytes/s" << (ok ? "" : "  CHECK FAILED") << '\n';
+    std::cerr << s;
+  }
+
+  ring->close();
+  delete ring;
+  return ok ? 0 : 1;
+}
+
+void App::reader()
+{
+  uint32_t *seqNos = new uint32_t[writers];
+  memset(seqNos, 0, writers * sizeof(uint32_t));
+  uint64_t bytes = 0;
+  while (const Msg *msg = ring->shift()) {
+    unsigned length = Ring::length(msg);
+    if (msg->writer >= writers ||
+	msg->seqNo != seqNos[msg->writer]++ ||
+	msg->length != length)
+      ok = false;
+    else {
+      unsigned n = length - offsetof(Msg, data);
+      for (unsigned i = 0; i < n; i++)
+	if (msg->data[i] != (uint8_t)(msg->seqNo + i)) { ok = false; break; }
+    }
+    bytes += length;
+    ring->shift2();
+  }
+  for (unsigned i = 0; i < writers; i++)
+    if (seqNos[i] != count) ok = false;
+  delete [] seqNos;
+  this->bytes = bytes;
+}
+
+void App::writer(unsigned id)
+{
+  unsigned range = maxLen - offsetof(Msg, data) + 1;
+  for (unsigned j = 0; j < count; ) {
+    unsigned length = offsetof(Msg, data) + (j * 7919) % range;
+    Msg *msg = (Msg *)ring->push(length);
+    if (ZuUnlikely(!msg)) continue;
+    msg->writer = id;
+    msg->seqNo = j;
+    msg->length = length;
+    unsigned n = length - offsetof(Msg, data);
+    for (unsigned i = 0; i < n; i++) msg->data[i] = (uint8_t)(j + i);
+    ring->push2(msg);
+    j++;
+  }
+}
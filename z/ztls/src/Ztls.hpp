@@ -394,6 +394,7 @@ private:
 	      [](IOBuf *buf, ZiIOContext &io) {
 		io.offset += io.length;
 	      }}, buf->data_, buf->length, 0);
+	    io.last = true;
 	  }});
       });
       offset += n;
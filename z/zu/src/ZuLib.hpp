@@ -142,6 +142,15 @@
 #define ZuMayAlias(x) x
 #endif
 
+// software prefetch - R for reading, W for writing (exclusive ownership)
+#ifdef __GNUC__
+#define ZuPrefetchR(x) __builtin_prefetch((x), 0, 3)
+#define ZuPrefetchW(x) __builtin_prefetch((x), 1, 3)
+#else
+#define ZuPrefetchR(x) ((void)(x))
+#define ZuPrefetchW(x) ((void)(x))
+#endif
+
 #if defined (__cplusplus)
 // std::remove_reference without dragging in STL cruft
 template <typename T_>
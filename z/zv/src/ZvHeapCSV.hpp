@@ -45,6 +45,8 @@ struct ZvAPI ZvHeapCSV {
     ZuBox<uint64_t>	cacheSize;
     ZmBitmap		cpuset;
     ZuBox<unsigned>	telFreq;
+    ZuBox<unsigned>	magazine;
+    ZuBox<unsigned>	arena;
   };
 
   typedef ZvCSVColumn<ZvCSVColType::String, ZmIDString> IDCol;
@@ -76,6 +78,8 @@ struct ZvAPI ZvHeapCSV {
       add(new UInt64Col("cacheSize", offsetof(Data, cacheSize)));
       add(new BitmapCol("cpuset", offsetof(Data, cpuset)));
       add(new UIntCol("telFreq", offsetof(Data, telFreq)));
+      add(new UIntCol("magazine", offsetof(Data, magazine)));
+      add(new UIntCol("arena", offsetof(Data, arena)));
     }
 
     void read(ZuString file) {
@@ -89,7 +93,8 @@ struct ZvAPI ZvHeapCSV {
     void row(ZuAnyPOD *pod) {
       const Data *data = (const Data *)(pod->ptr());
       ZmHeapMgr::init(data->id, data->partition, ZmHeapConfig{
-	  data->alignment, data->cacheSize, data->cpuset, data->telFreq});
+	  data->alignment, data->cacheSize, data->cpuset, data->telFreq,
+	  data->magazine, data->arena});
     }
 
   private:
@@ -68,9 +68,16 @@ struct ZvMxParams : public ZiMxParams {
     scheduler().init(cf);
     if (ZuString s = cf->get("rxThread")) rxThread(scheduler().tid(s));
     if (ZuString s = cf->get("txThread")) txThread(scheduler().tid(s));
+    if (const ZtArray<ZtString> *rxThreads =
+	  cf->getMultiple("rxThreads", 0, 64))
+      for (unsigned i = 0, n = rxThreads->length(); i < n; i++)
+	addRxThread(scheduler().tid((*rxThreads)[i]));
+    rxPolicy(cf->getEnum<ZiMxRxPolicy::Map>("rxPolicy", false, rxPolicy()));
 #ifdef ZiMultiplex_EPoll
     epollMaxFDs(cf->getInt("epollMaxFDs", 1, 100000, false, epollMaxFDs()));
     epollQuantum(cf->getInt("epollQuantum", 1, 1024, false, epollQuantum()));
+    udpBatch(cf->getInt("udpBatch", 1, 1024, false, udpBatch()));
+    tcpBatch(cf->getInt("tcpBatch", 1, 1024, false, tcpBatch()));
 #endif
     rxBufSize(cf->getInt("rcvBufSize", 0, INT_MAX, false, rxBufSize()));
     txBufSize(cf->getInt("sndBufSize", 0, INT_MAX, false, txBufSize()));
@@ -79,6 +79,8 @@ struct ZvSchedParams : public ZmSchedParams {
     ll(cf->getInt("ll", 0, 1, false, ll()));
     spin(cf->getInt("spin", 0, INT_MAX, false, spin()));
     timeout(cf->getInt("timeout", 0, 3600, false, timeout()));
+    stealing(cf->getInt("stealing", 0, 1, false, stealing()));
+    timerWheel(cf->getInt("timerWheel", 0, 1, false, timerWheel()));
     if (ZmRef<ZvCf> threadsCf = cf->subset("threads", false)) {
       ZvCf::Iterator i(threadsCf);
       ZuString id;